@@ -26,12 +26,49 @@
 #include "ClientDriver_OSVR.h"
 #include "make_unique.h"
 #include "Logging.h"
+#include "StartupWait.h"
+#include "distortion/DistortionModel.h"
+#include "distortion/HiddenAreaMesh.h"
 
 // Library/third-party includes
 #include <openvr_driver.h>
+#include <osvr/ClientKit/Context.h> // for osvr::clientkit::ClientContext
 
 // Standard includes
-// - none
+#include <algorithm>                // for std::max
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <mutex>                    // for std::mutex, std::unique_lock
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * Asks the OSVR server for the display descriptor, waiting briefly for it to
+ * connect.
+ *
+ * @return false if the server didn't connect in time or had no descriptor.
+ */
+bool readDisplayDescriptor(std::string& descriptor)
+{
+    osvr::clientkit::ClientContext context("org.osvr.SteamVR.Client");
+    StartupWait startup(std::chrono::seconds(1));
+    if (!startup.wait("context", [&] { return context.checkStatus(); }, [&] { context.update(); })) {
+        OSVR_LOG(err) << "ClientDriver_OSVR: Timed out after " << startup.getElapsed() << " seconds waiting for the OSVR server to send the display descriptor.\n";
+        return false;
+    }
+
+    descriptor = context.getStringParameter("/display");
+    if (descriptor.empty()) {
+        OSVR_LOG(err) << "ClientDriver_OSVR: The OSVR server has no display descriptor.\n";
+        return false;
+    }
+    return true;
+}
+
+} // end anonymous namespace
 
 vr::EVRInitError ClientDriver_OSVR::Init(vr::IDriverLog* driver_log, vr::IClientDriverHost* driver_host, const char* user_driver_config_dir, const char* driver_install_dir)
 {
@@ -75,6 +112,37 @@ vr::HiddenAreaMesh_t ClientDriver_OSVR::GetHiddenAreaMesh(vr::EVREye eye)
     hidden_area_mesh.pVertexData = nullptr;
     hidden_area_mesh.unTriangleCount = 0;
 
+    std::unique_lock<std::mutex> lock(hiddenArea_.mutex);
+    if (!hiddenArea_.built) {
+        // Only one caller at a time waits on the server, and not while
+        // holding the lock; the rest get no mesh until it's done.
+        const auto now = std::chrono::steady_clock::now();
+        if (hiddenArea_.building || now < hiddenArea_.nextAttempt)
+            return hidden_area_mesh;
+        hiddenArea_.building = true;
+        lock.unlock();
+
+        std::vector<vr::HmdVector2_t> vertices[2];
+        const bool built = buildHiddenAreaMeshes(vertices);
+
+        // Between attempts to reach the server
+        const float retry_interval = settings_ ? std::max(settings_->getSetting<float>("hiddenAreaRetryInterval", 5.0f), 0.0f) : 5.0f;
+
+        lock.lock();
+        hiddenArea_.building = false;
+        if (!built) {
+            hiddenArea_.nextAttempt = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(retry_interval));
+            return hidden_area_mesh;
+        }
+        hiddenArea_.vertices[0].swap(vertices[0]);
+        hiddenArea_.vertices[1].swap(vertices[1]);
+        hiddenArea_.built = true;
+    }
+
+    const auto& vertices = hiddenArea_.vertices[(vr::Eye_Left == eye) ? 0 : 1];
+    hidden_area_mesh.pVertexData = vertices.empty() ? nullptr : vertices.data();
+    hidden_area_mesh.unTriangleCount = static_cast<uint32_t>(vertices.size() / 3);
+
     return hidden_area_mesh;
 }
 
@@ -83,3 +151,45 @@ uint32_t ClientDriver_OSVR::GetMCImage(uint32_t* img_width, uint32_t* img_height
     return 0;
 }
 
+bool ClientDriver_OSVR::buildHiddenAreaMeshes(std::vector<vr::HmdVector2_t> (&vertices)[2])
+{
+    // Points traced along each side of the screen to find the lens's
+    // outline; 0 turns the hidden area mesh off.
+    const int32_t tessellation = settings_ ? settings_->getSetting<int32_t>("hiddenAreaTessellation", 16) : 16;
+
+    // The most triangles to give each eye. Each one costs the compositor a
+    // little, so a few hundred is plenty.
+    const int32_t max_triangles = settings_ ? settings_->getSetting<int32_t>("hiddenAreaMaxTriangles", 256) : 256;
+
+    if (tessellation <= 0 || max_triangles <= 0) {
+        OSVR_LOG(info) << "ClientDriver_OSVR::buildHiddenAreaMeshes(): Hidden area mesh disabled.\n";
+        return true;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::string descriptor;
+    if (!readDisplayDescriptor(descriptor))
+        return false;
+
+    try {
+        const auto model = osvr::distortion::DistortionModel::fromDisplayDescriptor(descriptor);
+        for (int eye = 0; eye < 2; ++eye) {
+            for (const auto& vertex : osvr::distortion::computeHiddenAreaMesh(model, eye, static_cast<std::size_t>(tessellation), static_cast<std::size_t>(max_triangles))) {
+                vr::HmdVector2_t point;
+                point.v[0] = vertex.u;
+                point.v[1] = vertex.v;
+                vertices[eye].push_back(point);
+            }
+        }
+    } catch (const std::exception& e) {
+        // Asking again would get the same descriptor
+        OSVR_LOG(err) << "ClientDriver_OSVR::buildHiddenAreaMeshes(): Unable to build the hidden area mesh: " << e.what() << "\n";
+        vertices[0].clear();
+        vertices[1].clear();
+        return true;
+    }
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    OSVR_LOG(info) << "ClientDriver_OSVR::buildHiddenAreaMeshes(): Built hidden area meshes of " << vertices[0].size() / 3 << " and " << vertices[1].size() / 3 << " triangles in " << elapsed * 1e3 << " ms.\n";
+    return true;
+}
@@ -33,8 +33,11 @@
 #include <openvr_driver.h>
 
 // Standard includes
+#include <chrono>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 class ClientDriver_OSVR : public vr::IClientTrackedDeviceProvider {
 public:
@@ -100,6 +103,13 @@ public:
      * the user will never see before running the pixel shader.  NOTE: Render
      * this mesh with backface culling disabled since the winding order of the
      * vertices can be different per-HMD or per-eye.
+     *
+     * The meshes cover the parts of each eye's image that the distortion
+     * from the display descriptor never samples. They're built the first
+     * time the descriptor can be read and kept for the life of the driver;
+     * until then there's no mesh. The server is asked at most once every
+     * hiddenAreaRetryInterval seconds, and a descriptor that can't be
+     * understood isn't asked for again.
      */
     virtual vr::HiddenAreaMesh_t GetHiddenAreaMesh(vr::EVREye eye) OSVR_OVERRIDE;
 
@@ -111,10 +121,33 @@ public:
     virtual uint32_t GetMCImage(uint32_t* img_width, uint32_t* img_height, uint32_t* channels, void* data_buffer, uint32_t buffer_len) OSVR_OVERRIDE;
 
 private:
+    /**
+     * Fills in the hidden area mesh triangles for each eye, leaving them
+     * empty if there's no distortion or it can't be understood.
+     *
+     * @return false, with the meshes empty, if the display descriptor
+     * couldn't be read, so it's worth trying again.
+     */
+    bool buildHiddenAreaMeshes(std::vector<vr::HmdVector2_t> (&vertices)[2]);
+
+    /**
+     * Hidden area meshes for both eyes. SteamVR keeps the pointers we hand
+     * out, so once built they don't change; the driver lives as long as the
+     * process.
+     */
+    struct HiddenAreaMeshes {
+        std::mutex mutex;
+        bool built = false;
+        bool building = false;          ///< a caller is asking the server
+        std::chrono::steady_clock::time_point nextAttempt;
+        std::vector<vr::HmdVector2_t> vertices[2];
+    };
+
     vr::IClientDriverHost* driverHost_ = nullptr;
     std::string userDriverConfigDir_;
     std::string driverInstallDir_;
     std::unique_ptr<Settings> settings_;
+    HiddenAreaMeshes hiddenArea_;
 };
 
 #endif // INCLUDED_ClientDriver_OSVR_h_GUID_7C0E8547_F8CF_4186_B637_9488CD6E3663
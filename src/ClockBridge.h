@@ -0,0 +1,223 @@
+/** @file
+    @brief Maps OSVR timestamps into the host's clock domain.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ClockBridge_h_GUID_17C38D86_FACD_401D_BF47_F79B6D300027
+#define INCLUDED_ClockBridge_h_GUID_17C38D86_FACD_401D_BF47_F79B6D300027
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cmath>        // for std::abs
+#include <cstddef>      // for std::size_t
+
+/**
+ * @brief Tracks the offset and drift between the OSVR clock and the host's
+ * monotonic clock so that report timestamps can be expressed as host times.
+ *
+ * The OSVR clock is wall-clock based and may be slewed by time
+ * synchronization, while the host measures pose age against a monotonic
+ * clock. Callers feed in pairs of readings of both clocks taken back-to-back;
+ * the bridge keeps the tightest pair from each sampling interval and fits a
+ * line through the most recent ones to get the current offset and drift.
+ * A reading that disagrees wildly with the fit (say, after the wall clock
+ * was stepped) restarts the estimate.
+ */
+class ClockBridge {
+public:
+    /**
+     * Returns the current time of the host's monotonic clock in seconds.
+     */
+    static double hostNow()
+    {
+        using clock = std::chrono::steady_clock;
+        return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * Adds a pair of clock readings.
+     *
+     * @param osvr_time a reading of the OSVR clock, in seconds.
+     * @param host_time a reading of the host clock taken at the same moment,
+     * in seconds.
+     * @param uncertainty how far apart the two readings might be, in seconds;
+     * for example, the time between host readings taken just before and just
+     * after reading the OSVR clock.
+     */
+    void addSample(double osvr_time, double host_time, double uncertainty)
+    {
+        if (count_ > 0 && std::abs(toHostTime(osvr_time) - host_time) > MaxResidual) {
+            reset();
+        }
+
+        if (count_ == 0) {
+            // The first reading gives an offset straight away.
+            referenceOsvrTime_ = osvr_time;
+            referenceOffset_ = host_time - osvr_time;
+            candidate_ = { 0.0, 0.0, uncertainty };
+            commitCandidate();
+            return;
+        }
+
+        const Sample sample = { osvr_time - referenceOsvrTime_, (host_time - osvr_time) - referenceOffset_, uncertainty };
+
+        // A reading past the end of the current sampling interval closes it:
+        // the tightest reading held from it is used, and this one starts the
+        // next interval.
+        if (haveCandidate_ && sample.x - intervalStart_ >= SampleInterval) {
+            commitCandidate();
+        }
+
+        if (!haveCandidate_) {
+            candidate_ = sample;
+            haveCandidate_ = true;
+            intervalStart_ = sample.x;
+        } else if (uncertainty < candidate_.uncertainty) {
+            candidate_ = sample;
+        }
+    }
+
+    /**
+     * Converts an OSVR timestamp (in seconds) to host time (in seconds).
+     */
+    double toHostTime(double osvr_time) const
+    {
+        const double x = osvr_time - referenceOsvrTime_;
+        return osvr_time + referenceOffset_ + intercept_ + drift_ * x;
+    }
+
+    /**
+     * Returns true once at least one pair of readings has been added.
+     */
+    bool isValid() const
+    {
+        return count_ > 0;
+    }
+
+    /**
+     * Returns the current host-minus-OSVR clock offset in seconds.
+     */
+    double getOffset(double osvr_time) const
+    {
+        return toHostTime(osvr_time) - osvr_time;
+    }
+
+    /**
+     * Returns the estimated drift of the host clock relative to the OSVR
+     * clock, in seconds per second.
+     */
+    double getDrift() const
+    {
+        return drift_;
+    }
+
+    void reset()
+    {
+        count_ = 0;
+        next_ = 0;
+        haveCandidate_ = false;
+        intercept_ = 0.0;
+        drift_ = 0.0;
+    }
+
+private:
+    /// Minimum spacing (in OSVR seconds) between readings used for the fit.
+    static constexpr double SampleInterval = 0.25;
+
+    /// Readings further than this (in seconds) from the fit restart it.
+    static constexpr double MaxResidual = 0.05;
+
+    /// Number of readings used for the fit.
+    static const std::size_t Capacity = 64;
+
+    /// Fewer readings than this can't tell drift from noise.
+    static const std::size_t MinSamplesForDrift = 8;
+
+    struct Sample {
+        double x;           ///< OSVR time relative to referenceOsvrTime_
+        double y;           ///< offset relative to referenceOffset_
+        double uncertainty;
+    };
+
+    void commitCandidate()
+    {
+        samples_[next_] = candidate_;
+        next_ = (next_ + 1) % Capacity;
+        if (count_ < Capacity)
+            ++count_;
+        haveCandidate_ = false;
+        fit();
+    }
+
+    /**
+     * Least-squares line through the stored readings.
+     */
+    void fit()
+    {
+        double sum_x = 0.0, sum_y = 0.0;
+        for (std::size_t i = 0; i < count_; ++i) {
+            sum_x += samples_[i].x;
+            sum_y += samples_[i].y;
+        }
+        const double mean_x = sum_x / count_;
+        const double mean_y = sum_y / count_;
+
+        if (count_ < MinSamplesForDrift) {
+            drift_ = 0.0;
+            intercept_ = mean_y;
+            return;
+        }
+
+        double sxx = 0.0, sxy = 0.0;
+        for (std::size_t i = 0; i < count_; ++i) {
+            const double dx = samples_[i].x - mean_x;
+            sxx += dx * dx;
+            sxy += dx * (samples_[i].y - mean_y);
+        }
+        drift_ = (sxx > 0.0) ? sxy / sxx : 0.0;
+        intercept_ = mean_y - drift_ * mean_x;
+    }
+
+    Sample samples_[Capacity];
+    std::size_t count_ = 0;
+    std::size_t next_ = 0;
+
+    Sample candidate_ = {};
+    bool haveCandidate_ = false;
+    double intervalStart_ = 0.0;    ///< x of the first reading in the current interval
+
+    // Large absolute values are subtracted out before fitting to keep
+    // precision.
+    double referenceOsvrTime_ = 0.0;
+    double referenceOffset_ = 0.0;
+
+    double intercept_ = 0.0;
+    double drift_ = 0.0;
+};
+
+#endif // INCLUDED_ClockBridge_h_GUID_17C38D86_FACD_401D_BF47_F79B6D300027
@@ -0,0 +1,199 @@
+/** @file
+    @brief Parses debug requests and writes their responses in place.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DebugCommand_h_GUID_A02DEFC8_F920_4B04_9227_E769E0613C1E
+#define INCLUDED_DebugCommand_h_GUID_A02DEFC8_F920_4B04_9227_E769E0613C1E
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cctype>           // for std::isspace
+#include <cstdarg>          // for va_list
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <cstdio>           // for std::vsnprintf
+#include <cstdlib>          // for std::strtod
+#include <cstring>          // for std::strlen, std::strncmp
+
+/**
+ * @brief Splits a debug request into whitespace-separated words, pointing
+ * into the request rather than copying it.
+ */
+class DebugCommand {
+public:
+    /// Words past this many are ignored.
+    static const std::size_t MaxWords = 8;
+
+    explicit DebugCommand(const char* request)
+    {
+        const char* position = request ? request : "";
+        while (size_ < MaxWords) {
+            while (*position && std::isspace(static_cast<unsigned char>(*position))) {
+                ++position;
+            }
+            if (!*position)
+                break;
+
+            words_[size_] = position;
+            while (*position && !std::isspace(static_cast<unsigned char>(*position))) {
+                ++position;
+            }
+            lengths_[size_] = static_cast<int>(position - words_[size_]);
+            ++size_;
+        }
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * Returns true if word @p index is exactly @p word.
+     */
+    bool is(std::size_t index, const char* word) const
+    {
+        if (index >= size_)
+            return false;
+
+        const auto length = std::strlen(word);
+        return static_cast<std::size_t>(lengths_[index]) == length && 0 == std::strncmp(words_[index], word, length);
+    }
+
+    /**
+     * Reads word @p index as a number.
+     *
+     * @return false if there's no such word or it isn't entirely a number.
+     */
+    bool getNumber(std::size_t index, double& value) const
+    {
+        if (index >= size_)
+            return false;
+
+        char word[64];
+        if (static_cast<std::size_t>(lengths_[index]) >= sizeof(word))
+            return false;
+
+        std::memcpy(word, words_[index], lengths_[index]);
+        word[lengths_[index]] = '\0';
+        char* end = nullptr;
+        value = std::strtod(word, &end);
+        return end == word + lengths_[index];
+    }
+
+    /**
+     * Returns word @p index, which is not null-terminated; use getLength().
+     * Print it with "%.*s".
+     */
+    const char* getWord(std::size_t index) const
+    {
+        return (index < size_) ? words_[index] : "";
+    }
+
+    int getLength(std::size_t index) const
+    {
+        return (index < size_) ? lengths_[index] : 0;
+    }
+
+private:
+    const char* words_[MaxWords];
+    int lengths_[MaxWords];
+    std::size_t size_ = 0;
+};
+
+/**
+ * @brief Formats a debug response straight into the caller's buffer.
+ *
+ * The buffer is always null-terminated. Output that doesn't fit is cut off,
+ * and ends with a marker saying so when there's room for it.
+ */
+class DebugResponse {
+public:
+    DebugResponse(char* buffer, uint32_t size) : buffer_(buffer), size_(buffer ? size : 0)
+    {
+        if (size_ > 0) {
+            buffer_[0] = '\0';
+        }
+    }
+
+    /**
+     * Appends printf-style formatted text.
+     */
+#if defined(__GNUC__)
+    __attribute__((format(printf, 2, 3)))
+#endif
+    DebugResponse& print(const char* format, ...)
+    {
+        if (truncated_ || size_ == 0)
+            return *this;
+
+        va_list args;
+        va_start(args, format);
+        const int written = std::vsnprintf(buffer_ + length_, size_ - length_, format, args);
+        va_end(args);
+
+        if (written < 0 || length_ + static_cast<uint32_t>(written) >= size_) {
+            markTruncated();
+        } else {
+            length_ += static_cast<uint32_t>(written);
+        }
+        return *this;
+    }
+
+    bool isTruncated() const
+    {
+        return truncated_;
+    }
+
+    uint32_t getLength() const
+    {
+        return length_;
+    }
+
+private:
+    void markTruncated()
+    {
+        truncated_ = true;
+        static const char marker[] = "\n[truncated]\n";
+        if (size_ > sizeof(marker)) {
+            length_ = size_ - static_cast<uint32_t>(sizeof(marker));
+            std::memcpy(buffer_ + length_, marker, sizeof(marker));
+            length_ += static_cast<uint32_t>(sizeof(marker)) - 1;
+        } else {
+            length_ = size_ - 1;
+            buffer_[length_] = '\0';
+        }
+    }
+
+    char* buffer_;
+    uint32_t size_;
+    uint32_t length_ = 0;
+    bool truncated_ = false;
+};
+
+#endif // INCLUDED_DebugCommand_h_GUID_A02DEFC8_F920_4B04_9227_E769E0613C1E
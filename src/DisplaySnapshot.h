@@ -0,0 +1,111 @@
+/** @file
+    @brief What the display configuration says about each eye, read once.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DisplaySnapshot_h_GUID_68E987ED_869E_4FA9_AD51_26B614F8C912
+#define INCLUDED_DisplaySnapshot_h_GUID_68E987ED_869E_4FA9_AD51_26B614F8C912
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/ClientKit/Display.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Standard includes
+#include <cstdint>
+
+/**
+ * @brief One eye's first surface as the display configuration describes it.
+ */
+struct EyeSnapshot {
+    /// Clipping planes at unit distance, with top and bottom already swapped
+    /// the way SteamVR expects them
+    float left = 0.0f;
+    float right = 0.0f;
+    float top = 0.0f;
+    float bottom = 0.0f;
+
+    /// Output viewport, in pixels
+    uint32_t viewportX = 0;
+    uint32_t viewportY = 0;
+    uint32_t viewportWidth = 0;
+    uint32_t viewportHeight = 0;
+
+    OSVR_Pose3 pose = {}; ///< as reported when the snapshot was taken
+    bool hasPose = false;
+};
+
+/**
+ * @brief Everything the host asks about the display's geometry, copied out
+ * of an osvr::clientkit::DisplayConfig so that answering it doesn't go
+ * through ClientKit. Never changed once built; a new one replaces it when
+ * the configuration changes.
+ */
+struct DisplaySnapshot {
+    EyeSnapshot eyes[2];
+    uint32_t displayWidth = 0;  ///< of the first display input
+    uint32_t displayHeight = 0;
+    float ipd = 0.0f;           ///< distance between the eyes, in meters
+};
+
+/**
+ * Reads viewer 0's first two eyes out of @p display_config, which must have
+ * started up and have at least that many eyes, each with a surface.
+ */
+inline DisplaySnapshot makeDisplaySnapshot(const osvr::clientkit::DisplayConfig& display_config)
+{
+    DisplaySnapshot snapshot;
+    const auto dimensions = display_config.getDisplayDimensions(0);
+    snapshot.displayWidth = static_cast<uint32_t>(dimensions.width);
+    snapshot.displayHeight = static_cast<uint32_t>(dimensions.height);
+
+    const auto viewer = display_config.getViewer(0);
+    for (int eye = 0; eye < 2; ++eye) {
+        auto& eye_snapshot = snapshot.eyes[eye];
+        const auto surface = viewer.getEye(eye).getSurface(0);
+
+        const auto planes = surface.getProjectionClippingPlanes();
+        eye_snapshot.left = static_cast<float>(planes.left);
+        eye_snapshot.right = static_cast<float>(planes.right);
+        eye_snapshot.bottom = static_cast<float>(planes.top); // SWAPPED
+        eye_snapshot.top = static_cast<float>(planes.bottom); // SWAPPED
+
+        const auto viewport = surface.getRelativeViewport();
+        eye_snapshot.viewportX = static_cast<uint32_t>(viewport.left);
+        eye_snapshot.viewportY = static_cast<uint32_t>(viewport.bottom);
+        eye_snapshot.viewportWidth = static_cast<uint32_t>(viewport.width);
+        eye_snapshot.viewportHeight = static_cast<uint32_t>(viewport.height);
+
+        eye_snapshot.hasPose = viewer.getEye(eye).getPose(eye_snapshot.pose);
+    }
+
+    if (snapshot.eyes[0].hasPose && snapshot.eyes[1].hasPose) {
+        snapshot.ipd = static_cast<float>((osvr::util::vecMap(snapshot.eyes[0].pose.translation) - osvr::util::vecMap(snapshot.eyes[1].pose.translation)).norm());
+    }
+
+    return snapshot;
+}
+
+#endif // INCLUDED_DisplaySnapshot_h_GUID_68E987ED_869E_4FA9_AD51_26B614F8C912
@@ -0,0 +1,279 @@
+/** @file
+    @brief Lock-free latency histograms for the pose path.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_LatencyHistogram_h_GUID_341F7A9B_9676_4ACE_8D2C_192D81C6B49E
+#define INCLUDED_LatencyHistogram_h_GUID_341F7A9B_9676_4ACE_8D2C_192D81C6B49E
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::min
+#include <atomic>
+#include <cmath>            // for std::ceil
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+
+/**
+ * @brief Counts latencies in fixed, logarithmically spaced buckets.
+ *
+ * Latencies are kept in nanoseconds. Below 32 ns every nanosecond has its own
+ * bucket; above that, each power of two is split into 16 buckets, so a bucket
+ * is never wider than 1/16 of its lower bound. Latencies from zero to about 36
+ * minutes fit, and anything longer lands in the last bucket.
+ *
+ * Only one thread may record into a histogram, which lets recording be a few
+ * plain atomic loads and stores: no locks, no read-modify-write instructions
+ * and no allocation. Any number of threads may read while it records. A
+ * reader may see a sample counted in one field and not yet in another, which
+ * is harmless for statistics.
+ */
+class LatencyHistogram {
+public:
+    /// Buckets per power of two, as a power of two.
+    static const unsigned SubBucketBits = 4;
+    static const std::size_t SubBucketCount = std::size_t(1) << SubBucketBits;
+
+    /// Latencies at or above 2^(MaxExponent + 1) nanoseconds share the last
+    /// bucket.
+    static const unsigned MaxExponent = 40;
+
+    static const std::size_t BucketCount = (MaxExponent - SubBucketBits + 2) * SubBucketCount;
+
+    /**
+     * @brief A point-in-time summary of the histogram, in seconds.
+     */
+    struct Summary {
+        uint64_t count;
+        double mean;
+        double p50;
+        double p99;
+        double p999;
+        double max;
+    };
+
+    LatencyHistogram() : resetRequested_(false)
+    {
+        clear();
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * Counts a latency of @p seconds. Negative latencies, which can only come
+     * from clock error, count as zero.
+     */
+    void record(double seconds)
+    {
+        if (resetRequested_.load(std::memory_order_acquire)) {
+            clear();
+            resetRequested_.store(false, std::memory_order_release);
+        }
+
+        const uint64_t nanoseconds = (seconds > 0.0) ? static_cast<uint64_t>(std::min(seconds * 1e9, 1e18)) : 0;
+        increment(buckets_[getBucket(nanoseconds)], 1);
+        increment(count_, 1);
+        increment(sum_, nanoseconds);
+        if (nanoseconds > max_.load(std::memory_order_relaxed)) {
+            max_.store(nanoseconds, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Forgets all recorded latencies. May be called from any thread.
+     *
+     * The counts are cleared right away, and cleared again by the recording
+     * thread before its next sample, in case it was part way through one.
+     */
+    void reset()
+    {
+        clear();
+        resetRequested_.store(true, std::memory_order_release);
+    }
+
+    uint64_t getCount() const
+    {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Returns the latency (in seconds) that a fraction @p quantile of the
+     * samples are at or below, to within half a bucket, or zero if there are
+     * no samples.
+     */
+    double getQuantile(double quantile) const
+    {
+        uint64_t counts[BucketCount];
+        const uint64_t total = copyBuckets(counts);
+        return getQuantile(counts, total, quantile);
+    }
+
+    /**
+     * Summarizes the histogram from a single pass over its buckets.
+     */
+    Summary getSummary() const
+    {
+        uint64_t counts[BucketCount];
+        const uint64_t total = copyBuckets(counts);
+
+        Summary summary;
+        summary.count = total;
+        summary.mean = total ? static_cast<double>(sum_.load(std::memory_order_relaxed)) / total * 1e-9 : 0.0;
+        summary.p50 = getQuantile(counts, total, 0.5);
+        summary.p99 = getQuantile(counts, total, 0.99);
+        summary.p999 = getQuantile(counts, total, 0.999);
+        summary.max = static_cast<double>(max_.load(std::memory_order_relaxed)) * 1e-9;
+        return summary;
+    }
+
+    /**
+     * Returns the bucket a latency of @p nanoseconds is counted in.
+     */
+    static std::size_t getBucket(uint64_t nanoseconds)
+    {
+        if (nanoseconds < 2 * SubBucketCount)
+            return static_cast<std::size_t>(nanoseconds);
+
+        if ((nanoseconds >> (MaxExponent + 1)) != 0)
+            return BucketCount - 1;
+
+        // Index of the highest set bit, by binary search
+        unsigned exponent = 0;
+        for (unsigned step = 32; step > 0; step /= 2) {
+            if ((nanoseconds >> (exponent + step)) != 0)
+                exponent += step;
+        }
+
+        const unsigned shift = exponent - SubBucketBits;
+        return (shift + 1) * SubBucketCount + static_cast<std::size_t>((nanoseconds >> shift) - SubBucketCount);
+    }
+
+    /**
+     * Returns the smallest latency, in nanoseconds, counted in @p bucket.
+     */
+    static uint64_t getBucketLowerBound(std::size_t bucket)
+    {
+        if (bucket < 2 * SubBucketCount)
+            return bucket;
+
+        const std::size_t shift = bucket / SubBucketCount - 1;
+        return static_cast<uint64_t>(bucket % SubBucketCount + SubBucketCount) << shift;
+    }
+
+    static uint64_t getBucketWidth(std::size_t bucket)
+    {
+        return (bucket < 2 * SubBucketCount) ? 1 : uint64_t(1) << (bucket / SubBucketCount - 1);
+    }
+
+private:
+    void clear()
+    {
+        for (auto& bucket : buckets_) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Adds to a counter only this thread writes, without the cost of an
+     * atomic read-modify-write.
+     */
+    static void increment(std::atomic<uint64_t>& counter, uint64_t amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    /**
+     * Copies the bucket counts, returning their total, which may differ
+     * slightly from count_ while samples are being recorded.
+     */
+    uint64_t copyBuckets(uint64_t (&counts)[BucketCount]) const
+    {
+        uint64_t total = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i) {
+            counts[i] = buckets_[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        return total;
+    }
+
+    double getQuantile(const uint64_t (&counts)[BucketCount], uint64_t total, double quantile) const
+    {
+        if (0 == total)
+            return 0.0;
+
+        const double rank = std::ceil(std::min(std::max(quantile, 0.0), 1.0) * total);
+        const uint64_t target = std::max<uint64_t>(static_cast<uint64_t>(rank), 1);
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i) {
+            seen += counts[i];
+            if (seen >= target) {
+                // The last bucket has no upper bound, so the largest latency
+                // seen is the best answer there.
+                if (BucketCount - 1 == i)
+                    break;
+
+                // Report the middle of the bucket, but never more than the
+                // largest latency actually seen.
+                const double middle = getBucketLowerBound(i) + 0.5 * (getBucketWidth(i) - 1);
+                return std::min(middle, static_cast<double>(max_.load(std::memory_order_relaxed))) * 1e-9;
+            }
+        }
+        return static_cast<double>(max_.load(std::memory_order_relaxed)) * 1e-9;
+    }
+
+    std::atomic<uint64_t> buckets_[BucketCount];
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_;             ///< in nanoseconds
+    std::atomic<uint64_t> max_;             ///< in nanoseconds
+    std::atomic<bool> resetRequested_;
+};
+
+/**
+ * @brief Where the time goes between a tracker measuring a pose and the host
+ * receiving it, stage by stage.
+ *
+ * Every stage is timed on the host clock, with report timestamps mapped onto
+ * it by the ClockBridge.
+ */
+struct PoseLatencyStats {
+    LatencyHistogram reportToCallback;  ///< report timestamp to tracker callback entry
+    LatencyHistogram callbackToHost;    ///< callback entry to return from TrackedDevicePoseUpdated()
+    LatencyHistogram reportToHost;      ///< report timestamp to return from TrackedDevicePoseUpdated()
+
+    void reset()
+    {
+        reportToCallback.reset();
+        callbackToHost.reset();
+        reportToHost.reset();
+    }
+};
+
+#endif // INCLUDED_LatencyHistogram_h_GUID_341F7A9B_9676_4ACE_8D2C_192D81C6B49E
@@ -29,12 +29,15 @@
 #include "osvr_compiler_detection.h"
 #include "make_unique.h"
 #include "matrix_cast.h"
-#include "osvr_device_properties.h"
+#include "PoseRecordConversion.h"
+#include "StartupWait.h"
 #include "ValveStrCpy.h"
 #include "platform_fixes.h" // strcasecmp
 #include "make_unique.h"
 #include "osvr_platform.h"
-#include "display/DisplayEnumerator.h"
+#include "display/DisplayMonitor.h"
+#include "distortion/DistortionCache.h"
+#include "distortion/RenderDensity.h"
 
 // OpenVR includes
 #include <openvr_driver.h>
@@ -47,20 +50,162 @@
 
 // Standard includes
 #include <cstring>
-#include <ctime>
 #include <string>
 #include <iostream>
 #include <exception>
 #include <fstream>
-#include <algorithm>        // for std::find
+#include <thread>           // for std::this_thread::sleep_for
+#include <algorithm>        // for std::max, std::min
+#include <cctype>           // for std::toupper
+#include <chrono>
+#include <cmath>            // for std::abs, std::ceil
+#include <utility>          // for std::move
+
+namespace {
+
+/**
+ * Velocity reports older than this many seconds relative to the pose they'd
+ * be combined with are ignored in favor of the estimated velocity.
+ */
+const double MaxVelocityReportAge = 0.1;
+
+double toSeconds(const OSVR_TimeValue& time_value)
+{
+    return static_cast<double>(time_value.seconds) + static_cast<double>(time_value.microseconds) * 1e-6;
+}
+
+/**
+ * Builds the pose we hand to the host from a tracked position and
+ * orientation and their velocities.
+ */
+vr::DriverPose_t makeDriverPose(double pose_time_offset, const Eigen::Vector3d& position, const Eigen::Quaterniond& orientation, const Eigen::Vector3d& velocity, const Eigen::Vector3d& angular_velocity)
+{
+    vr::DriverPose_t pose;
+    pose.poseTimeOffset = pose_time_offset;
+
+    Eigen::Vector3d::Map(pose.vecWorldFromDriverTranslation) = Eigen::Vector3d::Zero();
+    Eigen::Vector3d::Map(pose.vecDriverFromHeadTranslation) = Eigen::Vector3d::Zero();
+
+    map(pose.qWorldFromDriverRotation) = Eigen::Quaterniond::Identity();
+
+    map(pose.qDriverFromHeadRotation) = Eigen::Quaterniond::Identity();
+
+    // Position
+    Eigen::Vector3d::Map(pose.vecPosition) = position;
+    Eigen::Vector3d::Map(pose.vecVelocity) = velocity;
+
+    // Acceleration is not currently consistently provided
+    Eigen::Vector3d::Map(pose.vecAcceleration) = Eigen::Vector3d::Zero();
+
+    // Orientation
+    map(pose.qRotation) = orientation;
+    Eigen::Vector3d::Map(pose.vecAngularVelocity) = angular_velocity;
+
+    // Angular acceleration is not currently consistently provided
+    Eigen::Vector3d::Map(pose.vecAngularAcceleration) = Eigen::Vector3d::Zero();
 
-OSVRTrackedDevice::OSVRTrackedDevice(const std::string& display_description, osvr::clientkit::ClientContext& context, vr::IServerDriverHost* driver_host, vr::IDriverLog* driver_log) : m_DisplayDescription(display_description), m_Context(context), driver_host_(driver_host), pose_(), deviceClass_(vr::TrackedDeviceClass_HMD)
+    pose.result = vr::TrackingResult_Running_OK;
+    pose.poseIsValid = true;
+    pose.willDriftInYaw = true;
+    pose.shouldApplyHeadModel = true;
+
+    return pose;
+}
+
+/**
+ * Logs the percentiles of one stage of pose latency, in milliseconds.
+ */
+void logLatency(const char* stage, const LatencyHistogram& histogram)
+{
+    const auto summary = histogram.getSummary();
+    OSVR_LOG(info) << "  " << stage << ": p50 " << summary.p50 * 1e3 << " ms, p99 " << summary.p99 * 1e3 << " ms, p99.9 " << summary.p999 * 1e3 << " ms, max " << summary.max * 1e3 << " ms";
+}
+
+/**
+ * Lists the pose filters in use and their parameters.
+ */
+void printPoseFilters(const PoseFilterChain& filters, DebugResponse& response)
+{
+    if (filters.empty()) {
+        response.print("poseFilters: none\n");
+        return;
+    }
+
+    response.print("poseFilters:\n");
+    for (std::size_t i = 0; i < filters.size(); ++i) {
+        const auto& stage = filters.getStage(i);
+        response.print("  %s:", stage.getName());
+        for (std::size_t j = 0; j < stage.getParameterCount(); ++j) {
+            response.print(" %s=%g", stage.getParameterName(j), stage.getParameter(j));
+        }
+        response.print("\n");
+    }
+}
+
+vr::DistortionCoordinates_t toDistortionCoordinates(const osvr::distortion::DistortedPoint& point)
+{
+    using osvr::distortion::Red;
+    using osvr::distortion::Green;
+    using osvr::distortion::Blue;
+
+    vr::DistortionCoordinates_t coords;
+    coords.rfRed[0] = point.channels[Red][0];
+    coords.rfRed[1] = point.channels[Red][1];
+    coords.rfGreen[0] = point.channels[Green][0];
+    coords.rfGreen[1] = point.channels[Green][1];
+    coords.rfBlue[0] = point.channels[Blue][0];
+    coords.rfBlue[1] = point.channels[Blue][1];
+    return coords;
+}
+
+const char* getRotationName(osvr::display::Rotation rotation)
+{
+    switch (rotation) {
+    case osvr::display::Rotation::Ninety:
+        return "portrait";
+    case osvr::display::Rotation::OneEighty:
+        return "landscape (flipped)";
+    case osvr::display::Rotation::TwoSeventy:
+        return "portrait (flipped)";
+    case osvr::display::Rotation::Zero:
+    default:
+        return "landscape";
+    }
+}
+
+/**
+ * Stores a property value in the field for its type.
+ */
+template <typename Field, typename Value>
+vr::ETrackedPropertyError setPropertyValue(Field& field, const Value& value)
+{
+    field = value;
+    return vr::TrackedProp_Success;
+}
+
+template <typename Field>
+vr::ETrackedPropertyError setPropertyValue(Field&, TrackedPropertyNotProvided)
+{
+    return vr::TrackedProp_ValueNotProvidedByDevice;
+}
+
+} // end anonymous namespace
+
+OSVRTrackedDevice::OSVRTrackedDevice(const std::string& display_description, osvr::clientkit::ClientContext& context, vr::IServerDriverHost* driver_host, vr::IDriverLog* driver_log, const std::string& user_driver_config_dir) : m_DisplayDescription(display_description), m_Context(context), driver_host_(driver_host), pose_(), userDriverConfigDir_(user_driver_config_dir), deviceClass_(vr::TrackedDeviceClass_HMD)
 {
     settings_ = std::make_unique<Settings>(driver_host->GetSettings(vr::IVRSettings_Version));
     if (driver_log) {
         Logging::instance().setDriverLog(driver_log);
     }
     configure();
+
+    auto distortion = std::make_shared<DistortionState>();
+    try {
+        distortion->model = osvr::distortion::DistortionModel::fromDisplayDescriptor(m_DisplayDescription);
+    } catch (const std::exception& e) {
+        OSVR_LOG(err) << "OSVRTrackedDevice::OSVRTrackedDevice(): Ignoring the display descriptor's distortion: " << e.what() << "\n";
+    }
+    distortion_ = std::move(distortion);
 }
 
 OSVRTrackedDevice::~OSVRTrackedDevice()
@@ -70,35 +215,42 @@ OSVRTrackedDevice::~OSVRTrackedDevice()
 
 vr::EVRInitError OSVRTrackedDevice::Activate(uint32_t object_id)
 {
-    const std::time_t waitTime = 5; // wait up to 5 seconds for init
+    auto context_lock = lockContext();
 
     // Register tracker callback
     if (m_TrackerInterface.notEmpty()) {
         m_TrackerInterface.free();
     }
 
-    // Ensure context is fully started up
+    // Wait for the context, then the display, to start up, backing off
+    // between updates rather than spinning. The tracking thread, if there is
+    // one, gets the context while we sleep.
+    StartupWait startup(startupTimeout_);
+    const auto update_context = [&] { m_Context.update(); };
+    const auto sleep = [&](StartupWait::clock::duration delay) {
+        const bool locked = context_lock.owns_lock();
+        if (locked)
+            context_lock.unlock();
+        std::this_thread::sleep_for(delay);
+        if (locked)
+            context_lock.lock();
+    };
+
     OSVR_LOG(trace) << "Waiting for the context to fully start up...\n";
-    std::time_t startTime = std::time(nullptr);
-    while (!m_Context.checkStatus()) {
-        m_Context.update();
-        if (std::time(nullptr) > startTime + waitTime) {
-            OSVR_LOG(err) << "Context startup timed out!\n";
-            return vr::VRInitError_Driver_Failed;
-        }
+    bool started = startup.wait("context", [&] { return m_Context.checkStatus(); }, update_context, sleep);
+    if (started) {
+        m_DisplayConfig = osvr::clientkit::DisplayConfig(m_Context);
+        OSVR_LOG(trace) << "Waiting for the display to fully start up, including receiving initial pose update...\n";
+        started = startup.wait("display", [&] { return m_DisplayConfig.checkStartup(); }, update_context, sleep);
     }
 
-    m_DisplayConfig = osvr::clientkit::DisplayConfig(m_Context);
-
-    // Ensure display is fully started up
-    OSVR_LOG(trace) << "Waiting for the display to fully start up, including receiving initial pose update...\n";
-    startTime = std::time(nullptr);
-    while (!m_DisplayConfig.checkStartup()) {
-        m_Context.update();
-        if (std::time(nullptr) > startTime + waitTime) {
-            OSVR_LOG(err) << "Display startup timed out!\n";
-            return vr::VRInitError_Driver_Failed;
-        }
+    startupPhases_ = startup.getPhases();
+    for (const auto& phase : startupPhases_) {
+        OSVR_LOG(info) << "OSVRTrackedDevice::Activate(): Startup phase '" << phase.name << "' " << (phase.ready ? "took " : "gave up after ") << phase.seconds * 1e3 << " ms and " << phase.updates << " updates.\n";
+    }
+    if (!started) {
+        OSVR_LOG(err) << "OSVRTrackedDevice::Activate(): Startup timed out waiting for the " << startupPhases_.back().name << " after " << startup.getElapsed() << " seconds!\n";
+        return vr::VRInitError_Driver_Failed;
     }
 
     // Verify valid display config
@@ -117,9 +269,23 @@ vr::EVRInitError OSVRTrackedDevice::Activate(uint32_t object_id)
         }
     }
 
+    displayDescriptor_ = m_Context.getStringParameter("/display");
+    pendingDisplayConfig_ = osvr::clientkit::DisplayConfig();
+    nextDisplayCheck_ = std::chrono::steady_clock::now() + displayCheckInterval_;
+    updateDisplaySnapshot();
+
     // Register tracker callback
     m_TrackerInterface = m_Context.getInterface("/me/head");
+    {
+        std::lock_guard<std::mutex> filters_lock(poseFiltersMutex_);
+        poseFilters_.reset();
+    }
+    velocityEstimator_.reset();
+    haveVelocityReport_ = false;
+    poseHistory_.clear();
+    latency_.reset();
     m_TrackerInterface.registerCallback(&OSVRTrackedDevice::HmdTrackerCallback, this);
+    m_TrackerInterface.registerCallback(&OSVRTrackedDevice::HmdVelocityCallback, this);
 
     auto configString = m_Context.getStringParameter("/renderManagerConfig");
 
@@ -137,6 +303,18 @@ vr::EVRInitError OSVRTrackedDevice::Activate(uint32_t object_id)
         OSVR_LOG(err) << "OSVRTrackedDevice::Activate(): Exception parsing Render Manager config: " << e.what() << "\n";
     }
 
+    objectId_ = object_id;
+    updatePropertySnapshot();
+    renderManagerConfigString_ = configString;
+    updateDistortion(displayDescriptor_, renderManagerConfigString_);
+    {
+        std::lock_guard<std::mutex> governor_lock(renderGovernorMutex_);
+        const double refresh_rate = (display_.verticalRefreshRate > 0.0) ? display_.verticalRefreshRate : 90.0;
+        renderGovernor_.setTargetFrameTime((renderGovernorFrameTime_ > 0.0) ? renderGovernorFrameTime_ : 1.0 / refresh_rate);
+        renderGovernor_.reset();
+    }
+    updateRenderTargetSize();
+
     /// @fixme figure out ID correctly, don't hardcode to zero
     driver_host_->ProximitySensorState(0, true);
 
@@ -146,10 +324,19 @@ vr::EVRInitError OSVRTrackedDevice::Activate(uint32_t object_id)
 
 void OSVRTrackedDevice::Deactivate()
 {
+    auto context_lock = lockContext();
+
     /// Have to force freeing here
     if (m_TrackerInterface.notEmpty()) {
         m_TrackerInterface.free();
     }
+
+    if (latency_.reportToHost.getCount() > 0) {
+        OSVR_LOG(info) << "Pose latency over " << latency_.reportToHost.getCount() << " reports:";
+        logLatency("Report to callback", latency_.reportToCallback);
+        logLatency("Callback to host", latency_.callbackToHost);
+        logLatency("Report to host", latency_.reportToHost);
+    }
 }
 
 void OSVRTrackedDevice::PowerOff()
@@ -169,21 +356,51 @@ void* OSVRTrackedDevice::GetComponent(const char* component_name_and_version)
 
 void OSVRTrackedDevice::DebugRequest(const char* request, char* response_buffer, uint32_t response_buffer_size)
 {
-    // TODO
-    // make use of (from vrtypes.h) static const uint32_t k_unMaxDriverDebugResponseSize = 32768;
+    // Everything is parsed in place and printed straight into the response
+    // buffer (up to vr::k_unMaxDriverDebugResponseSize bytes), so requests
+    // don't allocate.
+    const DebugCommand command(request);
+    DebugResponse response(response_buffer, response_buffer_size);
+
+    if (0 == command.size() || command.is(0, "help")) {
+        response.print("Requests:\n"
+                       "  stats                 report counts and the latest pose\n"
+                       "  latency               pose latency percentiles, by stage\n"
+                       "  filter                pose filters and their parameters\n"
+                       "  filter set <filter> <parameter> <value>\n"
+                       "                        retune a pose filter\n"
+                       "  filter reset          restart every pose filter\n"
+                       "  dump-config           settings and display in use\n"
+                       "  reset-counters        zero the report counts and latency stats\n"
+                       "  governor              render resolution governor state\n"
+                       "  governor frame <ms>   report how long a frame took to render\n"
+                       "  startup               how long each phase of activation took\n");
+    } else if (command.is(0, "stats")) {
+        debugStats(response);
+    } else if (command.is(0, "latency")) {
+        debugLatency(response);
+    } else if (command.is(0, "filter")) {
+        debugFilter(command, response);
+    } else if (command.is(0, "dump-config")) {
+        debugDumpConfig(response);
+    } else if (command.is(0, "reset-counters")) {
+        debugResetCounters(response);
+    } else if (command.is(0, "governor")) {
+        debugGovernor(command, response);
+    } else if (command.is(0, "startup")) {
+        debugStartup(response);
+    } else {
+        response.print("error: unknown request '%.*s'; send 'help' for a list.\n", command.getLength(0), command.getWord(0));
+    }
 }
 
 void OSVRTrackedDevice::GetWindowBounds(int32_t* x, int32_t* y, uint32_t* width, uint32_t* height)
 {
-    int nDisplays = m_DisplayConfig.getNumDisplayInputs();
-    if (nDisplays != 1) {
-        OSVR_LOG(err) << "OSVRTrackedDevice::OSVRTrackedDevice(): Unexpected display number of displays!\n";
-    }
-    osvr::clientkit::DisplayDimensions displayDims = m_DisplayConfig.getDisplayDimensions(0);
+    const auto snapshot = getDisplaySnapshot();
     *x = m_RenderManagerConfig.getWindowXPosition(); // todo: assumes desktop display of 1920. get this from display config when it's exposed.
     *y = m_RenderManagerConfig.getWindowYPosition();
-    *width = displayDims.width;
-    *height = displayDims.height;
+    *width = snapshot->displayWidth;
+    *height = snapshot->displayHeight;
 
 #ifdef OSVR_WINDOWS
     // ... until we've added code for other platforms, this is Windows-only
@@ -196,12 +413,26 @@ void OSVRTrackedDevice::GetWindowBounds(int32_t* x, int32_t* y, uint32_t* width,
 
 bool OSVRTrackedDevice::IsDisplayOnDesktop()
 {
-    // If the current display still appeara in the active displays list,
-    // then it's attached to the desktop.
-    const auto displays = osvr::display::getDisplays();
-    const auto display_on_desktop = (end(displays) != std::find(begin(displays), end(displays), display_));
-    OSVR_LOG(trace) << "OSVRTrackedDevice::IsDisplayOnDesktop(): " << (display_on_desktop ? "yes" : "no");
-    return display_on_desktop;
+    // Only look through the displays again once the monitor has seen them
+    // change.
+    auto& monitor = osvr::display::DisplayMonitor::instance();
+    if (monitor.getGeneration() != displayGeneration_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(displayStateMutex_);
+        uint64_t generation = 0;
+        const auto displays = monitor.getDisplays(&generation);
+        if (generation != displayGeneration_.load(std::memory_order_relaxed)) {
+            // Displays may be listed whether or not they're on the desktop
+            // (Linux lists every connected connector), so look ours up and
+            // ask it.
+            const int index = osvr::display::findDisplay(displays, display_);
+            const bool display_on_desktop = (index >= 0) && displays[index].attachedToDesktop;
+            OSVR_LOG(trace) << "OSVRTrackedDevice::IsDisplayOnDesktop(): " << (display_on_desktop ? "yes" : "no");
+            displayOnDesktop_.store(display_on_desktop, std::memory_order_relaxed);
+            displayGeneration_.store(generation, std::memory_order_release);
+        }
+    }
+
+    return displayOnDesktop_.load(std::memory_order_relaxed);
 }
 
 bool OSVRTrackedDevice::IsDisplayRealDisplay()
@@ -212,658 +443,602 @@ bool OSVRTrackedDevice::IsDisplayRealDisplay()
 
 void OSVRTrackedDevice::GetRecommendedRenderTargetSize(uint32_t* width, uint32_t* height)
 {
-    /// @todo calculate overfill factor properly
-    double overfill_factor = 1.0;
+    // Worked out from the distortion on activation
+    const uint32_t cached_width = renderTargetWidth_.load();
+    const uint32_t cached_height = renderTargetHeight_.load();
+    if (cached_width > 0 && cached_height > 0) {
+        *width = cached_width;
+        *height = cached_height;
+        return;
+    }
+
     int32_t x, y;
     uint32_t w, h;
     GetWindowBounds(&x, &y, &w, &h);
 
     // conversion to avoid compiler warnings
-    *width = uint32_t(w * overfill_factor);
-    *height = uint32_t(h * overfill_factor);
+    *width = uint32_t(w * renderQuality_);
+    *height = uint32_t(h * renderQuality_);
 }
 
 void OSVRTrackedDevice::GetEyeOutputViewport(vr::EVREye eye, uint32_t* x, uint32_t* y, uint32_t* width, uint32_t* height)
 {
-    osvr::clientkit::RelativeViewport viewPort = m_DisplayConfig.getViewer(0).getEye(eye).getSurface(0).getRelativeViewport();
-    *x = viewPort.left;
-    *y = viewPort.bottom;
-    *width = viewPort.width;
-    *height = viewPort.height;
+    const auto snapshot = getDisplaySnapshot();
+    const auto& eye_snapshot = snapshot->eyes[(vr::Eye_Left == eye) ? 0 : 1];
+    *x = eye_snapshot.viewportX;
+    *y = eye_snapshot.viewportY;
+    *width = eye_snapshot.viewportWidth;
+    *height = eye_snapshot.viewportHeight;
 }
 
 void OSVRTrackedDevice::GetProjectionRaw(vr::EVREye eye, float* left, float* right, float* top, float* bottom)
 {
     // Reference: https://github.com/ValveSoftware/openvr/wiki/IVRSystem::GetProjectionRaw
-    // SteamVR expects top and bottom to be swapped!
-    osvr::clientkit::ProjectionClippingPlanes pl = m_DisplayConfig.getViewer(0).getEye(eye).getSurface(0).getProjectionClippingPlanes();
-    *left = static_cast<float>(pl.left);
-    *right = static_cast<float>(pl.right);
-    *bottom = static_cast<float>(pl.top); // SWAPPED
-    *top = static_cast<float>(pl.bottom); // SWAPPED
+    // SteamVR expects top and bottom to be swapped; the snapshot has them
+    // that way already.
+    const auto snapshot = getDisplaySnapshot();
+    const auto& eye_snapshot = snapshot->eyes[(vr::Eye_Left == eye) ? 0 : 1];
+    *left = eye_snapshot.left;
+    *right = eye_snapshot.right;
+    *top = eye_snapshot.top;
+    *bottom = eye_snapshot.bottom;
 }
 
 vr::DistortionCoordinates_t OSVRTrackedDevice::ComputeDistortion(vr::EVREye eye, float u, float v)
 {
-    /// @todo FIXME Compute distortion using display configuration data
-    vr::DistortionCoordinates_t coords;
-    coords.rfRed[0] = u;
-    coords.rfRed[1] = v;
-    coords.rfBlue[0] = u;
-    coords.rfBlue[1] = v;
-    coords.rfGreen[0] = u;
-    coords.rfGreen[1] = v;
-    return coords;
+    // SteamVR asks for every vertex of its distortion mesh, so look these up
+    // in the grids baked on activation.
+    const int index = (vr::Eye_Left == eye) ? 0 : 1;
+    const auto distortion = getDistortion();
+    const auto& grid = distortion->grids[index];
+    if (grid)
+        return toDistortionCoordinates(grid->lookup(u, v));
+
+    return toDistortionCoordinates(distortion->model.compute(index, u, v));
 }
 
 vr::DriverPose_t OSVRTrackedDevice::GetPose()
 {
-    return pose_;
+    return pose_.read();
 }
 
-bool OSVRTrackedDevice::GetBoolTrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError* error)
+bool OSVRTrackedDevice::GetPoseAtTime(double host_time, vr::DriverPose_t& pose, double max_extrapolation) const
 {
-    const bool default_value = false;
+    TimedPose timed_pose;
+    if (!poseHistory_.sample(host_time, timed_pose, max_extrapolation))
+        return false;
 
-    if (isWrongDataType(prop, bool())) {
-        if (error)
-            *error = vr::TrackedProp_WrongDataType;
-        return default_value;
-    }
+    pose = makeDriverPose(timed_pose.time - ClockBridge::hostNow(), timed_pose.position, timed_pose.orientation, timed_pose.linearVelocity, timed_pose.angularVelocity);
+    return true;
+}
 
-    if (isWrongDeviceClass(prop, deviceClass_)) {
-        if (error)
-            *error = vr::TrackedProp_WrongDeviceClass;
-        return default_value;
-    }
+const OSVRTrackedDevice::PoseHistoryType& OSVRTrackedDevice::GetPoseHistory() const
+{
+    return poseHistory_;
+}
 
-    if (vr::TrackedDeviceClass_Invalid == deviceClass_) {
-        if (error)
-            *error = vr::TrackedProp_InvalidDevice;
-        return default_value;
+void OSVRTrackedDevice::debugStats(DebugResponse& response) const
+{
+    response.print("pose reports: %llu\n", static_cast<unsigned long long>(poseReportCount_.load(std::memory_order_relaxed)));
+    response.print("velocity reports: %llu\n", static_cast<unsigned long long>(velocityReportCount_.load(std::memory_order_relaxed)));
+    response.print("pose history: %llu poses\n", static_cast<unsigned long long>(poseHistory_.size()));
+    response.print("recording: %s\n", poseRecorder_.isOpen() ? "on" : "off");
+
+    TimedPose newest;
+    if (!poseHistory_.get(0, newest)) {
+        response.print("latest pose: none\n");
+        return;
     }
 
-#include "ignore-warning/push"
-#include "ignore-warning/switch-enum"
-
-    OSVR_LOG(trace) << "OSVRTrackedDevice::GetBoolTrackedDeviceProperty(): Requested property: " << prop << "\n";
+    response.print("latest pose: %.3f ms ago\n", (ClockBridge::hostNow() - newest.time) * 1e3);
+    response.print("  position: %.5f %.5f %.5f m\n", newest.position.x(), newest.position.y(), newest.position.z());
+    response.print("  orientation (wxyz): %.5f %.5f %.5f %.5f\n", newest.orientation.w(), newest.orientation.x(), newest.orientation.y(), newest.orientation.z());
+}
 
-    switch (prop) {
-    // Properties that apply to all device classes
-    case vr::Prop_WillDriftInYaw_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return true;
-        break;
-    case vr::Prop_DeviceIsWireless_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return false;
-        break;
-    case vr::Prop_DeviceIsCharging_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return false;
-        break;
-    case vr::Prop_Firmware_UpdateAvailable_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return false;
-        break;
-    case vr::Prop_Firmware_ManualUpdate_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return false;
-        break;
-    case vr::Prop_BlockServerShutdown_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return false;
-        break;
-    case vr::Prop_CanUnifyCoordinateSystemWithHmd_Bool: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-        break;
-    case vr::Prop_ContainsProximitySensor_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return true;
-        break;
-    case vr::Prop_DeviceProvidesBatteryStatus_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return false;
-        break;
-    case vr::Prop_DeviceCanPowerOff_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return true;
-        break;
-    case vr::Prop_HasCamera_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return false;
-        break;
-    // Properties that apply to HMDs
-    case vr::Prop_ReportsTimeSinceVSync_Bool: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-        break;
-    case vr::Prop_IsOnDesktop_Bool:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return this->IsDisplayOnDesktop();
-        break;
+void OSVRTrackedDevice::debugLatency(DebugResponse& response) const
+{
+    const struct {
+        const char* name;
+        const LatencyHistogram& histogram;
+    } stages[] = {
+        { "report to callback", latency_.reportToCallback },
+        { "callback to host", latency_.callbackToHost },
+        { "report to host", latency_.reportToHost },
+    };
+
+    response.print("%-20s %10s %10s %10s %10s %10s %10s\n", "stage (us)", "count", "mean", "p50", "p99", "p99.9", "max");
+    for (const auto& stage : stages) {
+        const auto summary = stage.histogram.getSummary();
+        response.print("%-20s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f\n", stage.name, static_cast<unsigned long long>(summary.count),
+                       summary.mean * 1e6, summary.p50 * 1e6, summary.p99 * 1e6, summary.p999 * 1e6, summary.max * 1e6);
     }
-
-#include "ignore-warning/pop"
-
-    OSVR_LOG(warn) << "OSVRTrackedDevice::GetBoolTrackedDeviceProperty(): Unknown property " << prop << " requested.\n";
-    if (error)
-        *error = vr::TrackedProp_UnknownProperty;
-    return default_value;
 }
 
-float OSVRTrackedDevice::GetFloatTrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError* error)
+void OSVRTrackedDevice::debugFilter(const DebugCommand& command, DebugResponse& response)
 {
-    const float default_value = 0.0f;
+    std::lock_guard<std::mutex> filters_lock(poseFiltersMutex_);
+
+    if (command.size() == 1) {
+        printPoseFilters(poseFilters_, response);
+        return;
+    }
 
-    if (isWrongDataType(prop, float())) {
-        if (error)
-            *error = vr::TrackedProp_WrongDataType;
-        return default_value;
+    if (command.is(1, "reset") && command.size() == 2) {
+        poseFilters_.reset();
+        response.print("pose filters reset\n");
+        return;
     }
 
-    if (isWrongDeviceClass(prop, deviceClass_)) {
-        if (error)
-            *error = vr::TrackedProp_WrongDeviceClass;
-        return default_value;
+    if (!command.is(1, "set") || command.size() != 5) {
+        response.print("error: expected 'filter', 'filter reset' or 'filter set <filter> <parameter> <value>'\n");
+        return;
     }
 
-    if (vr::TrackedDeviceClass_Invalid == deviceClass_) {
-        if (error)
-            *error = vr::TrackedProp_InvalidDevice;
-        return default_value;
+    double value = 0.0;
+    if (!command.getNumber(4, value)) {
+        response.print("error: '%.*s' isn't a number\n", command.getLength(4), command.getWord(4));
+        return;
     }
 
-#include "ignore-warning/push"
-#include "ignore-warning/switch-enum"
+    for (std::size_t i = 0; i < poseFilters_.size(); ++i) {
+        auto& stage = poseFilters_.getStage(i);
+        if (!command.is(2, stage.getName()))
+            continue;
 
-    OSVR_LOG(trace) << "OSVRTrackedDevice::GetFloatTrackedDeviceProperty(): Requested property: " << prop << "\n";
+        for (std::size_t j = 0; j < stage.getParameterCount(); ++j) {
+            if (!command.is(3, stage.getParameterName(j)))
+                continue;
 
-    switch (prop) {
-    // General properties that apply to all device classes
-    case vr::Prop_DeviceBatteryPercentage_Float:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return 1.0f; // full battery
-    // Properties that are unique to TrackedDeviceClass_HMD
-    case vr::Prop_SecondsFromVsyncToPhotons_Float: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayFrequency_Float:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return display_.verticalRefreshRate;
-    case vr::Prop_UserIpdMeters_Float:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return GetIPD();
-    case vr::Prop_DisplayMCOffset_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayMCScale_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayGCBlackClamp_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayGCOffset_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayGCScale_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayGCPrescale_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_LensCenterLeftU_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_LensCenterLeftV_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_LensCenterRightU_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_LensCenterRightV_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_UserHeadToEyeDepthMeters_Float:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    // Properties that are unique to TrackedDeviceClass_TrackingReference
-    case vr::Prop_FieldOfViewLeftDegrees_Float: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_FieldOfViewRightDegrees_Float: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_FieldOfViewTopDegrees_Float: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_FieldOfViewBottomDegrees_Float: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_TrackingRangeMinimumMeters_Float: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_TrackingRangeMaximumMeters_Float: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
+            const double previous = stage.getParameter(j);
+            stage.setParameter(j, value);
+            response.print("%s %s: %g (was %g)\n", stage.getName(), stage.getParameterName(j), stage.getParameter(j), previous);
+            return;
+        }
+
+        response.print("error: %s has no parameter '%.*s'\n", stage.getName(), command.getLength(3), command.getWord(3));
+        return;
     }
 
-#include "ignore-warning/pop"
+    response.print("error: no pose filter '%.*s' is in use\n", command.getLength(2), command.getWord(2));
+}
 
-    OSVR_LOG(warn) << "OSVRTrackedDevice::GetFloatTrackedDeviceProperty(): Unknown property " << prop << " requested.\n";
-    if (error)
-        *error = vr::TrackedProp_UnknownProperty;
-    return default_value;
+void OSVRTrackedDevice::debugDumpConfig(DebugResponse& response)
+{
+    response.print("verbose: %s\n", (Logging::instance().getLogLevel() <= trace) ? "true" : "false");
+    response.print("trackingMode: %s\n", contextMutex_ ? "thread" : "frame");
+    response.print("velocitySmoothing: %g\n", velocityEstimator_.getSmoothing());
+    {
+        std::lock_guard<std::mutex> filters_lock(poseFiltersMutex_);
+        printPoseFilters(poseFilters_, response);
+    }
+    response.print("poseRecording: %s\n", poseRecorder_.isOpen() ? "on" : "off");
+    response.print("renderQuality: %g\n", renderQuality_);
+    response.print("renderGovernor: %s\n", renderGovernorEnabled_ ? "on" : "off");
+
+    response.print("display:\n");
+    response.print("  adapter: %s\n", display_.adapter.description.c_str());
+    response.print("  monitor name: %s\n", display_.name.c_str());
+    response.print("  connector: %s\n", display_.connector.c_str());
+    response.print("  resolution: %dx%d\n", static_cast<int>(display_.size.width), static_cast<int>(display_.size.height));
+    response.print("  position: (%d, %d)\n", static_cast<int>(display_.position.x), static_cast<int>(display_.position.y));
+    response.print("  rotation: %s\n", getRotationName(display_.rotation));
+    response.print("  refresh rate: %g\n", display_.verticalRefreshRate);
+    response.print("  mode: %s\n", display_.attachedToDesktop ? "extended" : "direct");
+    response.print("  EDID vendor ID: %u\n", static_cast<unsigned>(display_.edidVendorId));
+    response.print("  EDID product ID: %u\n", static_cast<unsigned>(display_.edidProductId));
 }
 
-int32_t OSVRTrackedDevice::GetInt32TrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError* error)
+void OSVRTrackedDevice::debugResetCounters(DebugResponse& response)
 {
-    const int32_t default_value = 0;
+    poseReportCount_.store(0, std::memory_order_relaxed);
+    velocityReportCount_.store(0, std::memory_order_relaxed);
+    latency_.reset();
+    response.print("counters reset\n");
+}
 
-    if (isWrongDataType(prop, int32_t())) {
-        if (error)
-            *error = vr::TrackedProp_WrongDataType;
-        return default_value;
+void OSVRTrackedDevice::debugGovernor(const DebugCommand& command, DebugResponse& response)
+{
+    if (command.is(1, "frame")) {
+        double milliseconds = 0.0;
+        if (!command.getNumber(2, milliseconds) || !(milliseconds > 0.0)) {
+            response.print("error: usage: governor frame <milliseconds>\n");
+            return;
+        }
+        if (!renderGovernorEnabled_) {
+            response.print("error: the render resolution governor is off; set renderGovernor to enable it\n");
+            return;
+        }
+        ReportFrameTime(milliseconds * 1e-3);
+    } else if (command.size() > 1) {
+        response.print("error: unknown governor request '%.*s'\n", command.getLength(1), command.getWord(1));
+        return;
     }
 
-    if (isWrongDeviceClass(prop, deviceClass_)) {
-        if (error)
-            *error = vr::TrackedProp_WrongDeviceClass;
-        return default_value;
+    std::lock_guard<std::mutex> governor_lock(renderGovernorMutex_);
+    response.print("governor: %s\n", renderGovernorEnabled_ ? "on" : "off");
+    response.print("  scale: %g (%g-%g)\n", renderGovernor_.getScale(), renderGovernor_.getMinScale(), renderGovernor_.getMaxScale());
+    response.print("  frame budget: %g ms\n", renderGovernor_.getTargetFrameTime() * 1e3);
+    response.print("  changes: %llu\n", static_cast<unsigned long long>(renderGovernor_.getChangeCount()));
+    response.print("  render target: %ux%u\n", static_cast<unsigned>(renderTargetWidth_.load()), static_cast<unsigned>(renderTargetHeight_.load()));
+}
+
+void OSVRTrackedDevice::debugStartup(DebugResponse& response) const
+{
+    if (startupPhases_.empty()) {
+        response.print("startup: not activated\n");
+        return;
     }
 
-    if (vr::TrackedDeviceClass_Invalid == deviceClass_) {
-        if (error)
-            *error = vr::TrackedProp_InvalidDevice;
-        return default_value;
+    double total = 0.0;
+    for (const auto& phase : startupPhases_) {
+        response.print("%s: %.3f ms, %llu updates%s\n", phase.name, phase.seconds * 1e3, static_cast<unsigned long long>(phase.updates), phase.ready ? "" : " (timed out)");
+        total += phase.seconds;
     }
+    response.print("total: %.3f ms (timeout %g s)\n", total * 1e3, std::chrono::duration<double>(startupTimeout_).count());
+}
 
-#include "ignore-warning/push"
-#include "ignore-warning/switch-enum"
+const PoseLatencyStats& OSVRTrackedDevice::GetLatencyStats() const
+{
+    return latency_;
+}
 
-    OSVR_LOG(trace) << "OSVRTrackedDevice::GetInt32TrackedDeviceProperty(): Requested property: " << prop << "\n";
+void OSVRTrackedDevice::ResetLatencyStats()
+{
+    latency_.reset();
+}
 
-    switch (prop) {
-    // General properties that apply to all device classes
-    case vr::Prop_DeviceClass_Int32:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return deviceClass_;
-    // Properties that are unique to TrackedDeviceClass_HMD
-    case vr::Prop_DisplayMCType_Int32:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_EdidVendorID_Int32:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return display_.edidVendorId;
-    case vr::Prop_EdidProductID_Int32:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return display_.edidProductId;
-    case vr::Prop_DisplayGCType_Int32:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_CameraCompatibilityMode_Int32:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    // Properties that are unique to TrackedDeviceClass_Controller
-    case vr::Prop_Axis0Type_Int32:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_Axis1Type_Int32:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_Axis2Type_Int32:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_Axis3Type_Int32:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_Axis4Type_Int32:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    }
+bool OSVRTrackedDevice::GetBoolTrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError* error)
+{
+    TrackedPropertyScalars value;
+    const auto result = getProperty(prop, TrackedPropertyType::Bool, value);
+    if (error)
+        *error = result;
+    return value.asBool;
+}
 
-#include "ignore-warning/pop"
+float OSVRTrackedDevice::GetFloatTrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError* error)
+{
+    TrackedPropertyScalars value;
+    const auto result = getProperty(prop, TrackedPropertyType::Float, value);
+    if (error)
+        *error = result;
+    return value.asFloat;
+}
 
-    OSVR_LOG(warn) << "OSVRTrackedDevice::GetInt32TrackedDeviceProperty(): Unknown property " << prop << " requested.\n";
+int32_t OSVRTrackedDevice::GetInt32TrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError* error)
+{
+    TrackedPropertyScalars value;
+    const auto result = getProperty(prop, TrackedPropertyType::Int32, value);
     if (error)
-        *error = vr::TrackedProp_UnknownProperty;
-    return default_value;
+        *error = result;
+    return value.asInt32;
 }
 
 uint64_t OSVRTrackedDevice::GetUint64TrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError* error)
 {
-    const uint64_t default_value = 0;
+    TrackedPropertyScalars value;
+    const auto result = getProperty(prop, TrackedPropertyType::Uint64, value);
+    if (error)
+        *error = result;
+    return value.asUint64;
+}
+
+vr::HmdMatrix34_t OSVRTrackedDevice::GetMatrix34TrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError* error)
+{
+    // Default value is identity matrix
+    TrackedPropertyScalars value;
+    const auto result = getProperty(prop, TrackedPropertyType::Matrix34, value);
+    if (error)
+        *error = result;
+    return value.asMatrix34;
+}
 
-    if (isWrongDataType(prop, uint64_t())) {
-        if (error)
-            *error = vr::TrackedProp_WrongDataType;
-        return default_value;
+uint32_t OSVRTrackedDevice::GetStringTrackedDeviceProperty(vr::ETrackedDeviceProperty prop, char *pchValue, uint32_t unBufferSize, vr::ETrackedPropertyError *pError)
+{
+    vr::ETrackedPropertyError result = vr::TrackedProp_Success;
+    uint32_t size = 0;
+    const auto info = findProperty(prop, TrackedPropertyType::String, result);
+    if (info) {
+        const auto snapshot = std::atomic_load(&propertySnapshot_);
+        if (snapshot && TrackedPropertyUpdate::Fixed == info->update) {
+            // Copy straight out of the snapshot
+            const auto& entry = snapshot->entries[getTrackedPropertyIndex(*info)];
+            result = entry.error;
+            if (vr::TrackedProp_Success == result) {
+                size = entry.stringSize;
+                if (size > unBufferSize || !pchValue) {
+                    result = vr::TrackedProp_BufferTooSmall;
+                } else {
+                    std::memcpy(pchValue, snapshot->strings.data() + entry.stringOffset, size);
+                }
+            }
+        } else {
+            TrackedPropertyValue value;
+            result = readProperty(*info, value);
+            if (vr::TrackedProp_Success == result) {
+                size = static_cast<uint32_t>(value.asString.size()) + 1;
+                if (size > unBufferSize || !pchValue) {
+                    result = vr::TrackedProp_BufferTooSmall;
+                } else {
+                    valveStrCpy(value.asString, pchValue, unBufferSize);
+                }
+            }
+        }
     }
 
-    if (isWrongDeviceClass(prop, deviceClass_)) {
-        if (error)
-            *error = vr::TrackedProp_WrongDeviceClass;
-        return default_value;
+    if (pError)
+        *pError = result;
+    return (vr::TrackedProp_Success == result || vr::TrackedProp_BufferTooSmall == result) ? size : 0;
+}
+
+    // ------------------------------------
+    // Private Methods
+    // ------------------------------------
+
+const TrackedPropertyInfo* OSVRTrackedDevice::findProperty(vr::ETrackedDeviceProperty prop, TrackedPropertyType type, vr::ETrackedPropertyError& error)
+{
+    const auto info = getTrackedPropertyInfo(prop);
+    if (!info) {
+        OSVR_LOG(warn) << "OSVRTrackedDevice::findProperty(): Unknown property " << prop << " requested.\n";
+        error = vr::TrackedProp_UnknownProperty;
+        return nullptr;
     }
 
-    if (vr::TrackedDeviceClass_Invalid == deviceClass_) {
-        if (error)
-            *error = vr::TrackedProp_InvalidDevice;
-        return default_value;
+    if (info->type != type) {
+        error = vr::TrackedProp_WrongDataType;
+        return nullptr;
     }
 
+    return info;
+}
+
+vr::ETrackedPropertyError OSVRTrackedDevice::getProperty(vr::ETrackedDeviceProperty prop, TrackedPropertyType type, TrackedPropertyScalars& value)
+{
+    vr::ETrackedPropertyError error = vr::TrackedProp_Success;
+    const auto info = findProperty(prop, type, error);
+    if (!info)
+        return error;
+
+    const auto snapshot = std::atomic_load(&propertySnapshot_);
+    if (snapshot && TrackedPropertyUpdate::Fixed == info->update) {
+        const auto& entry = snapshot->entries[getTrackedPropertyIndex(*info)];
+        value = entry.value;
+        return entry.error;
+    }
+
+    TrackedPropertyValue live_value;
+    error = readProperty(*info, live_value);
+    value = live_value;
+    return error;
+}
+
+vr::ETrackedPropertyError OSVRTrackedDevice::readProperty(const TrackedPropertyInfo& info, TrackedPropertyValue& value)
+{
+    if (!appliesTo(info.deviceClass, deviceClass_))
+        return vr::TrackedProp_WrongDeviceClass;
+
+    if (vr::TrackedDeviceClass_Invalid == deviceClass_)
+        return vr::TrackedProp_InvalidDevice;
+
+    OSVR_LOG(trace) << "OSVRTrackedDevice::readProperty(): Reading property: " << info.prop << "\n";
+
+    return getPropertyValue(info.prop, value);
+}
+
+vr::ETrackedPropertyError OSVRTrackedDevice::getPropertyValue(vr::ETrackedDeviceProperty prop, TrackedPropertyValue& value)
+{
 #include "ignore-warning/push"
 #include "ignore-warning/switch-enum"
 
-    OSVR_LOG(trace) << "OSVRTrackedDevice::GetUint64TrackedDeviceProperty(): Requested property: " << prop << "\n";
-
+    // One case per property in the list, each storing the value in the field
+    // for the property's type.
     switch (prop) {
-    // General properties that apply to all device classes
-    case vr::Prop_HardwareRevision_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_FirmwareVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_FPGAVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_VRCVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_RadioVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DongleVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    // Properties that are unique to TrackedDeviceClass_HMD
-    case vr::Prop_CurrentUniverseId_Uint64:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return 0;
-    case vr::Prop_PreviousUniverseId_Uint64:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return 0;
-    case vr::Prop_DisplayFirmwareVersion_Uint64:
-        /// @todo This really should be read from the server
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return 192;
-    case vr::Prop_CameraFirmwareVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayFPGAVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayBootloaderVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayHardwareVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_AudioFirmwareVersion_Uint64:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    // Properties that are unique to TrackedDeviceClass_Controller
-    case vr::Prop_SupportedButtons_Uint64: // TODO
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
+#define OSVR_PROPERTY_VALUE(NAME, TYPE, DEVICE_CLASS, UPDATE, VALUE) \
+    case vr::Prop_##NAME: \
+        return setPropertyValue(value.as##TYPE, VALUE);
+    OSVR_TRACKED_DEVICE_PROPERTIES(OSVR_PROPERTY_VALUE)
+#undef OSVR_PROPERTY_VALUE
     }
 
 #include "ignore-warning/pop"
 
-    OSVR_LOG(warn) << "OSVRTrackedDevice::GetUint64TrackedDeviceProperty(): Unknown property " << prop << " requested.\n";
-    if (error)
-        *error = vr::TrackedProp_UnknownProperty;
-    return default_value;
+    return vr::TrackedProp_UnknownProperty;
 }
 
-vr::HmdMatrix34_t OSVRTrackedDevice::GetMatrix34TrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError* error)
+void OSVRTrackedDevice::updatePropertySnapshot()
 {
-    // Default value is identity matrix
-    vr::HmdMatrix34_t default_value;
-    map(default_value) = Matrix34f::Identity();
+    auto snapshot = std::make_shared<TrackedPropertySnapshot>();
+    for (std::size_t i = 0; i < getTrackedPropertyCount(); ++i) {
+        const auto& info = getTrackedPropertyInfoAt(i);
+        if (TrackedPropertyUpdate::Live == info.update)
+            continue;
 
-    if (isWrongDataType(prop, vr::HmdMatrix34_t())) {
-        if (error)
-            *error = vr::TrackedProp_WrongDataType;
-        return default_value;
+        TrackedPropertyValue value;
+        auto& entry = snapshot->entries[i];
+        entry.error = readProperty(info, value);
+        entry.value = value;
+        if (TrackedPropertyType::String == info.type && vr::TrackedProp_Success == entry.error) {
+            entry.stringOffset = static_cast<uint32_t>(snapshot->strings.size());
+            entry.stringSize = static_cast<uint32_t>(value.asString.size()) + 1;
+            snapshot->strings.append(value.asString.c_str(), entry.stringSize);
+        }
     }
 
-    if (isWrongDeviceClass(prop, deviceClass_)) {
-        if (error)
-            *error = vr::TrackedProp_WrongDeviceClass;
-        return default_value;
+    const auto replaced = std::atomic_exchange(&propertySnapshot_, std::shared_ptr<const TrackedPropertySnapshot>(std::move(snapshot)));
+    if (replaced && driver_host_ && vr::k_unTrackedDeviceIndexInvalid != objectId_) {
+        driver_host_->TrackedDevicePropertiesChanged(objectId_);
     }
+}
 
-    if (vr::TrackedDeviceClass_Invalid == deviceClass_) {
-        if (error)
-            *error = vr::TrackedProp_InvalidDevice;
-        return default_value;
-    }
+void OSVRTrackedDevice::updateDisplaySnapshot()
+{
+    auto snapshot = std::make_shared<const DisplaySnapshot>(makeDisplaySnapshot(m_DisplayConfig));
+    std::atomic_store(&displaySnapshot_, std::shared_ptr<const DisplaySnapshot>(std::move(snapshot)));
+}
 
-#include "ignore-warning/push"
-#include "ignore-warning/switch-enum"
+std::shared_ptr<const DisplaySnapshot> OSVRTrackedDevice::getDisplaySnapshot() const
+{
+    auto snapshot = std::atomic_load(&displaySnapshot_);
+    if (snapshot)
+        return snapshot;
 
-    OSVR_LOG(trace) << "OSVRTrackedDevice::GetMatrix34TrackedDeviceProperty(): Requested property: " << prop << "\n";
+    static const auto empty_snapshot = std::make_shared<const DisplaySnapshot>();
+    return empty_snapshot;
+}
 
-    switch (prop) {
-    // General properties that apply to all device classes
-    case vr::Prop_StatusDisplayTransform_Matrix34:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    // Properties that are unique to TrackedDeviceClass_HMD
-    case vr::Prop_CameraToHeadTransform_Matrix34:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
+void OSVRTrackedDevice::updateDistortion(const std::string& display_descriptor, const std::string& render_manager_config)
+{
+    // Built aside and swapped in whole, so ComputeDistortion() on another
+    // thread sees either the old model and grids or the new ones.
+    auto distortion = std::make_shared<DistortionState>();
+    const auto publish = [&] { std::atomic_store(&distortion_, std::shared_ptr<const DistortionState>(std::move(distortion))); };
+
+    try {
+        distortion->model = osvr::distortion::DistortionModel::fromDisplayDescriptor(display_descriptor);
+    } catch (const std::exception& e) {
+        OSVR_LOG(err) << "OSVRTrackedDevice::updateDistortion(): Ignoring the display descriptor's distortion: " << e.what() << "\n";
+    }
+    if (distortion->model.isIdentity()) {
+        publish();
+        return;
     }
 
-#include "ignore-warning/pop"
+    const auto start = std::chrono::steady_clock::now();
+    osvr::distortion::DistortionCache cache(distortionCachePath_);
+    const uint64_t key = osvr::distortion::DistortionCache::computeKey(display_descriptor, render_manager_config, distortionGridSize_);
+    if (!distortionCachePath_.empty()) {
+        auto grids = cache.load(key);
+        if (2 == grids.size()) {
+            for (int eye = 0; eye < 2; ++eye) {
+                distortion->grids[eye] = std::make_unique<const osvr::distortion::DistortionGrid>(std::move(grids[eye]));
+            }
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            OSVR_LOG(info) << "Mapped distortion grids from " << distortionCachePath_ << " in " << elapsed * 1e3 << " ms.";
+            publish();
+            return;
+        }
+        OSVR_LOG(trace) << "OSVRTrackedDevice::updateDistortion(): Not using the distortion cache: " << cache.getError() << "\n";
+    }
 
-    OSVR_LOG(warn) << "OSVRTrackedDevice::GetMatrix34TrackedDeviceProperty(): Unknown property " << prop << " requested.\n";
-    if (error)
-        *error = vr::TrackedProp_UnknownProperty;
-    return default_value;
+    for (int eye = 0; eye < 2; ++eye) {
+        distortion->grids[eye] = std::make_unique<const osvr::distortion::DistortionGrid>(distortion->model, eye, distortionGridSize_);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    OSVR_LOG(info) << "Baked " << distortionGridSize_ << "x" << distortionGridSize_ << " distortion grids in " << elapsed * 1e3 << " ms.";
+
+    if (!distortionCachePath_.empty() && !cache.store(key, {distortion->grids[0].get(), distortion->grids[1].get()})) {
+        OSVR_LOG(warn) << "OSVRTrackedDevice::updateDistortion(): Unable to save the distortion grids: " << cache.getError() << "\n";
+    }
+    publish();
 }
 
-uint32_t OSVRTrackedDevice::GetStringTrackedDeviceProperty(vr::ETrackedDeviceProperty prop, char *pchValue, uint32_t unBufferSize, vr::ETrackedPropertyError *pError)
+std::shared_ptr<const OSVRTrackedDevice::DistortionState> OSVRTrackedDevice::getDistortion() const
 {
-    uint32_t default_value = 0;
-    if (isWrongDataType(prop, pchValue)) {
-        if (pError)
-            *pError = vr::TrackedProp_WrongDataType;
-        return default_value;
-    }
+    return std::atomic_load(&distortion_);
+}
 
-    if (isWrongDeviceClass(prop, deviceClass_)) {
-        if (pError)
-            *pError = vr::TrackedProp_WrongDeviceClass;
-        return default_value;
+void OSVRTrackedDevice::updateRenderTargetSize()
+{
+    // Render enough pixels for either eye to get one per screen pixel at
+    // the center of its lens; toward the edges the lens spreads them out.
+    const auto distortion = getDistortion();
+    double width = 0.0;
+    double height = 0.0;
+    for (int eye = 0; eye < 2; ++eye) {
+        uint32_t x, y, w, h;
+        GetEyeOutputViewport(static_cast<vr::EVREye>(eye), &x, &y, &w, &h);
+        const auto scale = osvr::distortion::computeCenterRenderScale(distortion->model, eye, w, h);
+        width = std::max(width, w * scale.x);
+        height = std::max(height, h * scale.y);
+        OSVR_LOG(trace) << "OSVRTrackedDevice::updateRenderTargetSize(): Eye " << eye << " is " << w << "x" << h << " and needs " << scale.x << "x" << scale.y << " that at its lens center.\n";
     }
 
-    if (vr::TrackedDeviceClass_Invalid == deviceClass_) {
-        if (pError)
-            *pError = vr::TrackedProp_InvalidDevice;
-        return default_value;
+    renderTargetBaseWidth_ = width * renderQuality_;
+    renderTargetBaseHeight_ = height * renderQuality_;
+
+    double scale = 1.0;
+    if (renderGovernorEnabled_) {
+        std::lock_guard<std::mutex> governor_lock(renderGovernorMutex_);
+        scale = renderGovernor_.getScale();
     }
+    applyRenderScale(scale);
+    OSVR_LOG(info) << "OSVRTrackedDevice::updateRenderTargetSize(): Recommending " << renderTargetWidth_.load() << "x" << renderTargetHeight_.load() << " render targets (quality " << renderQuality_ << ").\n";
+}
 
-    OSVR_LOG(trace) << "OSVRTrackedDevice::GetStringTrackedDeviceProperty(): Requested property: " << prop << "\n";
+void OSVRTrackedDevice::applyRenderScale(double scale)
+{
+    // Round up, but not for the last bits of floating point error
+    renderTargetWidth_ = static_cast<uint32_t>(std::ceil(renderTargetBaseWidth_.load() * scale - 1e-6));
+    renderTargetHeight_ = static_cast<uint32_t>(std::ceil(renderTargetBaseHeight_.load() * scale - 1e-6));
+}
 
-    std::string sValue = GetStringTrackedDeviceProperty(prop, pError);
-    if (*pError == vr::TrackedProp_Success) {
-        if (sValue.size() + 1 > unBufferSize) {
-            *pError = vr::TrackedProp_BufferTooSmall;
-        } else {
-            valveStrCpy(sValue, pchValue, unBufferSize);
-        }
-        return static_cast<uint32_t>(sValue.size()) + 1;
+void OSVRTrackedDevice::ReportFrameTime(double seconds)
+{
+    if (!renderGovernorEnabled_)
+        return;
+
+    double scale = 1.0;
+    {
+        std::lock_guard<std::mutex> governor_lock(renderGovernorMutex_);
+        if (!renderGovernor_.addFrameTime(seconds))
+            return;
+        scale = renderGovernor_.getScale();
     }
 
-    return 0;
+    // Only applications that ask again see the new size
+    applyRenderScale(scale);
+    OSVR_LOG(info) << "OSVRTrackedDevice::ReportFrameTime(): Render scale now " << scale << ", recommending " << renderTargetWidth_.load() << "x" << renderTargetHeight_.load() << " render targets.\n";
 }
 
-    // ------------------------------------
-    // Private Methods
-    // ------------------------------------
-
-std::string OSVRTrackedDevice::GetStringTrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError *error)
+void OSVRTrackedDevice::CheckDisplayConfig()
 {
-    std::string default_value = "";
+    if (vr::k_unTrackedDeviceIndexInvalid == objectId_)
+        return;
 
-#include "ignore-warning/push"
-#include "ignore-warning/switch-enum"
+    const auto now = std::chrono::steady_clock::now();
+    if (now < nextDisplayCheck_)
+        return;
+    nextDisplayCheck_ = now + displayCheckInterval_;
+
+    std::string descriptor;
+    {
+        auto context_lock = lockContext();
+        descriptor = m_Context.getStringParameter("/display");
+        if (descriptor == displayDescriptor_) {
+            pendingDisplayConfig_ = osvr::clientkit::DisplayConfig();
+            return;
+        }
 
-    switch (prop) {
-    // General properties that apply to all device classes
-    case vr::Prop_TrackingSystemName_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_ModelNumber_String:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return "OSVR HMD";
-    case vr::Prop_SerialNumber_String:
-        if (error)
-            *error = vr::TrackedProp_Success;
-        return this->GetId();
-    case vr::Prop_RenderModelName_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_ManufacturerName_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_TrackingFirmwareVersion_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_HardwareRevision_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_AllWirelessDongleDescriptions_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_ConnectedWirelessDongle_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_Firmware_ManualUpdateURL_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_Firmware_ProgrammingTarget_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DriverVersion_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-
-    // Properties that are unique to TrackedDeviceClass_HMD
-    case vr::Prop_DisplayMCImageLeft_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayMCImageRight_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_DisplayGCImage_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-    case vr::Prop_CameraFirmwareDescription_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-
-    // Properties that are unique to TrackedDeviceClass_Controller
-    case vr::Prop_AttachedDeviceId_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
-
-    // Properties that are unique to TrackedDeviceClass_TrackingReference
-    case vr::Prop_ModeLabel_String:
-        if (error)
-            *error = vr::TrackedProp_ValueNotProvidedByDevice;
-        return default_value;
+        // The new configuration needs a few context updates to start up;
+        // keep it until it has.
+        if (!pendingDisplayConfig_.valid())
+            pendingDisplayConfig_ = osvr::clientkit::DisplayConfig(m_Context);
+        if (!pendingDisplayConfig_.checkStartup())
+            return;
+
+        const auto viewer = pendingDisplayConfig_.getViewer(0);
+        if (pendingDisplayConfig_.getNumViewers() < 1 || viewer.getNumEyes() < 2 || viewer.getEye(0).getNumSurfaces() < 1 || viewer.getEye(1).getNumSurfaces() < 1) {
+            OSVR_LOG(err) << "OSVRTrackedDevice::CheckDisplayConfig(): The new display configuration needs two eyes with a surface each; keeping the old one.\n";
+            displayDescriptor_ = descriptor;
+            pendingDisplayConfig_ = osvr::clientkit::DisplayConfig();
+            return;
+        }
 
+        m_DisplayConfig = pendingDisplayConfig_;
+        pendingDisplayConfig_ = osvr::clientkit::DisplayConfig();
+        displayDescriptor_ = descriptor;
+        updateDisplaySnapshot();
     }
 
-#include "ignore-warning/pop"
+    OSVR_LOG(info) << "OSVRTrackedDevice::CheckDisplayConfig(): The display configuration changed; updating.\n";
+    updateDistortion(descriptor, renderManagerConfigString_);
+    updateRenderTargetSize();
+    updatePropertySnapshot();
+}
 
-    OSVR_LOG(warn) << "OSVRTrackedDevice::GetStringTrackedDeviceProperty(): Unknown property " << prop << " requested.\n";
-    if (error)
-        *error = vr::TrackedProp_UnknownProperty;
-    return default_value;
+void OSVRTrackedDevice::InjectPoseReport(const OSVR_TimeValue& timestamp, const OSVR_PoseReport& report)
+{
+    HmdTrackerCallback(this, &timestamp, &report);
 }
 
 void OSVRTrackedDevice::HmdTrackerCallback(void* userdata, const OSVR_TimeValue* timestamp, const OSVR_PoseReport* report)
@@ -873,52 +1048,80 @@ void OSVRTrackedDevice::HmdTrackerCallback(void* userdata, const OSVR_TimeValue*
 
     auto* self = static_cast<OSVRTrackedDevice*>(userdata);
 
-    vr::DriverPose_t pose;
-    pose.poseTimeOffset = 0; // close enough
-
-    Eigen::Vector3d::Map(pose.vecWorldFromDriverTranslation) = Eigen::Vector3d::Zero();
-    Eigen::Vector3d::Map(pose.vecDriverFromHeadTranslation) = Eigen::Vector3d::Zero();
-
-    map(pose.qWorldFromDriverRotation) = Eigen::Quaterniond::Identity();
-
-    map(pose.qDriverFromHeadRotation) = Eigen::Quaterniond::Identity();
-
-    // Position
-    Eigen::Vector3d::Map(pose.vecPosition) = osvr::util::vecMap(report->pose.translation);
-
-    // Position velocity and acceleration are not currently consistently provided
-    Eigen::Vector3d::Map(pose.vecVelocity) = Eigen::Vector3d::Zero();
-    Eigen::Vector3d::Map(pose.vecAcceleration) = Eigen::Vector3d::Zero();
+    // Read both clocks back-to-back to keep the OSVR-to-host mapping current,
+    // then express the report's age on the host's clock. The first reading
+    // also marks when the report reached us, for the latency stats.
+    const double host_before = ClockBridge::hostNow();
+    OSVR_TimeValue osvr_now;
+    osvrTimeValueGetNow(&osvr_now);
+    const double host_now = ClockBridge::hostNow();
+    self->clockBridge_.addSample(toSeconds(osvr_now), 0.5 * (host_before + host_now), host_now - host_before);
+    const double pose_time = self->clockBridge_.toHostTime(toSeconds(*timestamp));
+
+    Eigen::Vector3d position = osvr::util::vecMap(report->pose.translation);
+    Eigen::Quaterniond orientation = osvr::util::fromQuat(report->pose.rotation);
+    self->poseReportCount_.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> filters_lock(self->poseFiltersMutex_);
+        self->poseFilters_.filter(toSeconds(*timestamp), position, orientation);
+    }
+    self->poseHistory_.add(pose_time, position, orientation);
+
+    // Estimate velocities from successive poses, but prefer the ones the
+    // tracker reports itself whenever they're current.
+    self->velocityEstimator_.addSample(toSeconds(*timestamp), position, orientation);
+    Eigen::Vector3d velocity = self->velocityEstimator_.getLinearVelocity();
+    Eigen::Vector3d angular_velocity = self->velocityEstimator_.getAngularVelocity();
+    if (self->haveVelocityReport_ && std::abs(osvrTimeValueDurationSeconds(timestamp, &self->lastVelocityReportTime_)) < MaxVelocityReportAge) {
+        const auto& state = self->lastVelocityReport_;
+        if (state.linearVelocityValid) {
+            velocity = osvr::util::vecMap(state.linearVelocity);
+        }
+        if (state.angularVelocityValid && state.angularVelocity.dt > 0.0) {
+            const Eigen::AngleAxisd increment(osvr::util::fromQuat(state.angularVelocity.incrementalRotation));
+            angular_velocity = increment.axis() * (increment.angle() / state.angularVelocity.dt);
+        }
+    }
 
-    // Orientation
-    map(pose.qRotation) = osvr::util::fromQuat(report->pose.rotation);
+    const auto pose = makeDriverPose(pose_time - host_now, position, orientation, velocity, angular_velocity);
+    self->pose_.publish(pose);
+    self->poseRecorder_.record(makePoseRecord(*timestamp, *report, host_now, pose));
+    self->driver_host_->TrackedDevicePoseUpdated(0, pose); /// @fixme figure out ID correctly, don't hardcode to zero
 
-    // Angular velocity and acceleration are not currently consistently provided
-    Eigen::Vector3d::Map(pose.vecAngularVelocity) = Eigen::Vector3d::Zero();
-    Eigen::Vector3d::Map(pose.vecAngularAcceleration) = Eigen::Vector3d::Zero();
+    const double host_done = ClockBridge::hostNow();
+    self->latency_.reportToCallback.record(host_before - pose_time);
+    self->latency_.callbackToHost.record(host_done - host_before);
+    self->latency_.reportToHost.record(host_done - pose_time);
+}
 
-    pose.result = vr::TrackingResult_Running_OK;
-    pose.poseIsValid = true;
-    pose.willDriftInYaw = true;
-    pose.shouldApplyHeadModel = true;
+void OSVRTrackedDevice::HmdVelocityCallback(void* userdata, const OSVR_TimeValue* timestamp, const OSVR_VelocityReport* report)
+{
+    if (!userdata)
+        return;
 
-    self->pose_ = pose;
-    self->driver_host_->TrackedDevicePoseUpdated(0, self->pose_); /// @fixme figure out ID correctly, don't hardcode to zero
+    auto* self = static_cast<OSVRTrackedDevice*>(userdata);
+    self->lastVelocityReport_ = report->state;
+    self->lastVelocityReportTime_ = *timestamp;
+    self->haveVelocityReport_ = true;
+    self->velocityReportCount_.fetch_add(1, std::memory_order_relaxed);
 }
 
 float OSVRTrackedDevice::GetIPD()
 {
-    OSVR_Pose3 leftEye, rightEye;
-
-    if (m_DisplayConfig.getViewer(0).getEye(0).getPose(leftEye) != true) {
-        OSVR_LOG(err) << "OSVRTrackedDevice::GetHeadFromEyePose(): Unable to get left eye pose!\n";
+    const auto snapshot = getDisplaySnapshot();
+    if (!snapshot->eyes[0].hasPose || !snapshot->eyes[1].hasPose) {
+        OSVR_LOG(err) << "OSVRTrackedDevice::GetIPD(): Unable to get the eye poses!\n";
     }
 
-    if (m_DisplayConfig.getViewer(0).getEye(1).getPose(rightEye) != true) {
-        OSVR_LOG(err) << "OSVRTrackedDevice::GetHeadFromEyePose(): Unable to get right eye pose!\n";
-    }
+    return snapshot->ipd;
+}
 
-    return (osvr::util::vecMap(leftEye.translation) - osvr::util::vecMap(rightEye.translation)).norm();
+std::unique_lock<std::mutex> OSVRTrackedDevice::lockContext()
+{
+    if (!contextMutex_)
+        return std::unique_lock<std::mutex>();
+
+    return std::unique_lock<std::mutex>(*contextMutex_);
 }
 
 const char* OSVRTrackedDevice::GetId()
@@ -938,26 +1141,116 @@ void OSVRTrackedDevice::configure()
         Logging::instance().setLogLevel(info);
     }
 
-    // The name of the display we want to use
-    const std::string display_name = settings_->getSetting<std::string>("displayName", "OSVR");
+    // Points per side of the grids distortion is baked into on activation.
+    // More points follow the lens more closely; SteamVR only samples a
+    // coarse mesh, so the default is plenty.
+    const int32_t distortion_grid_size = settings_->getSetting<int32_t>("distortionGridSize", 65);
+    distortionGridSize_ = static_cast<std::size_t>(std::min(std::max(distortion_grid_size, 2), 1025));
+
+    // Multiplies the recommended render target size, which otherwise gives
+    // one rendered pixel per screen pixel at the center of each lens.
+    const float render_quality = settings_->getSetting<float>("renderQuality", 1.0f);
+    renderQuality_ = std::min(std::max(static_cast<double>(render_quality), 0.1), 4.0);
+
+    // How long Activate() waits for the server, in seconds
+    const auto startup_timeout = std::max(settings_->getSetting<float>("startupTimeout", 10.0f), 0.0f);
+    startupTimeout_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(startup_timeout));
+
+    // How often to look for a new display configuration from the server, in
+    // seconds
+    const auto display_check_interval = std::max(settings_->getSetting<float>("displayCheckInterval", 1.0f), 0.0f);
+    displayCheckInterval_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(display_check_interval));
+
+    // Optionally shrink the render target while frames run late, down to
+    // renderGovernorMinScale of its size, and grow it back when they don't.
+    // Frames are budgeted renderGovernorFrameTime milliseconds, or one
+    // refresh interval if that's 0.
+    renderGovernorEnabled_ = settings_->getSetting<bool>("renderGovernor", false);
+    renderGovernorFrameTime_ = std::max(settings_->getSetting<float>("renderGovernorFrameTime", 0.0f), 0.0f) * 1e-3;
+    {
+        std::lock_guard<std::mutex> governor_lock(renderGovernorMutex_);
+        renderGovernor_.setBounds(settings_->getSetting<float>("renderGovernorMinScale", 0.5f), settings_->getSetting<float>("renderGovernorMaxScale", 1.0f));
+    }
 
+    // Whether to keep baked grids in the driver's config directory so later
+    // runs can map them instead of baking them again.
+    const bool distortion_cache = settings_->getSetting<bool>("distortionCache", true);
+    distortionCachePath_.clear();
+    if (distortion_cache && !userDriverConfigDir_.empty()) {
+        distortionCachePath_ = userDriverConfigDir_ + OSVR_PATH_SEPARATOR + "distortion_grids.bin";
+    }
 
-    // Detect displays and find the one we're using as an HMD
-    bool display_found = false;
-    auto displays = osvr::display::getDisplays();
-    for (const auto& display : displays) {
-        if (std::string::npos == display.name.find(display_name))
-            continue;
+    // How strongly to smooth velocities estimated from successive poses
+    velocityEstimator_.setSmoothing(settings_->getSetting<float>("velocitySmoothing", 0.5f));
 
-        display_ = display;
-        display_found = true;
-        break;
+    // Filters to smooth poses with, applied in order (e.g., "oneEuro,kalman").
+    // Each filter's parameters are read from settings named after the filter
+    // and the parameter, such as "oneEuroMinCutoff".
+    const std::string pose_filters = settings_->getSetting<std::string>("poseFilters", "");
+    const std::string unknown_filters = poseFilters_.setStages(pose_filters);
+    if (!unknown_filters.empty()) {
+        OSVR_LOG(warn) << "OSVRTrackedDevice::configure(): Ignoring unknown pose filters: " << unknown_filters << "\n";
+    }
+    for (std::size_t i = 0; i < poseFilters_.size(); ++i) {
+        auto& stage = poseFilters_.getStage(i);
+        for (std::size_t j = 0; j < stage.getParameterCount(); ++j) {
+            std::string key = stage.getParameterName(j);
+            key[0] = static_cast<char>(std::toupper(key[0]));
+            key = stage.getName() + key;
+            stage.setParameter(j, settings_->getSetting<float>(key, static_cast<float>(stage.getParameter(j))));
+        }
+        stage.reset();
+        OSVR_LOG(info) << "Pose filter " << i << ": " << stage.getName();
+    }
+
+    // Capture every tracker report and the pose made from it to this file
+    const std::string recording_path = settings_->getSetting<std::string>("poseRecordingPath", "");
+    if (!recording_path.empty()) {
+        // Room for six minutes of reports at 1 kHz (about 130 MB) by default
+        const int32_t recording_capacity = settings_->getSetting<int32_t>("poseRecordingCapacity", 360000);
+        if (poseRecorder_.open(recording_path, static_cast<std::size_t>(std::max(recording_capacity, 1)), ClockBridge::hostNow())) {
+            OSVR_LOG(info) << "Recording poses to " << recording_path << " (room for " << poseRecorder_.getCapacity() << " reports).";
+        } else {
+            OSVR_LOG(err) << "OSVRTrackedDevice::configure(): Unable to record poses: " << poseRecorder_.getError() << "\n";
+        }
+    }
+
+    // How to recognize the display we want to use: EDID IDs as
+    // "vendor:product[:serial]" (the default is the OSVR HDK), the connector
+    // it's plugged into, and its name, which may use * and ? wildcards. The
+    // priority setting says which of these to try first.
+    const std::string display_edids = settings_->getSetting<std::string>("displayEdid", "53838:4121");
+    const std::string unknown_edids = displaySelector_.setEdids(display_edids);
+    if (!unknown_edids.empty()) {
+        OSVR_LOG(warn) << "OSVRTrackedDevice::configure(): Ignoring unreadable display EDIDs: " << unknown_edids << "\n";
+    }
+    displaySelector_.setConnector(settings_->getSetting<std::string>("displayConnector", ""));
+    displaySelector_.setNamePattern(settings_->getSetting<std::string>("displayName", "OSVR"));
+    const std::string display_priority = settings_->getSetting<std::string>("displayPriority", "edid,connector,name");
+    const std::string unknown_criteria = displaySelector_.setPriority(display_priority);
+    if (!unknown_criteria.empty()) {
+        OSVR_LOG(warn) << "OSVRTrackedDevice::configure(): Ignoring unknown display criteria: " << unknown_criteria << "\n";
+    }
+
+    // Detect displays and find the one we're using as an HMD
+    uint64_t display_generation = 0;
+    const auto displays = osvr::display::DisplayMonitor::instance().getDisplays(&display_generation);
+    const int display_index = displaySelector_.select(displays, display_generation);
+    const bool display_found = (display_index >= 0);
+    if (display_found) {
+        display_ = displays[display_index];
+        if (!(display_.verticalRefreshRate > 0.0)) {
+            // The OSVR HDK's rate, as below
+            OSVR_LOG(warn) << "OSVRTrackedDevice::configure(): The display's refresh rate isn't known; assuming 60 Hz.\n";
+            display_.verticalRefreshRate = 60.0;
+        }
     }
 
     if (!display_found) {
         // Default to OSVR HDK display settings
         display_.adapter.description = "Unknown";
         display_.name = "OSVR HDK";
+        display_.connector.clear();
         display_.size.width = 1920;
         display_.size.height = 1080;
         display_.position.x = 1920;
@@ -967,15 +1260,19 @@ void OSVRTrackedDevice::configure()
         display_.attachedToDesktop = true;
         display_.edidVendorId = 53838;
         display_.edidProductId = 4121;
+        display_.edidSerialNumber = 0;
     }
 
     if (display_found) {
-        OSVR_LOG(info) << "Detected display named [" << display_.name << "]:";
+        OSVR_LOG(info) << "Detected display named [" << display_.name << "] by " << osvr::display::DisplaySelector::getName(displaySelector_.getMatchedCriterion()) << ":";
     } else {
         OSVR_LOG(info) << "Default display:";
     }
     OSVR_LOG(info) << "  Adapter: " << display_.adapter.description;
     OSVR_LOG(info) << "  Monitor name: " << display_.name;
+    if (!display_.connector.empty()) {
+        OSVR_LOG(info) << "  Connector: " << display_.connector;
+    }
     OSVR_LOG(info) << "  Resolution: " << display_.size.width << "x" << display_.size.height;
     OSVR_LOG(info) << "  Position: (" << display_.position.x << ", " << display_.position.y << ")";
     switch (display_.rotation) {
@@ -999,5 +1296,6 @@ void OSVRTrackedDevice::configure()
     OSVR_LOG(info) << "  " << (display_.attachedToDesktop ? "Extended mode" : "Direct mode");
     OSVR_LOG(info) << "  EDID vendor ID: " << display_.edidVendorId;
     OSVR_LOG(info) << "  EDID product ID: " << display_.edidProductId;
+    OSVR_LOG(info) << "  EDID serial number: " << display_.edidSerialNumber;
 }
 
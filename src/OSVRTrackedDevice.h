@@ -27,8 +27,23 @@
 
 // Internal Includes
 #include "osvr_compiler_detection.h"    // for OSVR_OVERRIDE
+#include "ClockBridge.h"
+#include "DebugCommand.h"
+#include "DisplaySnapshot.h"
+#include "LatencyHistogram.h"
+#include "PoseFilter.h"
+#include "PoseHistory.h"
+#include "RenderResolutionGovernor.h"
 #include "Settings.h"
+#include "StartupWait.h"
+#include "TripleBuffer.h"
+#include "VelocityEstimator.h"
+#include "osvr_device_properties.h"
 #include "display/Display.h"
+#include "display/DisplaySelector.h"
+#include "distortion/DistortionGrid.h"
+#include "distortion/DistortionModel.h"
+#include "recording/PoseRecorder.h"
 
 // OpenVR includes
 #include <openvr_driver.h>
@@ -36,15 +51,25 @@
 // Library/third-party includes
 #include <osvr/ClientKit/Display.h>
 #include <osvr/Client/RenderManagerConfig.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValueC.h>
 
 // Standard includes
+#include <atomic>
+#include <chrono>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 class OSVRTrackedDevice : public vr::ITrackedDeviceServerDriver, public vr::IVRDisplayComponent {
 friend class ServerDriver_OSVR;
 public:
-    OSVRTrackedDevice(const std::string& display_description, osvr::clientkit::ClientContext& context, vr::IServerDriverHost* driver_host, vr::IDriverLog* driver_log = nullptr);
+    /**
+     * Baked distortion grids are cached in @p user_driver_config_dir, if
+     * given, so later runs with the same configuration needn't bake them.
+     */
+    OSVRTrackedDevice(const std::string& display_description, osvr::clientkit::ClientContext& context, vr::IServerDriverHost* driver_host, vr::IDriverLog* driver_log = nullptr, const std::string& user_driver_config_dir = "");
 
     virtual ~OSVRTrackedDevice();
     // ------------------------------------
@@ -84,6 +109,8 @@ public:
      * requests is entirely up to the driver and the client to figure out, as is
      * the format of the response. Responses that exceed the length of the
      * supplied buffer should be truncated and null terminated.
+     *
+     * Send "help" for the list of requests we understand.
      */
     virtual void DebugRequest(const char* request, char* response_buffer, uint32_t response_buffer_size) OSVR_OVERRIDE;
 
@@ -136,6 +163,61 @@ public:
     // ------------------------------------
     virtual vr::DriverPose_t GetPose() OSVR_OVERRIDE;
 
+    /**
+     * Number of recent poses kept for GetPoseAtTime().
+     */
+    typedef PoseHistory<256> PoseHistoryType;
+
+    /**
+     * Computes the pose at @p host_time, a time on the ClockBridge::hostNow()
+     * clock, from the recently reported poses: interpolated between reports
+     * or extrapolated by up to @p max_extrapolation seconds past the newest
+     * one. Safe to call from any thread.
+     *
+     * @return false if @p host_time is older than the retained history.
+     */
+    bool GetPoseAtTime(double host_time, vr::DriverPose_t& pose, double max_extrapolation = 0.05) const;
+
+    /**
+     * Returns the recently reported poses, timestamped on the
+     * ClockBridge::hostNow() clock.
+     */
+    const PoseHistoryType& GetPoseHistory() const;
+
+    /**
+     * Returns how long poses take to get from the tracker to the host, stage
+     * by stage. Safe to read from any thread while poses are arriving.
+     */
+    const PoseLatencyStats& GetLatencyStats() const;
+
+    /**
+     * Forgets the latencies measured so far. Safe to call from any thread.
+     */
+    void ResetLatencyStats();
+
+    /**
+     * Processes a pose report exactly as if the tracker had delivered it,
+     * for replaying captured sessions without an OSVR server. Don't mix
+     * with live reports: call it only while the device isn't activated.
+     */
+    void InjectPoseReport(const OSVR_TimeValue& timestamp, const OSVR_PoseReport& report);
+
+    /**
+     * Tells the render resolution governor, if it's enabled, how long a
+     * frame took to render, in seconds. OpenVR doesn't pass drivers frame
+     * timing, so this is fed from the "governor frame" debug request or by
+     * whoever embeds the driver. Safe to call from any thread.
+     */
+    void ReportFrameTime(double seconds);
+
+    /**
+     * Takes a new display snapshot and rebuilds the distortion if the
+     * server's display descriptor has changed, telling the host the
+     * properties changed. Checks at most once per displayCheckInterval;
+     * ServerDriver_OSVR calls it from RunFrame().
+     */
+    void CheckDisplayConfig();
+
     // ------------------------------------
     // Property Methods
     // ------------------------------------
@@ -185,7 +267,83 @@ protected:
     const char* GetId();
 
 private:
-    std::string GetStringTrackedDeviceProperty(vr::ETrackedDeviceProperty prop, vr::ETrackedPropertyError *error);
+    /**
+     * Looks up property @p prop, checking it's of type @p type.
+     *
+     * @return nullptr, with @p error set, if it isn't.
+     */
+    static const TrackedPropertyInfo* findProperty(vr::ETrackedDeviceProperty prop, TrackedPropertyType type, vr::ETrackedPropertyError& error);
+
+    /**
+     * Reads a non-string property of type @p type from the snapshot, or
+     * works it out if it's Live or there's no snapshot yet.
+     */
+    vr::ETrackedPropertyError getProperty(vr::ETrackedDeviceProperty prop, TrackedPropertyType type, TrackedPropertyScalars& value);
+
+    /**
+     * Works out the value of property @p info, having checked it applies to
+     * this device.
+     */
+    vr::ETrackedPropertyError readProperty(const TrackedPropertyInfo& info, TrackedPropertyValue& value);
+
+    /**
+     * Reads property @p prop into the field of @p value for its type.
+     */
+    vr::ETrackedPropertyError getPropertyValue(vr::ETrackedDeviceProperty prop, TrackedPropertyValue& value);
+
+    /**
+     * Reads every Fixed property into a new snapshot and swaps it in, telling
+     * the host if this replaces an earlier one. Call this whenever anything
+     * the Fixed properties depend on changes.
+     */
+    void updatePropertySnapshot();
+
+    /**
+     * Copies the eyes' projections, viewports and poses out of
+     * m_DisplayConfig into a new display snapshot and swaps it in.
+     */
+    void updateDisplaySnapshot();
+
+    /**
+     * The display snapshot taken on activation or since, or an empty one
+     * before that. Safe to call from any thread.
+     */
+    std::shared_ptr<const DisplaySnapshot> getDisplaySnapshot() const;
+
+    /**
+     * The distortion model read from a display descriptor and the grids
+     * baked from it, replaced together when the descriptor changes.
+     */
+    struct DistortionState {
+        osvr::distortion::DistortionModel model;
+        std::unique_ptr<const osvr::distortion::DistortionGrid> grids[2]; ///< null until baked; ComputeDistortion() evaluates model until then
+    };
+
+    /**
+     * Reads the distortion from @p display_descriptor and bakes it into a
+     * grid for each eye, so that ComputeDistortion() only has to
+     * interpolate, then swaps the result in. The grids are mapped from the
+     * distortion cache instead when it holds ones baked from the same
+     * display descriptor and @p render_manager_config.
+     */
+    void updateDistortion(const std::string& display_descriptor, const std::string& render_manager_config);
+
+    /**
+     * The distortion swapped in last. Safe to call from any thread.
+     */
+    std::shared_ptr<const DistortionState> getDistortion() const;
+
+    /**
+     * Works out the render target size GetRecommendedRenderTargetSize()
+     * gives from each eye's viewport and the distortion at its lens center.
+     */
+    void updateRenderTargetSize();
+
+    /**
+     * Scales the size updateRenderTargetSize() worked out by @p scale, for
+     * GetRecommendedRenderTargetSize() to return.
+     */
+    void applyRenderScale(double scale);
 
     /**
      * Callback function which is called whenever new data has been received
@@ -193,6 +351,13 @@ private:
      */
     static void HmdTrackerCallback(void* userdata, const OSVR_TimeValue* timestamp, const OSVR_PoseReport* report);
 
+    /**
+     * Callback function which is called whenever the tracker reports its
+     * velocity. When these arrive they're used in place of the velocities
+     * estimated from successive poses.
+     */
+    static void HmdVelocityCallback(void* userdata, const OSVR_TimeValue* timestamp, const OSVR_VelocityReport* report);
+
     float GetIPD();
 
     /**
@@ -200,18 +365,76 @@ private:
      */
     void configure();
 
+    /**
+     * Locks the client context against the tracking thread, if there is one.
+     * The returned lock is empty when the context is only used from the host
+     * thread.
+     */
+    std::unique_lock<std::mutex> lockContext();
+
+    /** \name Debug request handlers. */
+    //@{
+    void debugStats(DebugResponse& response) const;
+    void debugLatency(DebugResponse& response) const;
+    void debugFilter(const DebugCommand& command, DebugResponse& response);
+    void debugDumpConfig(DebugResponse& response);
+    void debugResetCounters(DebugResponse& response);
+    void debugGovernor(const DebugCommand& command, DebugResponse& response);
+    void debugStartup(DebugResponse& response) const;
+    //@}
+
     const std::string m_DisplayDescription;
     osvr::clientkit::ClientContext& m_Context;
+    std::mutex* contextMutex_ = nullptr; ///< set by ServerDriver_OSVR when a tracking thread shares m_Context
     osvr::clientkit::DisplayConfig m_DisplayConfig;
     osvr::client::RenderManagerConfig m_RenderManagerConfig;
     vr::IServerDriverHost* driver_host_ = nullptr;
     osvr::clientkit::Interface m_TrackerInterface;
-    vr::DriverPose_t pose_;
+    TripleBuffer<vr::DriverPose_t> pose_; ///< written by the tracker callback, read by GetPose()
+    PoseFilterChain poseFilters_; ///< smooths poses before anything else sees them
+    std::mutex poseFiltersMutex_; ///< lets debug requests retune poseFilters_ while poses arrive
+    VelocityEstimator velocityEstimator_;
+    ClockBridge clockBridge_; ///< maps report timestamps to host time for poseTimeOffset
+    PoseHistoryType poseHistory_;
+    osvr::recording::PoseRecorder poseRecorder_; ///< captures every report when enabled in settings
+    PoseLatencyStats latency_; ///< recorded by the tracker callback, read by anyone
+    std::atomic<uint64_t> poseReportCount_{0};
+    std::atomic<uint64_t> velocityReportCount_{0};
+    std::shared_ptr<const TrackedPropertySnapshot> propertySnapshot_; ///< built on activation, empty until then; only accessed with std::atomic_load() and std::atomic_exchange()
+    uint32_t objectId_ = vr::k_unTrackedDeviceIndexInvalid;
+    std::vector<StartupWait::Phase> startupPhases_; ///< how the last Activate() went
+    std::shared_ptr<const DisplaySnapshot> displaySnapshot_; ///< only accessed with std::atomic_load() and std::atomic_store()
+    std::string displayDescriptor_; ///< the server's /display parameter displaySnapshot_ was taken with
+    osvr::clientkit::DisplayConfig pendingDisplayConfig_; ///< opened for a changed descriptor, waiting to start up
+    std::chrono::steady_clock::time_point nextDisplayCheck_;
+    std::atomic<uint64_t> displayGeneration_{0}; ///< DisplayMonitor generation displayOnDesktop_ was worked out from
+    std::atomic<bool> displayOnDesktop_{false};
+    std::mutex displayStateMutex_;
+    osvr::display::DisplaySelector displaySelector_; ///< finds the HMD among the displays; configured from settings
+    std::shared_ptr<const DistortionState> distortion_; ///< read from m_DisplayDescription, then baked on activation and display changes; only accessed with std::atomic_load() and std::atomic_store()
+    std::string renderManagerConfigString_; ///< the /renderManagerConfig parameter distortion_ was baked with
+    std::string userDriverConfigDir_;
+    std::atomic<uint32_t> renderTargetWidth_{0}; ///< worked out on activation, then scaled by the governor; zero until then
+    std::atomic<uint32_t> renderTargetHeight_{0};
+    std::atomic<double> renderTargetBaseWidth_{0.0}; ///< before the governor's scale
+    std::atomic<double> renderTargetBaseHeight_{0.0};
+    RenderResolutionGovernor renderGovernor_;
+    mutable std::mutex renderGovernorMutex_; ///< held while using renderGovernor_
+    OSVR_VelocityState lastVelocityReport_ = {};
+    OSVR_TimeValue lastVelocityReportTime_ = {};
+    bool haveVelocityReport_ = false;
     vr::ETrackedDeviceClass deviceClass_;
     std::unique_ptr<Settings> settings_;
 
     // Settings
     bool verboseLogging_ = false;
+    std::size_t distortionGridSize_ = 65;
+    std::string distortionCachePath_; ///< empty to always bake
+    double renderQuality_ = 1.0;
+    std::chrono::steady_clock::duration startupTimeout_ = std::chrono::seconds(10);
+    std::chrono::steady_clock::duration displayCheckInterval_ = std::chrono::seconds(1);
+    bool renderGovernorEnabled_ = false;
+    double renderGovernorFrameTime_ = 0.0; ///< seconds; zero for one refresh interval
     osvr::display::Display display_ = {};
 };
 
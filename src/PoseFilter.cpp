@@ -0,0 +1,429 @@
+/** @file
+    @brief Pose smoothing filters and a chain to run them in.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseFilter.h"
+#include "make_unique.h"
+
+// Library/third-party includes
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <algorithm>        // for std::min, std::max
+#include <cstddef>          // for std::size_t
+#include <sstream>
+#include <string>
+
+namespace {
+
+const double Pi = 3.14159265358979323846;
+
+/**
+ * Poses further apart than this (in seconds) are treated as a gap in
+ * tracking rather than filtered together.
+ */
+const double MaxFilterInterval = 0.1;
+
+/**
+ * Smoothing factor of a first-order low-pass filter with the given cutoff
+ * frequency (in Hz) sampled every @p dt seconds.
+ */
+double lowPassAlpha(double cutoff, double dt)
+{
+    const double tau = 1.0 / (2.0 * Pi * std::max(cutoff, 1e-6));
+    return 1.0 / (1.0 + tau / dt);
+}
+
+/**
+ * Rotation vector (axis times angle) of the shortest rotation equivalent to
+ * @p q.
+ */
+Eigen::Vector3d toRotationVector(const Eigen::Quaterniond& q)
+{
+    Eigen::Quaterniond shortest = q;
+    if (shortest.w() < 0.0)
+        shortest.coeffs() = -shortest.coeffs();
+    const Eigen::AngleAxisd angle_axis(shortest.normalized());
+    return angle_axis.axis() * angle_axis.angle();
+}
+
+Eigen::Quaterniond fromRotationVector(const Eigen::Vector3d& v)
+{
+    const double angle = v.norm();
+    if (angle < 1e-12)
+        return Eigen::Quaterniond::Identity();
+    return Eigen::Quaterniond(Eigen::AngleAxisd(angle, v / angle));
+}
+
+} // end anonymous namespace
+
+// ------------------------------------
+// PoseFilter
+// ------------------------------------
+
+bool PoseFilter::setParameter(const std::string& name, double value)
+{
+    for (std::size_t i = 0; i < getParameterCount(); ++i) {
+        if (name == getParameterName(i)) {
+            setParameter(i, value);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ------------------------------------
+// OneEuroFilter
+// ------------------------------------
+
+OneEuroFilter::OneEuroFilter()
+{
+    parameters_[MinCutoff] = 1.0;
+    parameters_[Beta] = 20.0;
+    parameters_[DerivativeCutoff] = 1.0;
+    reset();
+}
+
+const char* OneEuroFilter::getName() const
+{
+    return "oneEuro";
+}
+
+void OneEuroFilter::reset()
+{
+    initialized_ = false;
+    position_.setZero();
+    velocity_.setZero();
+    orientation_.setIdentity();
+    angularVelocity_.setZero();
+}
+
+void OneEuroFilter::filter(double dt, Eigen::Vector3d& position, Eigen::Quaterniond& orientation)
+{
+    if (!initialized_) {
+        initialized_ = true;
+        position_ = position;
+        orientation_ = orientation;
+        return;
+    }
+
+    const double derivative_alpha = lowPassAlpha(parameters_[DerivativeCutoff], dt);
+
+    // Position: smooth the speed, then use it to pick the cutoff.
+    const Eigen::Vector3d velocity = (position - position_) / dt;
+    velocity_ += derivative_alpha * (velocity - velocity_);
+    const double position_alpha = lowPassAlpha(parameters_[MinCutoff] + parameters_[Beta] * velocity_.norm(), dt);
+    position_ += position_alpha * (position - position_);
+    position = position_;
+
+    // Orientation: same again with angular rate and slerp.
+    const Eigen::Vector3d angular_velocity = toRotationVector(orientation * orientation_.conjugate()) / dt;
+    angularVelocity_ += derivative_alpha * (angular_velocity - angularVelocity_);
+    const double orientation_alpha = lowPassAlpha(parameters_[MinCutoff] + parameters_[Beta] * angularVelocity_.norm(), dt);
+    orientation_ = Eigen::Quaterniond(orientation_).slerp(orientation_alpha, orientation);
+    orientation = orientation_;
+}
+
+std::size_t OneEuroFilter::getParameterCount() const
+{
+    return NumParameters;
+}
+
+const char* OneEuroFilter::getParameterName(std::size_t index) const
+{
+    static const char* const names[NumParameters] = { "minCutoff", "beta", "derivativeCutoff" };
+    return (index < NumParameters) ? names[index] : "";
+}
+
+double OneEuroFilter::getParameter(std::size_t index) const
+{
+    return (index < NumParameters) ? parameters_[index] : 0.0;
+}
+
+void OneEuroFilter::setParameter(std::size_t index, double value)
+{
+    if (index < NumParameters)
+        parameters_[index] = std::max(value, 0.0);
+}
+
+// ------------------------------------
+// ExponentialFilter
+// ------------------------------------
+
+ExponentialFilter::ExponentialFilter()
+{
+    parameters_[Alpha] = 0.5;
+    reset();
+}
+
+const char* ExponentialFilter::getName() const
+{
+    return "exponential";
+}
+
+void ExponentialFilter::reset()
+{
+    initialized_ = false;
+    position_.setZero();
+    orientation_.setIdentity();
+}
+
+void ExponentialFilter::filter(double /*dt*/, Eigen::Vector3d& position, Eigen::Quaterniond& orientation)
+{
+    if (!initialized_) {
+        initialized_ = true;
+        position_ = position;
+        orientation_ = orientation;
+        return;
+    }
+
+    const double alpha = parameters_[Alpha];
+    position_ += alpha * (position - position_);
+    orientation_ = Eigen::Quaterniond(orientation_).slerp(alpha, orientation);
+    position = position_;
+    orientation = orientation_;
+}
+
+std::size_t ExponentialFilter::getParameterCount() const
+{
+    return NumParameters;
+}
+
+const char* ExponentialFilter::getParameterName(std::size_t index) const
+{
+    static const char* const names[NumParameters] = { "alpha" };
+    return (index < NumParameters) ? names[index] : "";
+}
+
+double ExponentialFilter::getParameter(std::size_t index) const
+{
+    return (index < NumParameters) ? parameters_[index] : 0.0;
+}
+
+void ExponentialFilter::setParameter(std::size_t index, double value)
+{
+    if (index < NumParameters)
+        parameters_[index] = std::min(std::max(value, 0.01), 1.0);
+}
+
+// ------------------------------------
+// KalmanFilter
+// ------------------------------------
+
+KalmanFilter::KalmanFilter()
+{
+    parameters_[PositionProcessNoise] = 1.0;
+    parameters_[PositionMeasurementNoise] = 1e-6;
+    parameters_[OrientationProcessNoise] = 10.0;
+    parameters_[OrientationMeasurementNoise] = 1e-5;
+    reset();
+}
+
+const char* KalmanFilter::getName() const
+{
+    return "kalman";
+}
+
+void KalmanFilter::reset()
+{
+    initialized_ = false;
+    position_.setZero();
+    velocity_.setZero();
+    orientation_.setIdentity();
+    angularVelocity_.setZero();
+
+    // Trust the first measurement as much as any other; know nothing about
+    // the velocity.
+    positionAxes_.covariance << parameters_[PositionMeasurementNoise], 0.0, 0.0, 1.0;
+    orientationAxes_.covariance << parameters_[OrientationMeasurementNoise], 0.0, 0.0, 1.0;
+}
+
+Eigen::Vector2d KalmanFilter::Axes::update(double dt, double process_noise, double measurement_noise)
+{
+    // Predict: P = F P F^T + Q for F = [1 dt; 0 1] and white acceleration
+    // noise.
+    Eigen::Matrix2d transition;
+    transition << 1.0, dt, 0.0, 1.0;
+    Eigen::Matrix2d noise;
+    const double dt2 = dt * dt;
+    noise << dt2 * dt / 3.0, dt2 / 2.0, dt2 / 2.0, dt;
+    Eigen::Matrix2d p = transition * covariance * transition.transpose() + process_noise * noise;
+
+    // Update with a direct measurement of the first state (H = [1 0]).
+    const double innovation_variance = p(0, 0) + measurement_noise;
+    const Eigen::Vector2d gain = p.col(0) / innovation_variance;
+    p -= gain * p.row(0);
+    covariance = p;
+    return gain;
+}
+
+void KalmanFilter::filter(double dt, Eigen::Vector3d& position, Eigen::Quaterniond& orientation)
+{
+    if (!initialized_) {
+        initialized_ = true;
+        position_ = position;
+        orientation_ = orientation;
+        return;
+    }
+
+    // Position
+    position_ += velocity_ * dt;
+    const Eigen::Vector2d position_gain = positionAxes_.update(dt, parameters_[PositionProcessNoise], parameters_[PositionMeasurementNoise]);
+    const Eigen::Vector3d position_innovation = position - position_;
+    position_ += position_gain[0] * position_innovation;
+    velocity_ += position_gain[1] * position_innovation;
+    position = position_;
+
+    // Orientation, as an error state on the rotation vector between the
+    // predicted and measured orientation.
+    const Eigen::Quaterniond predicted = fromRotationVector(angularVelocity_ * dt) * Eigen::Quaterniond(orientation_);
+    const Eigen::Vector2d orientation_gain = orientationAxes_.update(dt, parameters_[OrientationProcessNoise], parameters_[OrientationMeasurementNoise]);
+    const Eigen::Vector3d orientation_innovation = toRotationVector(orientation * predicted.conjugate());
+    orientation_ = (fromRotationVector(orientation_gain[0] * orientation_innovation) * predicted).normalized();
+    angularVelocity_ += orientation_gain[1] * orientation_innovation;
+    orientation = orientation_;
+}
+
+std::size_t KalmanFilter::getParameterCount() const
+{
+    return NumParameters;
+}
+
+const char* KalmanFilter::getParameterName(std::size_t index) const
+{
+    static const char* const names[NumParameters] = { "positionProcessNoise", "positionMeasurementNoise", "orientationProcessNoise", "orientationMeasurementNoise" };
+    return (index < NumParameters) ? names[index] : "";
+}
+
+double KalmanFilter::getParameter(std::size_t index) const
+{
+    return (index < NumParameters) ? parameters_[index] : 0.0;
+}
+
+void KalmanFilter::setParameter(std::size_t index, double value)
+{
+    if (index < NumParameters)
+        parameters_[index] = std::max(value, 1e-12);
+}
+
+// ------------------------------------
+// Factory
+// ------------------------------------
+
+std::unique_ptr<PoseFilter> makePoseFilter(const std::string& name)
+{
+    if (name == "oneEuro")
+        return std::make_unique<OneEuroFilter>();
+    if (name == "exponential")
+        return std::make_unique<ExponentialFilter>();
+    if (name == "kalman")
+        return std::make_unique<KalmanFilter>();
+
+    return nullptr;
+}
+
+// ------------------------------------
+// PoseFilterChain
+// ------------------------------------
+
+std::string PoseFilterChain::setStages(const std::string& names)
+{
+    stages_.clear();
+    haveTime_ = false;
+
+    std::string unknown_names;
+    std::istringstream stream(names);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+        // Trim surrounding whitespace
+        const auto first = name.find_first_not_of(" \t");
+        if (std::string::npos == first)
+            continue;
+        const auto last = name.find_last_not_of(" \t");
+        name = name.substr(first, last - first + 1);
+
+        auto stage = makePoseFilter(name);
+        if (stage) {
+            stages_.emplace_back(std::move(stage));
+        } else {
+            unknown_names += (unknown_names.empty() ? "" : ",") + name;
+        }
+    }
+
+    return unknown_names;
+}
+
+bool PoseFilterChain::empty() const
+{
+    return stages_.empty();
+}
+
+std::size_t PoseFilterChain::size() const
+{
+    return stages_.size();
+}
+
+PoseFilter& PoseFilterChain::getStage(std::size_t index)
+{
+    return *stages_[index];
+}
+
+const PoseFilter& PoseFilterChain::getStage(std::size_t index) const
+{
+    return *stages_[index];
+}
+
+PoseFilter* PoseFilterChain::findStage(const std::string& name)
+{
+    for (auto& stage : stages_) {
+        if (name == stage->getName())
+            return stage.get();
+    }
+    return nullptr;
+}
+
+void PoseFilterChain::reset()
+{
+    for (auto& stage : stages_) {
+        stage->reset();
+    }
+    haveTime_ = false;
+}
+
+void PoseFilterChain::filter(double time, Eigen::Vector3d& position, Eigen::Quaterniond& orientation)
+{
+    if (stages_.empty())
+        return;
+
+    const double dt = time - lastTime_;
+    if (!haveTime_ || dt <= 0.0 || dt > MaxFilterInterval) {
+        reset();
+    }
+    haveTime_ = true;
+    lastTime_ = time;
+
+    for (auto& stage : stages_) {
+        stage->filter(dt, position, orientation);
+    }
+}
@@ -0,0 +1,257 @@
+/** @file
+    @brief Pose smoothing filters and a chain to run them in.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseFilter_h_GUID_0AB84ECA_F1D1_413C_8A63_9B936D65CEB9
+#define INCLUDED_PoseFilter_h_GUID_0AB84ECA_F1D1_413C_8A63_9B936D65CEB9
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <memory>           // for std::unique_ptr
+#include <string>
+#include <vector>
+
+/**
+ * @brief A stage of pose smoothing.
+ *
+ * Filters keep all their state inline so that filtering a pose never
+ * allocates. Each filter exposes its tuning parameters by name so that they
+ * can be read from settings or changed while running.
+ */
+class PoseFilter {
+public:
+    virtual ~PoseFilter() = default;
+
+    /**
+     * Returns the name used to select this filter in settings.
+     */
+    virtual const char* getName() const = 0;
+
+    /**
+     * Forgets all history. The next pose passes through unchanged.
+     */
+    virtual void reset() = 0;
+
+    /**
+     * Filters a pose in place.
+     *
+     * @param dt seconds since the previous pose. Not meaningful for the
+     * first pose after reset(), which is passed through unchanged.
+     */
+    virtual void filter(double dt, Eigen::Vector3d& position, Eigen::Quaterniond& orientation) = 0;
+
+    /** \name Tunable parameters. */
+    //@{
+    virtual std::size_t getParameterCount() const = 0;
+    virtual const char* getParameterName(std::size_t index) const = 0;
+    virtual double getParameter(std::size_t index) const = 0;
+    virtual void setParameter(std::size_t index, double value) = 0;
+
+    /**
+     * Sets the parameter called @p name.
+     *
+     * @return false if this filter has no such parameter.
+     */
+    bool setParameter(const std::string& name, double value);
+    //@}
+};
+
+/**
+ * @brief The One Euro filter (Casiez et al., CHI 2012): an exponential
+ * smoother whose cutoff frequency rises with speed, so it removes jitter when
+ * the head is still without adding lag when it moves.
+ *
+ * Position and orientation are filtered separately. For orientation the
+ * "speed" is the angular rate and smoothing is done by slerp.
+ */
+class OneEuroFilter : public PoseFilter {
+public:
+    OneEuroFilter();
+
+    const char* getName() const override;
+    void reset() override;
+    void filter(double dt, Eigen::Vector3d& position, Eigen::Quaterniond& orientation) override;
+
+    std::size_t getParameterCount() const override;
+    const char* getParameterName(std::size_t index) const override;
+    double getParameter(std::size_t index) const override;
+    void setParameter(std::size_t index, double value) override;
+    using PoseFilter::setParameter;
+
+private:
+    enum Parameter {
+        MinCutoff,        ///< cutoff frequency when still, in Hz
+        Beta,             ///< how fast the cutoff rises with speed
+        DerivativeCutoff, ///< cutoff frequency for the speed estimate, in Hz
+        NumParameters
+    };
+    double parameters_[NumParameters];
+
+    bool initialized_ = false;
+    Eigen::Vector3d position_;
+    Eigen::Vector3d velocity_;
+    Eigen::Quaternion<double, Eigen::DontAlign> orientation_;
+    Eigen::Vector3d angularVelocity_;
+};
+
+/**
+ * @brief Plain exponential smoothing: each output moves a fixed fraction of
+ * the way towards the newest pose.
+ */
+class ExponentialFilter : public PoseFilter {
+public:
+    ExponentialFilter();
+
+    const char* getName() const override;
+    void reset() override;
+    void filter(double dt, Eigen::Vector3d& position, Eigen::Quaterniond& orientation) override;
+
+    std::size_t getParameterCount() const override;
+    const char* getParameterName(std::size_t index) const override;
+    double getParameter(std::size_t index) const override;
+    void setParameter(std::size_t index, double value) override;
+    using PoseFilter::setParameter;
+
+private:
+    enum Parameter {
+        Alpha, ///< weight of the newest pose, in (0, 1]
+        NumParameters
+    };
+    double parameters_[NumParameters];
+
+    bool initialized_ = false;
+    Eigen::Vector3d position_;
+    Eigen::Quaternion<double, Eigen::DontAlign> orientation_;
+};
+
+/**
+ * @brief Constant-velocity Kalman filter.
+ *
+ * Position is tracked with a position/velocity state per axis. Orientation
+ * is tracked the same way on the rotation vector between the predicted and
+ * measured orientation (an error-state formulation), so every axis of both
+ * shares one 2x2 covariance and the update costs a handful of multiplies.
+ */
+class KalmanFilter : public PoseFilter {
+public:
+    KalmanFilter();
+
+    const char* getName() const override;
+    void reset() override;
+    void filter(double dt, Eigen::Vector3d& position, Eigen::Quaterniond& orientation) override;
+
+    std::size_t getParameterCount() const override;
+    const char* getParameterName(std::size_t index) const override;
+    double getParameter(std::size_t index) const override;
+    void setParameter(std::size_t index, double value) override;
+    using PoseFilter::setParameter;
+
+private:
+    enum Parameter {
+        PositionProcessNoise,        ///< acceleration noise density, (m/s^2)^2/Hz
+        PositionMeasurementNoise,    ///< measurement variance, m^2
+        OrientationProcessNoise,     ///< angular acceleration noise density, (rad/s^2)^2/Hz
+        OrientationMeasurementNoise, ///< measurement variance, rad^2
+        NumParameters
+    };
+    double parameters_[NumParameters];
+
+    /**
+     * A constant-velocity model shared by the three axes of a vector state.
+     */
+    struct Axes {
+        Eigen::Matrix<double, 2, 2, Eigen::DontAlign> covariance;
+
+        /**
+         * Propagates the covariance by @p dt and returns the gain for a
+         * measurement with variance @p measurement_noise.
+         */
+        Eigen::Vector2d update(double dt, double process_noise, double measurement_noise);
+    };
+
+    bool initialized_ = false;
+    Axes positionAxes_;
+    Eigen::Vector3d position_;
+    Eigen::Vector3d velocity_;
+    Axes orientationAxes_;
+    Eigen::Quaternion<double, Eigen::DontAlign> orientation_;
+    Eigen::Vector3d angularVelocity_;
+};
+
+/**
+ * Creates the filter named @p name, or returns null if there's no such
+ * filter.
+ */
+std::unique_ptr<PoseFilter> makePoseFilter(const std::string& name);
+
+/**
+ * @brief Runs a pose through a sequence of filters.
+ *
+ * Stages are created up front by setStages(); filtering itself does not
+ * allocate.
+ */
+class PoseFilterChain {
+public:
+    /**
+     * Replaces the stages with those named in @p names, a comma-separated
+     * list such as "oneEuro,kalman".
+     *
+     * @return the names that didn't match any filter, comma-separated.
+     */
+    std::string setStages(const std::string& names);
+
+    bool empty() const;
+    std::size_t size() const;
+    PoseFilter& getStage(std::size_t index);
+    const PoseFilter& getStage(std::size_t index) const;
+
+    /**
+     * Returns the first stage named @p name, or null if there isn't one.
+     */
+    PoseFilter* findStage(const std::string& name);
+
+    /**
+     * Resets every stage.
+     */
+    void reset();
+
+    /**
+     * Filters the pose measured at @p time (in seconds) in place. A pose
+     * that's out of order, or follows a gap in tracking, restarts every
+     * stage.
+     */
+    void filter(double time, Eigen::Vector3d& position, Eigen::Quaterniond& orientation);
+
+private:
+    std::vector<std::unique_ptr<PoseFilter>> stages_;
+    bool haveTime_ = false;
+    double lastTime_ = 0.0;
+};
+
+#endif // INCLUDED_PoseFilter_h_GUID_0AB84ECA_F1D1_413C_8A63_9B936D65CEB9
@@ -0,0 +1,275 @@
+/** @file
+    @brief Fixed-capacity history of recent poses with time-indexed queries.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseHistory_h_GUID_DF777346_E252_4359_A449_EC0671BED05A
+#define INCLUDED_PoseHistory_h_GUID_DF777346_E252_4359_A449_EC0671BED05A
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <algorithm>        // for std::min
+#include <atomic>
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+
+/**
+ * @brief A timestamped pose.
+ */
+struct TimedPose {
+    double time = 0.0;                                        ///< seconds
+    Eigen::Vector3d position = Eigen::Vector3d::Zero();
+    Eigen::Quaterniond orientation = Eigen::Quaterniond::Identity();
+    Eigen::Vector3d linearVelocity = Eigen::Vector3d::Zero();  ///< meters/second
+    Eigen::Vector3d angularVelocity = Eigen::Vector3d::Zero(); ///< axis-angle, radians/second
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/**
+ * @brief Keeps the last @c Capacity poses in a ring without allocating, and
+ * answers "where was the device at time t?" by interpolating between them.
+ *
+ * One thread may add() while any number of threads query. Each slot is
+ * guarded by a sequence counter: readers that catch a slot mid-write simply
+ * read it again, and the writer never waits.
+ */
+template <std::size_t Capacity>
+class PoseHistory {
+public:
+    static_assert(Capacity >= 2, "PoseHistory needs room for at least two poses.");
+
+    PoseHistory() : written_(0)
+    {
+        for (auto& slot : slots_) {
+            slot.sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    PoseHistory(const PoseHistory&) = delete;
+    PoseHistory& operator=(const PoseHistory&) = delete;
+
+    /**
+     * Appends a pose, overwriting the oldest one once the history is full.
+     * Poses must be added in increasing time order. Only one thread may call
+     * this.
+     */
+    void add(double time, const Eigen::Vector3d& position, const Eigen::Quaterniond& orientation)
+    {
+        const auto index = written_.load(std::memory_order_relaxed);
+        auto& slot = slots_[index % Capacity];
+
+        const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.values[0].store(time, std::memory_order_relaxed);
+        for (int i = 0; i < 3; ++i) {
+            slot.values[1 + i].store(position[i], std::memory_order_relaxed);
+        }
+        slot.values[4].store(orientation.w(), std::memory_order_relaxed);
+        slot.values[5].store(orientation.x(), std::memory_order_relaxed);
+        slot.values[6].store(orientation.y(), std::memory_order_relaxed);
+        slot.values[7].store(orientation.z(), std::memory_order_relaxed);
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        written_.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * Forgets every pose.
+     */
+    void clear()
+    {
+        written_.store(0, std::memory_order_release);
+    }
+
+    /**
+     * Returns the number of poses currently held.
+     */
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(std::min<uint64_t>(written_.load(std::memory_order_acquire), Capacity));
+    }
+
+    /**
+     * Reads a stored pose. @p age 0 is the newest.
+     *
+     * @return false if there is no such pose.
+     */
+    bool get(std::size_t age, TimedPose& pose) const
+    {
+        const auto written = written_.load(std::memory_order_acquire);
+        if (age >= std::min<uint64_t>(written, Capacity))
+            return false;
+
+        return read(written - 1 - age, pose);
+    }
+
+    /**
+     * Computes the pose at @p time.
+     *
+     * Between two stored poses, position is linearly interpolated and
+     * orientation is spherically interpolated. Past the newest pose, the pose
+     * is extrapolated from the velocity between the two newest poses, but by
+     * no more than @p max_extrapolation seconds.
+     *
+     * @return false if @p time is older than the oldest stored pose or fewer
+     * than two poses are stored.
+     */
+    bool sample(double time, TimedPose& pose, double max_extrapolation = 0.05) const
+    {
+        TimedPose newer, older;
+        for (int attempt = 0; attempt < MaxAttempts; ++attempt) {
+            const auto written = written_.load(std::memory_order_acquire);
+            const auto available = std::min<uint64_t>(written, Capacity);
+            if (available < 2)
+                return false;
+
+            // Walk back from the newest pose until we find the pair of poses
+            // bracketing the requested time. Queries are nearly always for
+            // recent times, so this rarely goes far.
+            if (!read(written - 1, newer))
+                continue;
+
+            bool found = false;
+            bool torn = false;
+            for (uint64_t age = 1; age < available; ++age) {
+                if (!read(written - 1 - age, older)) {
+                    torn = true;
+                    break;
+                }
+                if (older.time <= time || time > newer.time) {
+                    found = true;
+                    break;
+                }
+                newer = older;
+            }
+            if (torn)
+                continue;
+            if (!found)
+                return false;
+
+            interpolate(older, newer, time, max_extrapolation, pose);
+            return true;
+        }
+
+        return false;
+    }
+
+private:
+    /// Values per slot: time, position (3), orientation (w, x, y, z).
+    static const int NumValues = 8;
+
+    /// Queries give up after this many collisions with the writer.
+    static const int MaxAttempts = 4;
+
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        std::atomic<double> values[NumValues];
+    };
+
+    /**
+     * Reads the pose with absolute index @p index.
+     *
+     * @return false if the writer overwrote it while we were reading.
+     */
+    bool read(uint64_t index, TimedPose& pose) const
+    {
+        const auto& slot = slots_[index % Capacity];
+        for (int attempt = 0; attempt < MaxAttempts; ++attempt) {
+            const auto before = slot.sequence.load(std::memory_order_acquire);
+            if (before & 1)
+                continue;
+
+            double values[NumValues];
+            for (int i = 0; i < NumValues; ++i) {
+                values[i] = slot.values[i].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != before)
+                continue;
+
+            // Make sure the slot still holds the pose we asked for rather
+            // than a newer one that has lapped it.
+            if (written_.load(std::memory_order_acquire) > index + Capacity)
+                return false;
+
+            pose.time = values[0];
+            pose.position = Eigen::Vector3d(values[1], values[2], values[3]);
+            pose.orientation = Eigen::Quaterniond(values[4], values[5], values[6], values[7]);
+            pose.linearVelocity.setZero();
+            pose.angularVelocity.setZero();
+            return true;
+        }
+
+        return false;
+    }
+
+    static void interpolate(const TimedPose& older, const TimedPose& newer, double time, double max_extrapolation, TimedPose& pose)
+    {
+        const double dt = newer.time - older.time;
+
+        // Velocities between the two poses
+        Eigen::Quaterniond delta = newer.orientation * older.orientation.conjugate();
+        if (delta.w() < 0.0)
+            delta.coeffs() = -delta.coeffs();
+        const Eigen::AngleAxisd delta_angle_axis(delta.normalized());
+        if (dt > 0.0) {
+            pose.linearVelocity = (newer.position - older.position) / dt;
+            pose.angularVelocity = delta_angle_axis.axis() * (delta_angle_axis.angle() / dt);
+        } else {
+            pose.linearVelocity.setZero();
+            pose.angularVelocity.setZero();
+        }
+
+        if (time > newer.time) {
+            // Extrapolate past the newest pose.
+            const double ahead = std::min(time - newer.time, max_extrapolation);
+            pose.time = newer.time + ahead;
+            pose.position = newer.position + pose.linearVelocity * ahead;
+            const double angle = pose.angularVelocity.norm() * ahead;
+            if (angle > 0.0) {
+                pose.orientation = Eigen::AngleAxisd(angle, pose.angularVelocity.normalized()) * newer.orientation;
+            } else {
+                pose.orientation = newer.orientation;
+            }
+            return;
+        }
+
+        const double t = (dt > 0.0) ? (time - older.time) / dt : 1.0;
+        pose.time = time;
+        pose.position = older.position + t * (newer.position - older.position);
+        pose.orientation = older.orientation.slerp(t, newer.orientation);
+    }
+
+    Slot slots_[Capacity];
+    std::atomic<uint64_t> written_; ///< total number of poses ever added
+};
+
+#endif // INCLUDED_PoseHistory_h_GUID_DF777346_E252_4359_A449_EC0671BED05A
@@ -0,0 +1,104 @@
+/** @file
+    @brief Converts between OSVR/OpenVR pose types and capture records.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseRecordConversion_h_GUID_935DD5E0_15EB_49C8_B3E3_29FB52DEBB6A
+#define INCLUDED_PoseRecordConversion_h_GUID_935DD5E0_15EB_49C8_B3E3_29FB52DEBB6A
+
+// Internal Includes
+#include "recording/PoseRecord.h"
+
+// OpenVR includes
+#include <openvr_driver.h>
+
+// Library/third-party includes
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Standard includes
+#include <cstdint>
+
+namespace detail {
+
+inline void copyQuaternion(const vr::HmdQuaternion_t& from, double (&to)[4])
+{
+    to[0] = from.w;
+    to[1] = from.x;
+    to[2] = from.y;
+    to[3] = from.z;
+}
+
+inline void copyVector(const double (&from)[3], double (&to)[3])
+{
+    for (int i = 0; i < 3; ++i) {
+        to[i] = from[i];
+    }
+}
+
+} // end namespace detail
+
+/**
+ * Captures a tracker report, the host time it arrived at, and the pose the
+ * driver made of it.
+ */
+inline osvr::recording::PoseRecord makePoseRecord(const OSVR_TimeValue& timestamp, const OSVR_PoseReport& report, double host_time, const vr::DriverPose_t& pose)
+{
+    using osvr::recording::DriverPoseRecord;
+
+    osvr::recording::PoseRecord record = {};
+    record.osvrSeconds = timestamp.seconds;
+    record.osvrMicroseconds = timestamp.microseconds;
+    record.sensor = report.sensor;
+    record.hostTime = host_time;
+    for (int i = 0; i < 3; ++i) {
+        record.reportPosition[i] = report.pose.translation.data[i];
+    }
+    for (int i = 0; i < 4; ++i) {
+        record.reportOrientation[i] = report.pose.rotation.data[i];
+    }
+
+    auto& driver_pose = record.driverPose;
+    driver_pose.poseTimeOffset = pose.poseTimeOffset;
+    detail::copyQuaternion(pose.qWorldFromDriverRotation, driver_pose.worldFromDriverRotation);
+    detail::copyVector(pose.vecWorldFromDriverTranslation, driver_pose.worldFromDriverTranslation);
+    detail::copyQuaternion(pose.qDriverFromHeadRotation, driver_pose.driverFromHeadRotation);
+    detail::copyVector(pose.vecDriverFromHeadTranslation, driver_pose.driverFromHeadTranslation);
+    detail::copyVector(pose.vecPosition, driver_pose.position);
+    detail::copyVector(pose.vecVelocity, driver_pose.velocity);
+    detail::copyVector(pose.vecAcceleration, driver_pose.acceleration);
+    detail::copyQuaternion(pose.qRotation, driver_pose.rotation);
+    detail::copyVector(pose.vecAngularVelocity, driver_pose.angularVelocity);
+    detail::copyVector(pose.vecAngularAcceleration, driver_pose.angularAcceleration);
+    driver_pose.result = static_cast<int32_t>(pose.result);
+    driver_pose.flags = 0;
+    if (pose.poseIsValid)
+        driver_pose.flags |= DriverPoseRecord::PoseIsValid;
+    if (pose.willDriftInYaw)
+        driver_pose.flags |= DriverPoseRecord::WillDriftInYaw;
+    if (pose.shouldApplyHeadModel)
+        driver_pose.flags |= DriverPoseRecord::ShouldApplyHeadModel;
+
+    return record;
+}
+
+#endif // INCLUDED_PoseRecordConversion_h_GUID_935DD5E0_15EB_49C8_B3E3_29FB52DEBB6A
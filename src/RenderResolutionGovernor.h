@@ -0,0 +1,197 @@
+/** @file
+    @brief Scales the render target down when frames run late and back up
+    when there's time to spare.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RenderResolutionGovernor_h_GUID_B2FFE16A_EAFE_4C1C_BAFA_208972D9E912
+#define INCLUDED_RenderResolutionGovernor_h_GUID_B2FFE16A_EAFE_4C1C_BAFA_208972D9E912
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::min, std::max
+#include <cmath>            // for std::sqrt
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+
+/**
+ * @brief Picks a render target scale from how long recent frames took.
+ *
+ * Frame times are judged a window at a time. A window that runs over the
+ * high-water mark, or with more than a few frames over budget, scales down
+ * at once, in proportion to the overrun and assuming the cost follows the
+ * pixel count. Scaling back up takes several calm windows in a row, below
+ * a lower mark and with no late frames, and goes a small step at a time.
+ * The gap between the marks and the wait before scaling up keep the scale
+ * from hunting back and forth on a steady load.
+ */
+class RenderResolutionGovernor {
+public:
+    /// Frames judged together
+    static const std::size_t WindowSize = 30;
+
+    /// Calm windows in a row needed before scaling up
+    static const std::size_t CalmWindowsToRaise = 3;
+
+    RenderResolutionGovernor()
+    {
+        reset();
+    }
+
+    /**
+     * Sets the time each frame has, in seconds: one refresh interval.
+     */
+    void setTargetFrameTime(double seconds)
+    {
+        if (seconds > 0.0)
+            targetFrameTime_ = seconds;
+    }
+
+    double getTargetFrameTime() const
+    {
+        return targetFrameTime_;
+    }
+
+    /**
+     * Sets the range the scale stays within, and clamps it to that.
+     */
+    void setBounds(double min_scale, double max_scale)
+    {
+        minScale_ = std::max(min_scale, 0.1);
+        maxScale_ = std::max(max_scale, minScale_);
+        scale_ = std::min(std::max(scale_, minScale_), maxScale_);
+    }
+
+    double getMinScale() const
+    {
+        return minScale_;
+    }
+
+    double getMaxScale() const
+    {
+        return maxScale_;
+    }
+
+    /**
+     * Goes back to the largest scale and forgets the frames seen so far.
+     */
+    void reset()
+    {
+        scale_ = maxScale_;
+        clearWindow();
+        calmWindows_ = 0;
+    }
+
+    /**
+     * Adds the time one frame took to render, in seconds.
+     *
+     * @return true if this changed the scale.
+     */
+    bool addFrameTime(double seconds)
+    {
+        if (!(seconds > 0.0))
+            return false;
+
+        ++frames_;
+        total_ += seconds;
+        if (seconds > targetFrameTime_)
+            ++lateFrames_;
+        if (frames_ < WindowSize)
+            return false;
+
+        const double mean = total_ / static_cast<double>(frames_);
+        const bool overloaded = mean > HighWater * targetFrameTime_ || lateFrames_ * 10 > frames_;
+        const bool calm = mean < LowWater * targetFrameTime_ && 0 == lateFrames_;
+        clearWindow();
+
+        double scale = scale_;
+        if (overloaded) {
+            // Aim between the marks, at least a step down
+            calmWindows_ = 0;
+            const double fit = scale_ * std::sqrt(Aim * targetFrameTime_ / std::max(mean, targetFrameTime_ * HighWater));
+            scale = std::max(std::min(fit, scale_ - Step), minScale_);
+        } else if (calm) {
+            if (++calmWindows_ >= CalmWindowsToRaise) {
+                calmWindows_ = 0;
+                scale = std::min(scale_ + Step, maxScale_);
+            }
+        } else {
+            calmWindows_ = 0;
+        }
+
+        if (scale == scale_)
+            return false;
+        scale_ = scale;
+        ++changes_;
+        return true;
+    }
+
+    /**
+     * The render target scale to use now, within the bounds.
+     */
+    double getScale() const
+    {
+        return scale_;
+    }
+
+    /**
+     * How many times the scale has changed.
+     */
+    uint64_t getChangeCount() const
+    {
+        return changes_;
+    }
+
+private:
+    /// Fractions of the target frame time
+    static constexpr double HighWater = 0.9;
+    static constexpr double LowWater = 0.7;
+    static constexpr double Aim = 0.8;
+
+    /// Smallest change in scale
+    static constexpr double Step = 0.05;
+
+    void clearWindow()
+    {
+        frames_ = 0;
+        lateFrames_ = 0;
+        total_ = 0.0;
+    }
+
+    double targetFrameTime_ = 1.0 / 90.0;
+    double minScale_ = 0.5;
+    double maxScale_ = 1.0;
+    double scale_ = 1.0;
+
+    std::size_t frames_ = 0;
+    std::size_t lateFrames_ = 0;
+    double total_ = 0.0;
+    std::size_t calmWindows_ = 0;
+    uint64_t changes_ = 0;
+};
+
+#endif // INCLUDED_RenderResolutionGovernor_h_GUID_B2FFE16A_EAFE_4C1C_BAFA_208972D9E912
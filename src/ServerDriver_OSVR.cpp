@@ -30,6 +30,9 @@
 #include "make_unique.h"            // for std::make_unique
 #include "osvr_platform.h"          // for OSVR_PATH_SEPARATOR
 #include "Logging.h"                // for OSVR_LOG, Logging
+#include "Settings.h"               // for Settings
+#include "TrackingThread.h"         // for TrackingThread
+#include "display/DisplayMonitor.h" // for osvr::display::DisplayMonitor
 
 // Library/third-party includes
 #include <openvr_driver.h>          // for everything in vr namespace
@@ -46,18 +49,54 @@ vr::EVRInitError ServerDriver_OSVR::Init(vr::IDriverLog* driver_log, vr::IServer
     if (driver_log)
         Logging::instance().setDriverLog(driver_log);
 
+    // Watch the displays again if an earlier Cleanup() stopped watching.
+    auto& display_monitor = osvr::display::DisplayMonitor::instance();
+    display_monitor.setErrorHandler([](const std::string& error) {
+        OSVR_LOG(err) << "ServerDriver_OSVR: " << error << "\n";
+    });
+    display_monitor.start();
+
     context_ = std::make_unique<osvr::clientkit::ClientContext>("org.osvr.SteamVR");
 
     const std::string display_description = context_->getStringParameter("/display");
-    trackedDevices_.emplace_back(std::make_unique<OSVRTrackedDevice>(display_description, *(context_.get()), driver_host));
+    const std::string config_dir = user_driver_config_dir ? user_driver_config_dir : "";
+    trackedDevices_.emplace_back(std::make_unique<OSVRTrackedDevice>(display_description, *(context_.get()), driver_host, nullptr, config_dir));
+
+    // Decide who pumps the context: the host via RunFrame() (the default) or
+    // our own tracking thread.
+    std::string tracking_mode = "frame";
+    float tracking_rate = 1000.0f;
+    if (driver_host) {
+        Settings settings(driver_host->GetSettings(vr::IVRSettings_Version));
+        tracking_mode = settings.getSetting<std::string>("trackingMode", tracking_mode);
+        tracking_rate = settings.getSetting<float>("trackingRate", tracking_rate);
+    }
+
+    if (tracking_mode == "thread") {
+        for (auto& tracked_device : trackedDevices_) {
+            tracked_device->contextMutex_ = &contextMutex_;
+        }
+        trackingThread_ = std::make_unique<TrackingThread>(*context_, contextMutex_, tracking_rate);
+        trackingThread_->start();
+    } else if (tracking_mode != "frame") {
+        OSVR_LOG(warn) << "ServerDriver_OSVR::Init(): Unknown trackingMode '" << tracking_mode << "', updating from RunFrame() instead.\n";
+    }
 
     return vr::VRInitError_None;
 }
 
 void ServerDriver_OSVR::Cleanup()
 {
+    // Stop delivering poses before the devices they're delivered to go away.
+    trackingThread_.reset();
     trackedDevices_.clear();
     context_.reset();
+
+    // Join the display watcher now, while the driver is still loaded, rather
+    // than during static destruction, and stop it logging through us.
+    auto& display_monitor = osvr::display::DisplayMonitor::instance();
+    display_monitor.stop();
+    display_monitor.setErrorHandler(nullptr);
 }
 
 const char* const* ServerDriver_OSVR::GetInterfaceVersions()
@@ -99,6 +138,14 @@ vr::ITrackedDeviceServerDriver* ServerDriver_OSVR::FindTrackedDeviceDriver(const
 
 void ServerDriver_OSVR::RunFrame()
 {
+    for (auto& tracked_device : trackedDevices_) {
+        tracked_device->CheckDisplayConfig();
+    }
+
+    // The tracking thread does this for us when it's running.
+    if (trackingThread_)
+        return;
+
     context_->update();
 }
 
@@ -27,6 +27,7 @@
 
 // Internal Includes
 #include "OSVRTrackedDevice.h"          // for OSVRTrackedDevice
+#include "TrackingThread.h"             // for TrackingThread
 #include "osvr_compiler_detection.h"    // for OSVR_OVERRIDE
 
 // Library/third-party includes
@@ -39,6 +40,7 @@
 #include <cstring>                      // for std::strcmp
 #include <string>                       // for std::string, std::to_string
 #include <memory>                       // for std::unique_ptr
+#include <mutex>                        // for std::mutex
 
 class ServerDriver_OSVR : public vr::IServerTrackedDeviceProvider {
 public:
@@ -120,6 +122,17 @@ public:
 private:
     std::vector<std::unique_ptr<OSVRTrackedDevice>> trackedDevices_;
     std::unique_ptr<osvr::clientkit::ClientContext> context_;
+
+    /**
+     * Guards context_ while the tracking thread is running.
+     */
+    std::mutex contextMutex_;
+
+    /**
+     * Pumps context_ when the @c trackingMode setting is @c thread. When
+     * null, the context is pumped from RunFrame() instead.
+     */
+    std::unique_ptr<TrackingThread> trackingThread_;
 };
 
 #endif // INCLUDED_ServerDriver_OSVR_h_GUID_136B1359_C29D_4198_9CA0_1C223CC83B84
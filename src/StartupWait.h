@@ -0,0 +1,151 @@
+/** @file
+    @brief Waits for the OSVR context and display to start up, backing off
+    between updates.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_StartupWait_h_GUID_9EA8C9D1_E978_48D3_B5EA_3FA560AC90F6
+#define INCLUDED_StartupWait_h_GUID_9EA8C9D1_E978_48D3_B5EA_3FA560AC90F6
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::min
+#include <chrono>
+#include <cstddef>          // for std::size_t
+#include <thread>           // for std::this_thread::sleep_for
+#include <vector>
+
+/**
+ * @brief Runs the phases of startup in turn, each waiting for something to
+ * become ready while pumping whatever makes it so, all against one
+ * deadline.
+ *
+ * Between updates it sleeps, starting at a short delay and doubling it up to
+ * a limit, so a server that answers at once costs a few updates and a slow
+ * one doesn't keep a core busy. It records how long each phase took and how
+ * many updates it needed.
+ */
+class StartupWait {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * How one phase went.
+     */
+    struct Phase {
+        const char* name;
+        double seconds;             ///< from the start of the phase until it finished or gave up
+        std::size_t updates;        ///< times the phase's update was called
+        bool ready;                 ///< false if the deadline passed first
+    };
+
+    /**
+     * @param timeout how long all the phases together may take.
+     * @param first_delay the first sleep between updates.
+     * @param max_delay the longest sleep between updates.
+     */
+    explicit StartupWait(clock::duration timeout, clock::duration first_delay = std::chrono::microseconds(50), clock::duration max_delay = std::chrono::milliseconds(10)) :
+        start_(clock::now()), deadline_(start_ + timeout), firstDelay_(first_delay), maxDelay_(max_delay)
+    {
+        // do nothing
+    }
+
+    /**
+     * Calls @p update until @p ready returns true, sleeping between calls
+     * with @p sleep, which is given how long to sleep for.
+     *
+     * @return false if the deadline passed before @p ready returned true.
+     */
+    template <typename Ready, typename Update, typename Sleep>
+    bool wait(const char* name, Ready ready, Update update, Sleep sleep)
+    {
+        const auto phase_start = clock::now();
+        Phase phase = {name, 0.0, 0, false};
+        auto delay = firstDelay_;
+        while (true) {
+            if (ready()) {
+                phase.ready = true;
+                break;
+            }
+
+            const auto now = clock::now();
+            if (now >= deadline_)
+                break;
+
+            update();
+            ++phase.updates;
+            if (ready()) {
+                phase.ready = true;
+                break;
+            }
+
+            sleep(std::min(delay, deadline_ - clock::now()));
+            delay = std::min(delay * 2, maxDelay_);
+        }
+
+        phase.seconds = std::chrono::duration<double>(clock::now() - phase_start).count();
+        phases_.push_back(phase);
+        return phase.ready;
+    }
+
+    /**
+     * Like the other overload, sleeping the calling thread.
+     */
+    template <typename Ready, typename Update>
+    bool wait(const char* name, Ready ready, Update update)
+    {
+        return wait(name, ready, update, [](clock::duration delay) {
+            if (delay > clock::duration::zero())
+                std::this_thread::sleep_for(delay);
+        });
+    }
+
+    /**
+     * The phases run so far, in order.
+     */
+    const std::vector<Phase>& getPhases() const
+    {
+        return phases_;
+    }
+
+    /**
+     * Seconds since this was created.
+     */
+    double getElapsed() const
+    {
+        return std::chrono::duration<double>(clock::now() - start_).count();
+    }
+
+private:
+    clock::time_point start_;
+    clock::time_point deadline_;
+    clock::duration firstDelay_;
+    clock::duration maxDelay_;
+    std::vector<Phase> phases_;
+};
+
+#endif // INCLUDED_StartupWait_h_GUID_9EA8C9D1_E978_48D3_B5EA_3FA560AC90F6
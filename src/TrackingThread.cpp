@@ -0,0 +1,114 @@
+/** @file
+    @brief Background thread that pumps the OSVR client context.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TrackingThread.h"
+#include "Logging.h"                // for OSVR_LOG
+
+// Library/third-party includes
+#include <osvr/ClientKit/Context.h> // for osvr::clientkit::ClientContext
+
+// Standard includes
+#include <algorithm>                // for std::max
+#include <chrono>
+#include <exception>
+
+TrackingThread::TrackingThread(osvr::clientkit::ClientContext& context, std::mutex& context_mutex, double update_rate) : context_(context), contextMutex_(context_mutex), updateRate_(std::max(update_rate, 1.0))
+{
+    // do nothing
+}
+
+TrackingThread::~TrackingThread()
+{
+    stop();
+}
+
+void TrackingThread::start()
+{
+    if (isRunning())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(stopMutex_);
+        stopRequested_ = false;
+    }
+
+    OSVR_LOG(info) << "TrackingThread::start(): Updating the OSVR context at " << updateRate_ << " Hz.\n";
+    thread_ = std::thread(&TrackingThread::run, this);
+}
+
+void TrackingThread::stop()
+{
+    if (!isRunning())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(stopMutex_);
+        stopRequested_ = true;
+    }
+    stopCondition_.notify_all();
+
+    thread_.join();
+    OSVR_LOG(info) << "TrackingThread::stop(): Tracking thread stopped.\n";
+}
+
+bool TrackingThread::isRunning() const
+{
+    return thread_.joinable();
+}
+
+double TrackingThread::getUpdateRate() const
+{
+    return updateRate_;
+}
+
+void TrackingThread::run()
+{
+    using clock = std::chrono::steady_clock;
+    const auto period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / updateRate_));
+
+    auto next_update = clock::now();
+    std::unique_lock<std::mutex> stop_lock(stopMutex_);
+    while (!stopRequested_) {
+        stop_lock.unlock();
+        try {
+            // Tracker callbacks, and therefore TrackedDevicePoseUpdated(),
+            // run on this thread from within update().
+            std::lock_guard<std::mutex> context_lock(contextMutex_);
+            context_.update();
+        } catch (const std::exception& e) {
+            OSVR_LOG(err) << "TrackingThread::run(): Exception updating the OSVR context: " << e.what() << "\n";
+        }
+        stop_lock.lock();
+
+        // Keep to the requested rate, but don't try to catch up on updates we
+        // missed if an update ran long.
+        next_update += period;
+        const auto now = clock::now();
+        if (next_update < now)
+            next_update = now;
+
+        stopCondition_.wait_until(stop_lock, next_update, [this] { return stopRequested_; });
+    }
+}
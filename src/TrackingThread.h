@@ -0,0 +1,93 @@
+/** @file
+    @brief Background thread that pumps the OSVR client context.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TrackingThread_h_GUID_6F4378D4_89F8_48CF_B5E1_8990E7C2364C
+#define INCLUDED_TrackingThread_h_GUID_6F4378D4_89F8_48CF_B5E1_8990E7C2364C
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/ClientKit/Context.h>     // for osvr::clientkit::ClientContext
+
+// Standard includes
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Calls ClientContext::update() at a fixed rate on its own thread so
+ * that tracker callbacks (and therefore pose updates to the host) are not tied
+ * to how often the host calls RunFrame().
+ *
+ * The context is not thread-safe, so every update happens with @c
+ * context_mutex held. Anything else touching the context while the thread is
+ * running must hold the same mutex.
+ */
+class TrackingThread {
+public:
+    /**
+     * @param context the client context to pump.
+     * @param context_mutex the mutex guarding all access to @p context.
+     * @param update_rate the number of context updates per second.
+     */
+    TrackingThread(osvr::clientkit::ClientContext& context, std::mutex& context_mutex, double update_rate);
+
+    /**
+     * Stops the thread if it's still running.
+     */
+    ~TrackingThread();
+
+    TrackingThread(const TrackingThread&) = delete;
+    TrackingThread& operator=(const TrackingThread&) = delete;
+
+    /**
+     * Starts pumping the context. Does nothing if already running.
+     */
+    void start();
+
+    /**
+     * Stops pumping the context and waits for the thread to exit. Does nothing
+     * if not running.
+     */
+    void stop();
+
+    bool isRunning() const;
+
+    double getUpdateRate() const;
+
+private:
+    void run();
+
+    osvr::clientkit::ClientContext& context_;
+    std::mutex& contextMutex_;
+    const double updateRate_;
+
+    std::thread thread_;
+    std::mutex stopMutex_;
+    std::condition_variable stopCondition_;
+    bool stopRequested_ = false;
+};
+
+#endif // INCLUDED_TrackingThread_h_GUID_6F4378D4_89F8_48CF_B5E1_8990E7C2364C
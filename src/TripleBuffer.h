@@ -0,0 +1,108 @@
+/** @file
+    @brief Wait-free single-producer, single-consumer "latest value" slot.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TripleBuffer_h_GUID_2D42F95E_0774_47F2_9B25_29ED25C4E285
+#define INCLUDED_TripleBuffer_h_GUID_2D42F95E_0774_47F2_9B25_29ED25C4E285
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Hands the most recently published value from one writer thread to
+ * one reader thread without locks.
+ *
+ * Three copies of the value are kept: one owned by the writer, one owned by
+ * the reader, and one "middle" copy that is swapped between them. Both
+ * publish() and read() finish in a fixed number of steps regardless of what
+ * the other thread is doing, and the reader never observes a partially
+ * written value.
+ *
+ * Only one thread may call publish() and only one thread may call read() at a
+ * time.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : buffers_(), middle_(MiddleIndex)
+    {
+        // do nothing
+    }
+
+    explicit TripleBuffer(const T& initial_value) : TripleBuffer()
+    {
+        for (auto& buffer : buffers_) {
+            buffer = initial_value;
+        }
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * Makes @p value the newest value visible to the reader. Never blocks.
+     */
+    void publish(const T& value)
+    {
+        buffers_[writeIndex_] = value;
+        // Hand our freshly written buffer to the middle, flagging it as new,
+        // and take whatever buffer was there to write into next time.
+        const auto previous = middle_.exchange(writeIndex_ | FreshFlag, std::memory_order_acq_rel);
+        writeIndex_ = previous & IndexMask;
+    }
+
+    /**
+     * Returns the newest value published so far. Never blocks.
+     */
+    const T& read()
+    {
+        // Only swap when the writer has published something since our last
+        // read; otherwise the buffer we already hold is still the newest.
+        if (middle_.load(std::memory_order_relaxed) & FreshFlag) {
+            const auto previous = middle_.exchange(readIndex_, std::memory_order_acq_rel);
+            readIndex_ = previous & IndexMask;
+        }
+        return buffers_[readIndex_];
+    }
+
+private:
+    static const uint8_t IndexMask = 0x3;
+    static const uint8_t FreshFlag = 0x4;
+    static const uint8_t WriteIndex = 0;
+    static const uint8_t MiddleIndex = 1;
+    static const uint8_t ReadIndex = 2;
+
+    T buffers_[3];
+    std::atomic<uint8_t> middle_;
+    uint8_t writeIndex_ = WriteIndex; ///< touched by the writer thread only
+    uint8_t readIndex_ = ReadIndex;   ///< touched by the reader thread only
+};
+
+#endif // INCLUDED_TripleBuffer_h_GUID_2D42F95E_0774_47F2_9B25_29ED25C4E285
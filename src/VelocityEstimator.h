@@ -0,0 +1,146 @@
+/** @file
+    @brief Estimates linear and angular velocity from successive poses.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_VelocityEstimator_h_GUID_64C0C8E3_7EFE_45B2_864E_E91539C388CD
+#define INCLUDED_VelocityEstimator_h_GUID_64C0C8E3_7EFE_45B2_864E_E91539C388CD
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <algorithm>        // for std::min, std::max
+
+/**
+ * @brief Derives linear and angular velocity by finite differences between
+ * successive pose samples, smoothed with an exponential moving average.
+ *
+ * Both velocities are expressed in the same (world) frame as the poses
+ * themselves. Angular velocity is in axis-angle form: the direction is the
+ * axis of rotation and the magnitude is the rate in radians per second.
+ */
+class VelocityEstimator {
+public:
+    /**
+     * @param smoothing how much of the previous estimate to keep with each new
+     * sample, in [0, 1). Zero uses the raw finite difference.
+     */
+    explicit VelocityEstimator(double smoothing = 0.5)
+    {
+        setSmoothing(smoothing);
+    }
+
+    void setSmoothing(double smoothing)
+    {
+        smoothing_ = std::min(std::max(smoothing, 0.0), 0.99);
+    }
+
+    double getSmoothing() const
+    {
+        return smoothing_;
+    }
+
+    /**
+     * Forgets all previous samples. The velocities are zero until two more
+     * samples have been added.
+     */
+    void reset()
+    {
+        haveSample_ = false;
+        linearVelocity_.setZero();
+        angularVelocity_.setZero();
+    }
+
+    /**
+     * Adds the pose sampled at @p time (in seconds) and updates the
+     * velocity estimates.
+     */
+    void addSample(double time, const Eigen::Vector3d& position, const Eigen::Quaterniond& orientation)
+    {
+        const double dt = time - lastTime_;
+        if (!haveSample_ || dt <= 0.0 || dt > MaxSampleInterval) {
+            // Out-of-order sample or a gap in tracking: the difference
+            // wouldn't mean anything, so start over from this sample.
+            if (haveSample_ && dt <= 0.0 && dt > -MaxSampleInterval)
+                return;
+
+            linearVelocity_.setZero();
+            angularVelocity_.setZero();
+            store(time, position, orientation);
+            return;
+        }
+
+        const Eigen::Vector3d linear = (position - lastPosition_) / dt;
+
+        // Rotation that takes the previous orientation to the current one,
+        // flipped if needed so we take the short way around.
+        Eigen::Quaterniond delta = orientation * lastOrientation_.conjugate();
+        if (delta.w() < 0.0)
+            delta.coeffs() = -delta.coeffs();
+        const Eigen::AngleAxisd delta_angle_axis(delta.normalized());
+        const Eigen::Vector3d angular = delta_angle_axis.axis() * (delta_angle_axis.angle() / dt);
+
+        const double gain = 1.0 - smoothing_;
+        linearVelocity_ += gain * (linear - linearVelocity_);
+        angularVelocity_ += gain * (angular - angularVelocity_);
+
+        store(time, position, orientation);
+    }
+
+    const Eigen::Vector3d& getLinearVelocity() const
+    {
+        return linearVelocity_;
+    }
+
+    const Eigen::Vector3d& getAngularVelocity() const
+    {
+        return angularVelocity_;
+    }
+
+private:
+    /// Samples further apart than this (in seconds) are treated as a gap.
+    static constexpr double MaxSampleInterval = 0.1;
+
+    void store(double time, const Eigen::Vector3d& position, const Eigen::Quaterniond& orientation)
+    {
+        haveSample_ = true;
+        lastTime_ = time;
+        lastPosition_ = position;
+        lastOrientation_ = orientation;
+    }
+
+    double smoothing_ = 0.5;
+
+    bool haveSample_ = false;
+    double lastTime_ = 0.0;
+    Eigen::Vector3d lastPosition_ = Eigen::Vector3d::Zero();
+    Eigen::Quaternion<double, Eigen::DontAlign> lastOrientation_ = Eigen::Quaterniond::Identity();
+
+    Eigen::Vector3d linearVelocity_ = Eigen::Vector3d::Zero();
+    Eigen::Vector3d angularVelocity_ = Eigen::Vector3d::Zero();
+};
+
+#endif // INCLUDED_VelocityEstimator_h_GUID_64C0C8E3_7EFE_45B2_864E_E91539C388CD
@@ -0,0 +1,146 @@
+/** @file
+    @brief Measures the per-report cost of each pose filter.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseFilter.h"
+
+// Library/third-party includes
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <chrono>
+#include <cmath>
+#include <cstdlib>                      // for EXIT_SUCCESS, std::strtoul
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// Tracker report rate, in Hz
+const double ReportRate = 1000.0;
+
+/**
+ * A head pose as tracked (with noise) and as it really was.
+ */
+struct Report {
+    double time;
+    Eigen::Vector3d measuredPosition;
+    Eigen::Quaterniond measuredOrientation;
+    Eigen::Vector3d truePosition;
+    Eigen::Quaterniond trueOrientation;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/**
+ * Makes a head that sways and turns slowly, tracked with about 0.5 mm and
+ * 0.1 degree of jitter.
+ */
+std::vector<Report, Eigen::aligned_allocator<Report>> makeReports(std::size_t count)
+{
+    std::mt19937 rng(42);
+    std::normal_distribution<double> position_noise(0.0, 0.0005);
+    std::normal_distribution<double> angle_noise(0.0, 0.1 * 3.14159265358979323846 / 180.0);
+
+    std::vector<Report, Eigen::aligned_allocator<Report>> reports(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& report = reports[i];
+        report.time = 1000.0 + static_cast<double>(i) / ReportRate;
+        const double t = report.time;
+        report.truePosition = Eigen::Vector3d(0.1 * std::sin(0.7 * t), 1.7 + 0.02 * std::sin(1.3 * t), 0.05 * std::cos(0.5 * t));
+        report.trueOrientation = Eigen::AngleAxisd(0.8 * std::sin(0.9 * t), Eigen::Vector3d::UnitY()) * Eigen::AngleAxisd(0.2 * std::sin(0.4 * t), Eigen::Vector3d::UnitX());
+
+        report.measuredPosition = report.truePosition + Eigen::Vector3d(position_noise(rng), position_noise(rng), position_noise(rng));
+        const Eigen::Vector3d jitter(angle_noise(rng), angle_noise(rng), angle_noise(rng));
+        report.measuredOrientation = Eigen::AngleAxisd(jitter.norm(), jitter.normalized()) * report.trueOrientation;
+    }
+    return reports;
+}
+
+double angleBetween(const Eigen::Quaterniond& a, const Eigen::Quaterniond& b)
+{
+    return Eigen::AngleAxisd((a * b.conjugate()).normalized()).angle();
+}
+
+/**
+ * Runs every report through @p chain and prints the time per report and the
+ * remaining error against the true pose.
+ */
+void run(const std::string& label, PoseFilterChain& chain, const std::vector<Report, Eigen::aligned_allocator<Report>>& reports)
+{
+    std::vector<Eigen::Vector3d, Eigen::aligned_allocator<Eigen::Vector3d>> positions(reports.size());
+    std::vector<Eigen::Quaterniond, Eigen::aligned_allocator<Eigen::Quaterniond>> orientations(reports.size());
+
+    chain.reset();
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    for (std::size_t i = 0; i < reports.size(); ++i) {
+        positions[i] = reports[i].measuredPosition;
+        orientations[i] = reports[i].measuredOrientation;
+        chain.filter(reports[i].time, positions[i], orientations[i]);
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+
+    // Skip the first second while the filters settle.
+    double position_error = 0.0;
+    double angle_error = 0.0;
+    std::size_t counted = 0;
+    for (std::size_t i = static_cast<std::size_t>(ReportRate); i < reports.size(); ++i) {
+        position_error += (positions[i] - reports[i].truePosition).squaredNorm();
+        const double angle = angleBetween(orientations[i], reports[i].trueOrientation);
+        angle_error += angle * angle;
+        ++counted;
+    }
+    if (counted > 0) {
+        position_error = std::sqrt(position_error / counted);
+        angle_error = std::sqrt(angle_error / counted);
+    }
+
+    std::cout << std::left << std::setw(28) << label << std::right
+              << std::setw(10) << std::fixed << std::setprecision(1) << elapsed / reports.size() << " ns/report"
+              << std::setw(10) << std::setprecision(3) << position_error * 1000.0 << " mm RMS"
+              << std::setw(10) << std::setprecision(3) << angle_error * 180.0 / 3.14159265358979323846 << " deg RMS" << std::endl;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const std::size_t num_reports = (argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const auto reports = makeReports(num_reports);
+
+    std::cout << "Filtering " << num_reports << " reports at " << ReportRate << " Hz..." << std::endl;
+
+    const char* const configurations[] = { "", "exponential", "oneEuro", "kalman", "oneEuro,kalman", "oneEuro,exponential,kalman" };
+    for (const auto& configuration : configurations) {
+        PoseFilterChain chain;
+        chain.setStages(configuration);
+        run(*configuration ? configuration : "(unfiltered)", chain, reports);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -101,18 +101,21 @@ enum class Rotation {
 struct Display {
     DisplayAdapter adapter;
     std::string name;
+    std::string connector;          ///< the port it's plugged into, such as "HDMI-A-1", if known
     DisplaySize size;
     DisplayPosition position;
     Rotation rotation;
-    double verticalRefreshRate;
+    double verticalRefreshRate;     ///< in Hz; 0 if not known
     bool attachedToDesktop;
     uint32_t edidVendorId;
     uint32_t edidProductId;
+    uint32_t edidSerialNumber;      ///< 0 if not known
 
     bool operator==(const Display& other) const
     {
         if (adapter != other.adapter) return false;
         if (name != other.name) return false;
+        if (connector != other.connector) return false;
         if (size != other.size) return false;
         if (position != other.position) return false;
         if (rotation != other.rotation) return false;
@@ -120,6 +123,7 @@ struct Display {
         if (attachedToDesktop != other.attachedToDesktop) return false;
         if (edidProductId != other.edidProductId) return false;
         if (edidVendorId != other.edidVendorId) return false;
+        if (edidSerialNumber != other.edidSerialNumber) return false;
 
         return true;
     }
@@ -29,6 +29,7 @@
 // Internal Includes
 #include "DisplayEnumerator.h"
 #include "Display.h"
+#include "DrmDisplays.h"
 
 // Library/third-party includes
 // - none
@@ -41,7 +42,7 @@ namespace display {
 
 std::vector<Display> getDisplays()
 {
-    return {};
+    return getDrmDisplays("/sys/class/drm");
 }
 
 } // end namespace display
@@ -158,7 +158,7 @@ namespace {
 
     Display getDisplay(const DISPLAYCONFIG_PATH_INFO& path_info, const ModeInfoList& mode_info)
     {
-        Display display;
+        Display display = {};
         display.adapter = getDisplayAdapter(path_info, mode_info);
         display.name = getMonitorName(path_info);
         display.size = getCurrentResolution(path_info, mode_info);
@@ -0,0 +1,170 @@
+/** @file
+    @brief Keeps the list of displays current as they're plugged in, unplugged
+    or reconfigured.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DisplayMonitor.h"
+#include "DisplayEnumerator.h"
+
+// Library/third-party includes
+#include <osvr/Util/PlatformConfig.h>
+
+// Standard includes
+#include <exception>
+#include <string>
+#include <utility>          // for std::move
+#include <vector>
+
+// Each of these defines DisplayMonitor::Watcher, which blocks in wait() until
+// the displays may have changed, returning false once stop() is called.
+#if defined(OSVR_WINDOWS)
+#include "DisplayMonitor_Windows.h"
+#elif defined(OSVR_LINUX)
+#include "DisplayMonitor_Linux.h"
+#else
+#include "DisplayMonitor_Polling.h"
+#endif
+
+namespace osvr {
+namespace display {
+
+DisplayMonitor::DisplayMonitor(Enumerator enumerate, bool watch) : enumerate_(std::move(enumerate))
+{
+    // start() reads the displays before it starts watching them.
+    if (watch) {
+        start();
+    } else {
+        refresh();
+    }
+}
+
+DisplayMonitor::~DisplayMonitor()
+{
+    stop();
+}
+
+DisplayMonitor& DisplayMonitor::instance()
+{
+    static DisplayMonitor monitor(&osvr::display::getDisplays);
+    return monitor;
+}
+
+void DisplayMonitor::start()
+{
+    std::lock_guard<std::mutex> lock(watchMutex_);
+    if (watcher_)
+        return;
+
+    // Read the displays first, catching up on anything that changed while we
+    // weren't watching.
+    refresh();
+    watcher_.reset(new Watcher);
+    thread_ = std::thread(&DisplayMonitor::watch, this, watcher_.get());
+}
+
+void DisplayMonitor::stop()
+{
+    std::lock_guard<std::mutex> lock(watchMutex_);
+    if (!watcher_)
+        return;
+
+    watcher_->stop();
+    thread_.join();
+    watcher_.reset();
+}
+
+bool DisplayMonitor::isWatching() const
+{
+    std::lock_guard<std::mutex> lock(watchMutex_);
+    return static_cast<bool>(watcher_);
+}
+
+uint64_t DisplayMonitor::getGeneration() const
+{
+    return generation_.load(std::memory_order_acquire);
+}
+
+std::vector<Display> DisplayMonitor::getDisplays(uint64_t* generation) const
+{
+    std::lock_guard<std::mutex> lock(displaysMutex_);
+    if (generation) {
+        *generation = generation_.load(std::memory_order_relaxed);
+    }
+    return displays_;
+}
+
+bool DisplayMonitor::refresh()
+{
+    std::vector<Display> displays;
+    try {
+        displays = enumerate_();
+    } catch (const std::exception& e) {
+        // Keep the last list we had rather than pretend every display is gone
+        const std::string error = std::string("Unable to enumerate displays: ") + e.what();
+        {
+            std::lock_guard<std::mutex> lock(displaysMutex_);
+            error_ = error;
+        }
+        ErrorHandler handler;
+        {
+            std::lock_guard<std::mutex> lock(errorHandlerMutex_);
+            handler = errorHandler_;
+        }
+        if (handler) {
+            handler(error);
+        }
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(displaysMutex_);
+    error_.clear();
+    if (generation_.load(std::memory_order_relaxed) != 0 && displays == displays_)
+        return false;
+
+    displays_ = std::move(displays);
+    generation_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+void DisplayMonitor::setErrorHandler(ErrorHandler handler)
+{
+    std::lock_guard<std::mutex> lock(errorHandlerMutex_);
+    errorHandler_ = std::move(handler);
+}
+
+std::string DisplayMonitor::getError() const
+{
+    std::lock_guard<std::mutex> lock(displaysMutex_);
+    return error_;
+}
+
+void DisplayMonitor::watch(Watcher* watcher)
+{
+    while (watcher->wait()) {
+        refresh();
+    }
+}
+
+} // end namespace display
+} // end namespace osvr
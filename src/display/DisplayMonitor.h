@@ -0,0 +1,149 @@
+/** @file
+    @brief Keeps the list of displays current as they're plugged in, unplugged
+    or reconfigured.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DisplayMonitor_h_GUID_6DC66783_41BD_48D2_8B78_3FD3332B4630
+#define INCLUDED_DisplayMonitor_h_GUID_6DC66783_41BD_48D2_8B78_3FD3332B4630
+
+// Internal Includes
+#include "Display.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>           // for std::unique_ptr
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace osvr {
+namespace display {
+
+/**
+ * @brief Holds the list of displays, re-reading it only when the operating
+ * system says something changed.
+ *
+ * A background thread waits for display change notifications (DRM uevents on
+ * Linux, WM_DISPLAYCHANGE on Windows) and re-enumerates when one arrives.
+ * Where there are no notifications it checks every few seconds instead. Each
+ * time the list actually changes, the generation goes up, so callers can keep
+ * anything they derive from the list until then.
+ */
+class DisplayMonitor {
+public:
+    using Enumerator = std::function<std::vector<Display>()>;
+    using ErrorHandler = std::function<void(const std::string&)>;
+
+    /**
+     * Reads the displays with @p enumerate, then re-reads them whenever
+     * they change if @p watch is set.
+     */
+    explicit DisplayMonitor(Enumerator enumerate, bool watch = true);
+
+    /**
+     * Stops watching, if stop() hasn't already.
+     */
+    ~DisplayMonitor();
+
+    DisplayMonitor(const DisplayMonitor&) = delete;
+    DisplayMonitor& operator=(const DisplayMonitor&) = delete;
+
+    /**
+     * The monitor shared by the whole driver, watching the real displays.
+     * It's started on first use, and stopped by the driver's Cleanup() rather
+     * than left to static destruction.
+     */
+    static DisplayMonitor& instance();
+
+    /**
+     * Starts watching for changes, if not already watching.
+     */
+    void start();
+
+    /**
+     * Stops watching and waits for the watching thread to finish. The last
+     * list read stays available, and refresh() still works.
+     */
+    void stop();
+
+    bool isWatching() const;
+
+    /**
+     * Goes up by one every time the list of displays changes. Cheap enough to
+     * call on every request.
+     */
+    uint64_t getGeneration() const;
+
+    /**
+     * Returns the current displays, and optionally the generation they
+     * belong to.
+     */
+    std::vector<Display> getDisplays(uint64_t* generation = nullptr) const;
+
+    /**
+     * Re-reads the displays now, returning true if they changed. If they
+     * can't be read, the last list is kept and the error is passed to the
+     * error handler and available from getError().
+     */
+    bool refresh();
+
+    /**
+     * Has @p handler called with a description of each failure to read the
+     * displays, on whichever thread read them. Pass an empty handler to
+     * stop.
+     */
+    void setErrorHandler(ErrorHandler handler);
+
+    /**
+     * Describes why the displays couldn't be read last time, or is empty if
+     * they could.
+     */
+    std::string getError() const;
+
+private:
+    class Watcher;
+
+    void watch(Watcher* watcher);
+
+    Enumerator enumerate_;
+    mutable std::mutex watchMutex_;     ///< guards watcher_ and thread_
+    mutable std::mutex displaysMutex_;  ///< guards displays_ and error_
+    std::vector<Display> displays_;
+    std::string error_;
+    mutable std::mutex errorHandlerMutex_;
+    ErrorHandler errorHandler_;
+    std::atomic<uint64_t> generation_{0};
+    std::unique_ptr<Watcher> watcher_;
+    std::thread thread_;
+};
+
+} // end namespace display
+} // end namespace osvr
+
+#endif // INCLUDED_DisplayMonitor_h_GUID_6DC66783_41BD_48D2_8B78_3FD3332B4630
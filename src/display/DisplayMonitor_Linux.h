@@ -0,0 +1,173 @@
+/** @file
+    @brief Waits for DRM uevents from the kernel, which arrive whenever a
+    display connector changes.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DisplayMonitor_Linux_h_GUID_DE7A0925_B35A_4DD8_A409_EFBF8863C628
+#define INCLUDED_DisplayMonitor_Linux_h_GUID_DE7A0925_B35A_4DD8_A409_EFBF8863C628
+
+// Internal Includes
+#include "DisplayMonitor.h"
+
+// Library/third-party includes
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Standard includes
+#include <algorithm>        // for std::min, std::max
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>          // for std::memset, std::strcmp
+#include <thread>           // for std::this_thread::sleep_for
+
+namespace osvr {
+namespace display {
+
+/**
+ * Listens on the kernel's uevent netlink socket, which unprivileged processes
+ * may read. If it can't be opened, this falls back to checking every few
+ * seconds. stop() wakes wait() through an eventfd; if that can't be made
+ * either, or poll() fails, wait() checks for stop() every 100 ms instead.
+ */
+class DisplayMonitor::Watcher {
+public:
+    Watcher()
+    {
+        stopEvent_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        socket_ = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+        if (socket_ >= 0) {
+            sockaddr_nl address;
+            std::memset(&address, 0, sizeof(address));
+            address.nl_family = AF_NETLINK;
+            address.nl_groups = 1; // kernel uevents
+            if (::bind(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+                ::close(socket_);
+                socket_ = -1;
+            }
+        }
+    }
+
+    ~Watcher()
+    {
+        if (socket_ >= 0)
+            ::close(socket_);
+        if (stopEvent_ >= 0)
+            ::close(stopEvent_);
+    }
+
+    bool wait()
+    {
+        using clock = std::chrono::steady_clock;
+        const auto next_check = clock::now() + std::chrono::milliseconds(PollingIntervalMs);
+        for (;;) {
+            if (stopped_.load(std::memory_order_acquire))
+                return false;
+
+            // Without the socket, wake up for the next check; without the
+            // eventfd, wake up often enough to notice stop().
+            int timeout_ms = -1;
+            if (socket_ < 0) {
+                const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(next_check - clock::now()).count();
+                timeout_ms = static_cast<int>(std::max<decltype(remaining)>(remaining, 0));
+            }
+            if (stopEvent_ < 0) {
+                timeout_ms = (timeout_ms < 0) ? StopCheckIntervalMs : std::min(timeout_ms, StopCheckIntervalMs);
+            }
+
+            // poll() skips negative descriptors, so either may be missing.
+            pollfd fds[2] = {};
+            fds[0].fd = stopEvent_;
+            fds[0].events = POLLIN;
+            fds[1].fd = socket_;
+            fds[1].events = POLLIN;
+
+            const int ready = ::poll(fds, 2, timeout_ms);
+            if (ready < 0 && EINTR != errno) {
+                // Carry on with timed checks rather than stop watching.
+                std::this_thread::sleep_for(std::chrono::milliseconds(StopCheckIntervalMs));
+            }
+            if (fds[0].revents || stopped_.load(std::memory_order_acquire))
+                return false;
+            if (socket_ < 0 && clock::now() >= next_check)
+                return true;
+            if (ready > 0 && fds[1].revents && drainDrmEvents())
+                return true;
+        }
+    }
+
+    void stop()
+    {
+        stopped_.store(true, std::memory_order_release);
+        const uint64_t one = 1;
+        if (stopEvent_ >= 0 && ::write(stopEvent_, &one, sizeof(one)) < 0) {
+            // The event is already signalled
+        }
+    }
+
+private:
+    /**
+     * Reads every queued uevent, returning true if any came from the DRM
+     * subsystem. A single hotplug sends several, which this folds into one
+     * refresh.
+     */
+    bool drainDrmEvents()
+    {
+        bool drm = false;
+        char message[4096];
+        for (;;) {
+            const ssize_t size = ::recv(socket_, message, sizeof(message) - 1, 0);
+            if (size <= 0)
+                return drm;
+
+            // The message is a header line, then null-separated KEY=value pairs
+            message[size] = '\0';
+            for (ssize_t offset = 0; offset < size; offset += static_cast<ssize_t>(std::strlen(message + offset)) + 1) {
+                if (0 == std::strcmp(message + offset, "SUBSYSTEM=drm")) {
+                    drm = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    /// How often to re-read the displays without uevents
+    static const int PollingIntervalMs = 2000;
+
+    /// How often to check for stop() without an eventfd
+    static const int StopCheckIntervalMs = 100;
+
+    int socket_ = -1;
+    int stopEvent_ = -1;
+    std::atomic<bool> stopped_{false};
+};
+
+} // end namespace display
+} // end namespace osvr
+
+#endif // INCLUDED_DisplayMonitor_Linux_h_GUID_DE7A0925_B35A_4DD8_A409_EFBF8863C628
@@ -0,0 +1,70 @@
+/** @file
+    @brief Checks the displays for changes on a timer, where there are no
+    change notifications to wait for.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DisplayMonitor_Polling_h_GUID_1B46DF49_0047_4796_A3A0_C4889E5FD55E
+#define INCLUDED_DisplayMonitor_Polling_h_GUID_1B46DF49_0047_4796_A3A0_C4889E5FD55E
+
+// Internal Includes
+#include "DisplayMonitor.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace osvr {
+namespace display {
+
+class DisplayMonitor::Watcher {
+public:
+    bool wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stopped_.wait_for(lock, std::chrono::seconds(2), [this] { return stop_; });
+        return !stop_;
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        stopped_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable stopped_;
+    bool stop_ = false;
+};
+
+} // end namespace display
+} // end namespace osvr
+
+#endif // INCLUDED_DisplayMonitor_Polling_h_GUID_1B46DF49_0047_4796_A3A0_C4889E5FD55E
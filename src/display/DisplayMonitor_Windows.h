@@ -0,0 +1,139 @@
+/** @file
+    @brief Waits for WM_DISPLAYCHANGE, which Windows sends to top-level
+    windows whenever the display configuration changes.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DisplayMonitor_Windows_h_GUID_03C713B9_ABBD_4705_807A_3839B2D05268
+#define INCLUDED_DisplayMonitor_Windows_h_GUID_03C713B9_ABBD_4705_807A_3839B2D05268
+
+// Internal Includes
+#include "DisplayMonitor.h"
+
+// Library/third-party includes
+#include <Windows.h>
+
+// Standard includes
+#include <atomic>
+
+namespace osvr {
+namespace display {
+
+/**
+ * Owns a hidden window, created on the watching thread, and pumps its
+ * messages there. Broadcasts such as WM_DISPLAYCHANGE only reach top-level
+ * windows, so this can't be a message-only window.
+ *
+ * The window class belongs to the module this code is in, not the host
+ * process, and is unregistered along with the window, so that the driver can
+ * be unloaded and loaded again.
+ */
+class DisplayMonitor::Watcher {
+public:
+    bool wait()
+    {
+        if (!window_) {
+            window_ = createWindow();
+
+            // Make sure this thread has a message queue before stop() can
+            // post to it.
+            MSG message;
+            ::PeekMessageW(&message, nullptr, WM_USER, WM_USER, PM_NOREMOVE);
+            threadId_ = ::GetCurrentThreadId();
+        }
+
+        MSG message;
+        while (!stop_ && ::GetMessageW(&message, nullptr, 0, 0) > 0) {
+            if (DisplaysChanged == message.message)
+                return true;
+            ::DispatchMessageW(&message);
+        }
+
+        // Only the thread that made the window may destroy it
+        if (window_) {
+            ::DestroyWindow(window_);
+            window_ = nullptr;
+            ::UnregisterClassW(getClassName(), getModule());
+        }
+        return false;
+    }
+
+    void stop()
+    {
+        stop_ = true;
+        // Wakes GetMessageW(); if the thread hasn't published its message
+        // queue yet, it sees stop_ before it waits.
+        const DWORD thread_id = threadId_;
+        if (thread_id)
+            ::PostThreadMessageW(thread_id, WM_QUIT, 0, 0);
+    }
+
+private:
+    static const wchar_t* getClassName()
+    {
+        return L"OSVRDisplayMonitor";
+    }
+
+    /**
+     * The module (the driver DLL, or the test program) this code is in.
+     */
+    static HMODULE getModule()
+    {
+        HMODULE module = nullptr;
+        ::GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, reinterpret_cast<LPCWSTR>(&Watcher::windowProc), &module);
+        return module;
+    }
+
+    HWND createWindow()
+    {
+        WNDCLASSW window_class = {};
+        window_class.lpfnWndProc = &Watcher::windowProc;
+        window_class.hInstance = getModule();
+        window_class.lpszClassName = getClassName();
+        ::RegisterClassW(&window_class);
+
+        return ::CreateWindowW(getClassName(), L"", 0, 0, 0, 0, 0, nullptr, nullptr, window_class.hInstance, nullptr);
+    }
+
+    static LRESULT CALLBACK windowProc(HWND window, UINT message, WPARAM wparam, LPARAM lparam)
+    {
+        // WM_DISPLAYCHANGE is sent, not posted, so it's handled inside
+        // GetMessageW() without making it return. Post ourselves a message
+        // that will.
+        if (WM_DISPLAYCHANGE == message) {
+            ::PostMessageW(window, DisplaysChanged, 0, 0);
+            return 0;
+        }
+        return ::DefWindowProcW(window, message, wparam, lparam);
+    }
+
+    static const UINT DisplaysChanged = WM_APP + 1;
+
+    HWND window_ = nullptr;
+    std::atomic<DWORD> threadId_{0};
+    std::atomic<bool> stop_{false};
+};
+
+} // end namespace display
+} // end namespace osvr
+
+#endif // INCLUDED_DisplayMonitor_Windows_h_GUID_03C713B9_ABBD_4705_807A_3839B2D05268
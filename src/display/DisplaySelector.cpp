@@ -0,0 +1,293 @@
+/** @file
+    @brief Picks the HMD out of the connected displays.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DisplaySelector.h"
+#include "Display.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <cstdlib>          // for std::strtoul
+#include <initializer_list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace display {
+
+namespace {
+
+    /**
+     * Splits a comma-separated list, trimming surrounding whitespace and
+     * dropping empty entries.
+     */
+    std::vector<std::string> splitList(const std::string& list)
+    {
+        std::vector<std::string> entries;
+        std::istringstream stream(list);
+        std::string entry;
+        while (std::getline(stream, entry, ',')) {
+            const auto first = entry.find_first_not_of(" \t");
+            if (std::string::npos == first)
+                continue;
+            const auto last = entry.find_last_not_of(" \t");
+            entries.push_back(entry.substr(first, last - first + 1));
+        }
+        return entries;
+    }
+
+    /**
+     * Reads a decimal or 0x-prefixed hex number that makes up the whole of
+     * @p text.
+     */
+    bool parseNumber(const std::string& text, uint32_t& value)
+    {
+        if (text.empty())
+            return false;
+        char* end = nullptr;
+        const unsigned long number = std::strtoul(text.c_str(), &end, 0);
+        if (*end != '\0' || number > 0xffffffffUL)
+            return false;
+        value = static_cast<uint32_t>(number);
+        return true;
+    }
+
+} // end anonymous namespace
+
+DisplaySelector::DisplaySelector() : priority_{Criterion::Edid, Criterion::Connector, Criterion::Name}, priorityList_("edid,connector,name")
+{
+    // do nothing
+}
+
+void DisplaySelector::addEdid(uint32_t vendor_id, uint32_t product_id, uint32_t serial_number)
+{
+    edids_.emplace(makeEdidKey(vendor_id, product_id), serial_number);
+    invalidate();
+}
+
+std::string DisplaySelector::setEdids(const std::string& edids)
+{
+    if (edids == edidList_)
+        return "";
+    edids_.clear();
+    edidList_ = edids;
+    invalidate();
+
+    std::string unknown;
+    for (const auto& entry : splitList(edids)) {
+        std::vector<std::string> fields;
+        std::istringstream stream(entry);
+        std::string field;
+        while (std::getline(stream, field, ':'))
+            fields.push_back(field);
+
+        uint32_t ids[3] = {0, 0, 0};
+        bool valid = (fields.size() == 2 || fields.size() == 3);
+        for (std::size_t i = 0; valid && i < fields.size(); ++i)
+            valid = parseNumber(fields[i], ids[i]);
+
+        if (valid) {
+            addEdid(ids[0], ids[1], ids[2]);
+        } else {
+            unknown += (unknown.empty() ? "" : ",") + entry;
+        }
+    }
+    return unknown;
+}
+
+void DisplaySelector::setConnector(const std::string& connector)
+{
+    if (connector == connector_)
+        return;
+    connector_ = connector;
+    invalidate();
+}
+
+void DisplaySelector::setNamePattern(const std::string& pattern)
+{
+    if (pattern == namePattern_)
+        return;
+    namePattern_ = pattern;
+    nameHasWildcards_ = (std::string::npos != pattern.find_first_of("*?"));
+    invalidate();
+}
+
+std::string DisplaySelector::setPriority(const std::string& priority)
+{
+    if (priority == priorityList_)
+        return "";
+    priority_.clear();
+    priorityList_ = priority;
+
+    std::string unknown;
+    for (const auto& name : splitList(priority)) {
+        bool found = false;
+        for (const auto criterion : {Criterion::Edid, Criterion::Connector, Criterion::Name}) {
+            if (name == getName(criterion)) {
+                priority_.push_back(criterion);
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            unknown += (unknown.empty() ? "" : ",") + name;
+        }
+    }
+
+    invalidate();
+    return unknown;
+}
+
+int DisplaySelector::select(const std::vector<Display>& displays, uint64_t generation)
+{
+    if (generation != 0 && generation == generation_)
+        return selected_;
+
+    // One pass, keeping the first display with the best rank
+    selected_ = -1;
+    std::size_t best_rank = priority_.size();
+    for (std::size_t i = 0; i < displays.size() && best_rank > 0; ++i) {
+        const std::size_t display_rank = rank(displays[i]);
+        if (display_rank < best_rank) {
+            best_rank = display_rank;
+            selected_ = static_cast<int>(i);
+        }
+    }
+    if (selected_ >= 0) {
+        matched_ = priority_[best_rank];
+    }
+
+    generation_ = generation;
+    return selected_;
+}
+
+DisplaySelector::Criterion DisplaySelector::getMatchedCriterion() const
+{
+    return matched_;
+}
+
+const char* DisplaySelector::getName(Criterion criterion)
+{
+    switch (criterion) {
+    case Criterion::Edid:
+        return "edid";
+    case Criterion::Connector:
+        return "connector";
+    case Criterion::Name:
+        return "name";
+    }
+    return "";
+}
+
+std::size_t DisplaySelector::rank(const Display& display) const
+{
+    for (std::size_t i = 0; i < priority_.size(); ++i) {
+        switch (priority_[i]) {
+        case Criterion::Edid: {
+            const auto range = edids_.equal_range(makeEdidKey(display.edidVendorId, display.edidProductId));
+            for (auto it = range.first; it != range.second; ++it) {
+                if (0 == it->second || display.edidSerialNumber == it->second)
+                    return i;
+            }
+            break;
+        }
+        case Criterion::Connector:
+            if (!connector_.empty() && display.connector == connector_)
+                return i;
+            break;
+        case Criterion::Name:
+            if (namePattern_.empty())
+                break;
+            if (nameHasWildcards_ ? matchesWildcard(namePattern_, display.name) : std::string::npos != display.name.find(namePattern_))
+                return i;
+            break;
+        }
+    }
+    return priority_.size();
+}
+
+void DisplaySelector::invalidate()
+{
+    generation_ = 0;
+    selected_ = -1;
+}
+
+uint64_t DisplaySelector::makeEdidKey(uint32_t vendor_id, uint32_t product_id)
+{
+    return (static_cast<uint64_t>(vendor_id) << 32) | product_id;
+}
+
+bool matchesWildcard(const std::string& pattern, const std::string& text)
+{
+    // Greedy, backing up to the last star on a mismatch: linear for the
+    // patterns people write, and never recursive.
+    std::size_t p = 0, t = 0;
+    std::size_t star = std::string::npos, star_text = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && ('?' == pattern[p] || pattern[p] == text[t])) {
+            ++p;
+            ++t;
+        } else if (p < pattern.size() && '*' == pattern[p]) {
+            star = p++;
+            star_text = t;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            t = ++star_text;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && '*' == pattern[p])
+        ++p;
+    return p == pattern.size();
+}
+
+int findDisplay(const std::vector<Display>& displays, const Display& display)
+{
+    const bool have_edid = (display.edidVendorId != 0 || display.edidProductId != 0);
+    for (std::size_t i = 0; i < displays.size(); ++i) {
+        const Display& candidate = displays[i];
+        if (!display.connector.empty() && candidate.connector != display.connector)
+            continue;
+        if (have_edid) {
+            if (candidate.edidVendorId != display.edidVendorId || candidate.edidProductId != display.edidProductId)
+                continue;
+            if (display.edidSerialNumber != 0 && candidate.edidSerialNumber != 0 && candidate.edidSerialNumber != display.edidSerialNumber)
+                continue;
+        }
+        if (display.connector.empty() && !have_edid && (candidate.name != display.name || candidate.adapter != display.adapter))
+            continue;
+
+        return static_cast<int>(i);
+    }
+    return -1;
+}
+
+} // end namespace display
+} // end namespace osvr
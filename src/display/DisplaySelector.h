@@ -0,0 +1,153 @@
+/** @file
+    @brief Picks the HMD out of the connected displays.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DisplaySelector_h_GUID_63DF9BCB_BC1F_4D0F_90F2_AAD20F60E167
+#define INCLUDED_DisplaySelector_h_GUID_63DF9BCB_BC1F_4D0F_90F2_AAD20F60E167
+
+// Internal Includes
+#include "Display.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace osvr {
+namespace display {
+
+/**
+ * Picks a display by what identifies it: its EDID IDs, the connector it's
+ * plugged into or its name, tried in a configurable order.
+ *
+ * The wanted identities are indexed, so checking a display costs a hash
+ * lookup per criterion however many are configured, and the choice is
+ * remembered until the display list changes. Setting a criterion to what it
+ * already was keeps that choice, so reapplying unchanged settings is free.
+ */
+class DisplaySelector {
+public:
+    enum class Criterion {
+        Edid,       ///< vendor and product ID, and serial number if given
+        Connector,  ///< connector name, such as "HDMI-A-1"
+        Name        ///< monitor name pattern
+    };
+
+    DisplaySelector();
+
+    /**
+     * Adds an EDID identity to look for. A zero @p serial_number matches any
+     * display of that vendor and product.
+     */
+    void addEdid(uint32_t vendor_id, uint32_t product_id, uint32_t serial_number = 0);
+
+    /**
+     * Replaces the EDID identities to look for with a comma-separated list of
+     * "vendor:product[:serial]", each in decimal or 0x-prefixed hex, as the
+     * driver logs them.
+     *
+     * @return the entries that couldn't be read, comma-separated.
+     */
+    std::string setEdids(const std::string& edids);
+
+    /**
+     * Sets the connector to look for; empty matches none.
+     */
+    void setConnector(const std::string& connector);
+
+    /**
+     * Sets the name to look for. With @c * or @c ? wildcards it must match
+     * the whole name; without, it may appear anywhere in it.
+     */
+    void setNamePattern(const std::string& pattern);
+
+    /**
+     * Sets the order to try criteria in from a comma-separated list of
+     * "edid", "connector" and "name". Criteria left out aren't used.
+     *
+     * @return the names that weren't recognized, comma-separated.
+     */
+    std::string setPriority(const std::string& priority);
+
+    /**
+     * Returns the index in @p displays of the best match, or -1 if none
+     * matches. With a nonzero @p generation, as DisplayMonitor hands out,
+     * the last answer is reused until the generation changes.
+     */
+    int select(const std::vector<Display>& displays, uint64_t generation = 0);
+
+    /**
+     * The criterion the last selected display matched by.
+     */
+    Criterion getMatchedCriterion() const;
+
+    static const char* getName(Criterion criterion);
+
+private:
+    /**
+     * Returns the position in the priority order of the first criterion
+     * @p display meets, or the number of criteria if it meets none.
+     */
+    std::size_t rank(const Display& display) const;
+
+    void invalidate();
+
+    static uint64_t makeEdidKey(uint32_t vendor_id, uint32_t product_id);
+
+    /// Wanted serial numbers, keyed by vendor and product; 0 means any
+    std::unordered_multimap<uint64_t, uint32_t> edids_;
+    std::string edidList_;
+    std::string connector_;
+    std::string namePattern_;
+    bool nameHasWildcards_ = false;
+    std::vector<Criterion> priority_;
+    std::string priorityList_;
+
+    uint64_t generation_ = 0;
+    int selected_ = -1;
+    Criterion matched_ = Criterion::Edid;
+};
+
+/**
+ * Returns the index in @p displays of the same display as @p display, or -1
+ * if it isn't there. Displays are told apart by connector and EDID IDs, or
+ * by name and adapter where neither is known, so a display is still found
+ * after its mode, position or desktop state changes.
+ */
+int findDisplay(const std::vector<Display>& displays, const Display& display);
+
+/**
+ * Matches @p text against @p pattern, where @c * matches any run of
+ * characters and @c ? any one character.
+ */
+bool matchesWildcard(const std::string& pattern, const std::string& text);
+
+} // end namespace display
+} // end namespace osvr
+
+#endif // INCLUDED_DisplaySelector_h_GUID_63DF9BCB_BC1F_4D0F_90F2_AAD20F60E167
@@ -0,0 +1,198 @@
+/** @file
+    @brief Lists displays from the DRM connectors Linux describes in sysfs.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DrmDisplays.h"
+#include "Display.h"
+#include "Edid.h"
+
+// Library/third-party includes
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Standard includes
+#include <algorithm>        // for std::sort
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <cstdlib>          // for std::strtoul
+#include <cstring>          // for std::strncmp, std::strchr, std::strrchr
+#include <memory>           // for std::shared_ptr
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace display {
+
+namespace {
+
+    const std::size_t BlockSize = 128;
+
+    /**
+     * Reads up to @p size bytes of the file at @p path into @p buffer.
+     *
+     * @return the number of bytes read, or -1 if the file can't be opened.
+     */
+    ssize_t readFile(const std::string& path, void* buffer, std::size_t size)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return -1;
+
+        std::size_t total = 0;
+        while (total < size) {
+            const ssize_t count = ::read(fd, static_cast<char*>(buffer) + total, size - total);
+            if (count <= 0)
+                break;
+            total += static_cast<std::size_t>(count);
+        }
+        ::close(fd);
+        return static_cast<ssize_t>(total);
+    }
+
+    /**
+     * Reads the first line of a small text file, or "" if there is none.
+     */
+    std::string readLine(const std::string& path)
+    {
+        char text[256];
+        const ssize_t size = readFile(path, text, sizeof(text) - 1);
+        if (size <= 0)
+            return "";
+
+        text[size] = '\0';
+        if (char* end = std::strchr(text, '\n'))
+            *end = '\0';
+        return text;
+    }
+
+    /**
+     * Returns the name of the kernel driver behind DRM device @p card, such
+     * as "i915", or "" if it can't be found.
+     */
+    std::string getDriverName(const std::string& drm_path, const std::string& card)
+    {
+        char target[512];
+        const ssize_t size = ::readlink((drm_path + "/" + card + "/device/driver").c_str(), target, sizeof(target) - 1);
+        if (size <= 0)
+            return "";
+
+        target[size] = '\0';
+        const char* slash = std::strrchr(target, '/');
+        return slash ? slash + 1 : target;
+    }
+
+    /**
+     * Reads the connector at @p drm_path/@p connector into @p display,
+     * returning false if nothing is plugged into it.
+     */
+    bool getDisplay(const std::string& drm_path, const std::string& connector, std::vector<uint8_t>& edid, Display& display)
+    {
+        const std::string path = drm_path + "/" + connector;
+        if ("connected" != readLine(path + "/status"))
+            return false;
+
+        // card0-HDMI-A-1 belongs to card0 and is called HDMI-A-1
+        const auto dash = connector.find('-');
+        const std::string card = connector.substr(0, dash);
+        const std::string driver = getDriverName(drm_path, card);
+
+        display = Display();
+        display.adapter.description = driver.empty() ? card : card + " (" + driver + ")";
+        display.connector = connector.substr(dash + 1);
+        display.name = display.connector;
+        display.rotation = Rotation::Zero;
+        display.attachedToDesktop = ("enabled" == readLine(path + "/enabled"));
+
+        // EDID blobs are 128 bytes per block, with at most 255 extensions
+        edid.resize(BlockSize * 256);
+        const ssize_t edid_size = readFile(path + "/edid", edid.data(), edid.size());
+        std::shared_ptr<const EdidInfo> edid_info;
+        if (edid_size > 0) {
+            edid_info = getEdidInfo(edid.data(), static_cast<std::size_t>(edid_size));
+            applyEdid(*edid_info, display);
+        }
+
+        // The kernel lists the mode it prefers first, after applying its own
+        // quirks to the EDID, so that wins. Its refresh rate is that of the
+        // EDID timing with the same size, which needn't be the EDID's
+        // preferred one; with none, the rate isn't known.
+        const std::string mode = readLine(path + "/modes");
+        char* end = nullptr;
+        const unsigned long width = std::strtoul(mode.c_str(), &end, 10);
+        if (width && end && 'x' == *end) {
+            const unsigned long height = std::strtoul(end + 1, &end, 10);
+            const bool interlaced = end && 'i' == *end;
+            display.size.width = static_cast<uint32_t>(width);
+            display.size.height = static_cast<uint32_t>(height);
+            display.verticalRefreshRate = 0.0;
+            if (edid_info) {
+                for (const auto& timing : edid_info->timings) {
+                    if (timing.horizontalActive == width && timing.verticalActive == height && timing.interlaced == interlaced) {
+                        display.verticalRefreshRate = timing.getRefreshRate();
+                        break;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+} // end anonymous namespace
+
+std::vector<Display> getDrmDisplays(const std::string& drm_path)
+{
+    std::vector<Display> displays;
+
+    DIR* directory = ::opendir(drm_path.c_str());
+    if (!directory)
+        return displays;
+
+    // Connectors are named card<N>-<connector>; the cards themselves have no
+    // dash.
+    std::vector<std::string> connectors;
+    while (const dirent* entry = ::readdir(directory)) {
+        if (0 == std::strncmp(entry->d_name, "card", 4) && std::strchr(entry->d_name, '-')) {
+            connectors.emplace_back(entry->d_name);
+        }
+    }
+    ::closedir(directory);
+
+    // Directory order isn't stable, and the list is compared between calls
+    std::sort(connectors.begin(), connectors.end());
+
+    std::vector<uint8_t> edid;
+    for (const auto& connector : connectors) {
+        Display display;
+        if (getDisplay(drm_path, connector, edid, display)) {
+            displays.emplace_back(std::move(display));
+        }
+    }
+
+    return displays;
+}
+
+} // end namespace display
+} // end namespace osvr
@@ -0,0 +1,60 @@
+/** @file
+    @brief Lists displays from the DRM connectors Linux describes in sysfs.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DrmDisplays_h_GUID_6B061523_AC8A_4C37_AC48_FFAB05675AD3
+#define INCLUDED_DrmDisplays_h_GUID_6B061523_AC8A_4C37_AC48_FFAB05675AD3
+
+// Internal Includes
+#include "Display.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace display {
+
+/**
+ * Lists the displays plugged into the connectors under @p drm_path, such as
+ * /sys/class/drm/card0-HDMI-A-1, in connector name order.
+ *
+ * Each connector directory is expected to hold the files the kernel provides:
+ * @c status ("connected" or not), @c enabled ("enabled" when it's part of
+ * the desktop), @c modes (one "WIDTHxHEIGHT" per line, preferred first) and
+ * @c edid (the raw blob, empty when there's no display). Only a few small
+ * reads are made per connector, so this is cheap enough to call on every
+ * hotplug.
+ *
+ * The size is that of the kernel's preferred mode. The refresh rate comes
+ * from the EDID timing of that size, and is 0 when there's no such timing.
+ */
+std::vector<Display> getDrmDisplays(const std::string& drm_path = "/sys/class/drm");
+
+} // end namespace display
+} // end namespace osvr
+
+#endif // INCLUDED_DrmDisplays_h_GUID_6B061523_AC8A_4C37_AC48_FFAB05675AD3
@@ -0,0 +1,345 @@
+/** @file
+    @brief Decodes the EDID blobs displays use to describe themselves.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "Edid.h"
+#include "Display.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::min, std::find_if, std::rotate
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <cstring>          // for std::memcmp, std::memcpy
+#include <memory>           // for std::make_shared
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace display {
+
+namespace {
+
+    const std::size_t BlockSize = 128;
+
+    /// Data block tags in DisplayID extension sections
+    const uint8_t DisplayIdTypeITiming = 0x03;
+    const uint8_t DisplayIdTypeVIITiming = 0x22;
+
+    uint32_t readLittleEndian16(const uint8_t* data)
+    {
+        return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8);
+    }
+
+    uint32_t readLittleEndian24(const uint8_t* data)
+    {
+        return readLittleEndian16(data) | (static_cast<uint32_t>(data[2]) << 16);
+    }
+
+    /**
+     * Decodes an 18-byte detailed timing descriptor, as found in the base
+     * block and in CTA-861 extensions. Returns false if it's some other kind
+     * of descriptor.
+     */
+    bool parseDetailedTiming(const uint8_t* descriptor, EdidTiming& timing)
+    {
+        const uint32_t pixel_clock = readLittleEndian16(descriptor);
+        if (0 == pixel_clock)
+            return false;
+
+        timing.pixelClock = static_cast<uint64_t>(pixel_clock) * 10000;
+        timing.horizontalActive = descriptor[2] | ((descriptor[4] & 0xf0) << 4);
+        timing.horizontalBlank = descriptor[3] | ((descriptor[4] & 0x0f) << 8);
+        timing.verticalActive = descriptor[5] | ((descriptor[7] & 0xf0) << 4);
+        timing.verticalBlank = descriptor[6] | ((descriptor[7] & 0x0f) << 8);
+        timing.interlaced = (descriptor[17] & 0x80) != 0;
+        if (timing.interlaced) {
+            // The vertical fields describe one field. A frame is two of
+            // them, plus the half line each field's blanking rounds off.
+            timing.verticalActive *= 2;
+            timing.verticalBlank = timing.verticalBlank * 2 + 1;
+        }
+        return true;
+    }
+
+    /**
+     * Decodes a 20-byte DisplayID type I or type VII timing, which differ
+     * only in the unit of the pixel clock.
+     */
+    EdidTiming parseDisplayIdTiming(const uint8_t* descriptor, uint64_t clock_unit)
+    {
+        EdidTiming timing;
+        timing.pixelClock = (static_cast<uint64_t>(readLittleEndian24(descriptor)) + 1) * clock_unit;
+        timing.preferred = (descriptor[3] & 0x80) != 0;
+        timing.interlaced = (descriptor[3] & 0x10) != 0;
+        timing.horizontalActive = readLittleEndian16(descriptor + 4) + 1;
+        timing.horizontalBlank = readLittleEndian16(descriptor + 6) + 1;
+        timing.verticalActive = readLittleEndian16(descriptor + 12) + 1;
+        timing.verticalBlank = readLittleEndian16(descriptor + 14) + 1;
+        return timing;
+    }
+
+    /**
+     * Decodes the four descriptors of the base block: timings and the
+     * monitor name.
+     */
+    void parseBaseDescriptors(const uint8_t* block, EdidInfo& info)
+    {
+        for (std::size_t offset = 54; offset + 18 <= 126; offset += 18) {
+            const uint8_t* descriptor = block + offset;
+            EdidTiming timing;
+            if (parseDetailedTiming(descriptor, timing)) {
+                // The first one is the preferred timing
+                timing.preferred = info.timings.empty();
+                info.timings.push_back(timing);
+            } else if (0xfc == descriptor[3]) {
+                // Up to 13 characters, ended by a newline and padded with
+                // spaces
+                std::string name(reinterpret_cast<const char*>(descriptor + 5), 13);
+                name = name.substr(0, name.find('\n'));
+                name.erase(name.find_last_not_of(' ') + 1);
+                info.name = name;
+            }
+        }
+    }
+
+    /**
+     * Decodes the detailed timings at the end of a CTA-861 extension block.
+     */
+    void parseCtaExtension(const uint8_t* block, EdidInfo& info)
+    {
+        // Byte 2 is where the detailed timings start; 0 means there are none
+        const std::size_t start = block[2];
+        if (start < 4)
+            return;
+
+        for (std::size_t offset = start; offset + 18 <= BlockSize - 1; offset += 18) {
+            EdidTiming timing;
+            if (!parseDetailedTiming(block + offset, timing))
+                break;
+            info.timings.push_back(timing);
+        }
+    }
+
+    /**
+     * Decodes the timing data blocks of a DisplayID section carried in an
+     * extension block.
+     */
+    void parseDisplayIdExtension(const uint8_t* block, EdidInfo& info)
+    {
+        // The section header follows the extension tag: version, payload
+        // size, product type and extension count.
+        const std::size_t end = std::min<std::size_t>(5 + block[2], BlockSize - 1);
+        std::size_t offset = 5;
+        while (offset + 3 <= end) {
+            const uint8_t tag = block[offset];
+            const std::size_t size = block[offset + 2];
+            const uint8_t* payload = block + offset + 3;
+            const std::size_t payload_end = std::min(offset + 3 + size, end);
+
+            const uint64_t clock_unit = (DisplayIdTypeITiming == tag) ? 10000 : (DisplayIdTypeVIITiming == tag) ? 1000 : 0;
+            if (clock_unit) {
+                for (const uint8_t* descriptor = payload; descriptor + 20 <= block + payload_end; descriptor += 20) {
+                    info.timings.push_back(parseDisplayIdTiming(descriptor, clock_unit));
+                }
+            }
+
+            // A zero tag with no payload is padding
+            if (0 == tag && 0 == size)
+                break;
+            offset += 3 + size;
+        }
+    }
+
+    /**
+     * FNV-1a over 64-bit words rather than bytes, which is plenty for telling
+     * a handful of blobs apart and several times faster. The cache compares
+     * the bytes on a hit anyway.
+     */
+    uint64_t hashBlob(const uint8_t* data, std::size_t size)
+    {
+        const uint64_t prime = 1099511628211ULL;
+        uint64_t hash = 14695981039346656037ULL ^ size;
+        std::size_t i = 0;
+        for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+            uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            hash = (hash ^ word) * prime;
+        }
+        for (; i < size; ++i) {
+            hash = (hash ^ data[i]) * prime;
+        }
+        return hash ^ (hash >> 32);
+    }
+
+} // end anonymous namespace
+
+double EdidTiming::getRefreshRate() const
+{
+    const uint64_t total = static_cast<uint64_t>(horizontalActive + horizontalBlank) * (verticalActive + verticalBlank);
+    if (0 == total)
+        return 0.0;
+    // An interlaced frame is scanned as two fields, each one a refresh
+    const double fields = interlaced ? 2.0 : 1.0;
+    return fields * static_cast<double>(pixelClock) / static_cast<double>(total);
+}
+
+bool EdidTiming::operator==(const EdidTiming& other) const
+{
+    if (pixelClock != other.pixelClock) return false;
+    if (horizontalActive != other.horizontalActive) return false;
+    if (horizontalBlank != other.horizontalBlank) return false;
+    if (verticalActive != other.verticalActive) return false;
+    if (verticalBlank != other.verticalBlank) return false;
+    if (interlaced != other.interlaced) return false;
+    if (preferred != other.preferred) return false;
+
+    return true;
+}
+
+EdidInfo parseEdid(const uint8_t* data, std::size_t size)
+{
+    EdidInfo info;
+
+    static const uint8_t header[] = {0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00};
+    if (!data || size < BlockSize || 0 != std::memcmp(data, header, sizeof(header)))
+        return info;
+
+    info.valid = true;
+
+    // The manufacturer is three 5-bit letters, big-endian
+    const uint32_t manufacturer = (static_cast<uint32_t>(data[8]) << 8) | data[9];
+    for (int shift = 10; shift >= 0; shift -= 5) {
+        const uint32_t letter = (manufacturer >> shift) & 0x1f;
+        info.manufacturer += (letter >= 1 && letter <= 26) ? static_cast<char>('A' + letter - 1) : '?';
+    }
+    info.vendorId = readLittleEndian16(data + 8);
+    info.productId = readLittleEndian16(data + 10);
+    info.serialNumber = readLittleEndian16(data + 12) | (readLittleEndian16(data + 14) << 16);
+    info.version = data[18];
+    info.revision = data[19];
+
+    parseBaseDescriptors(data, info);
+    const std::size_t base_timings = info.timings.size();
+
+    const std::size_t extensions = std::min<std::size_t>(data[126], size / BlockSize - 1);
+    for (std::size_t i = 1; i <= extensions; ++i) {
+        const uint8_t* block = data + i * BlockSize;
+        switch (block[0]) {
+        case 0x02:
+            parseCtaExtension(block, info);
+            break;
+        case 0x70:
+            parseDisplayIdExtension(block, info);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Put the preferred timing first. DisplayID describes a display's native
+    // modes when the base block can't (the base block's fields stop at 4095
+    // lines and a 655 MHz clock), so a preferred DisplayID timing wins over
+    // the base block's, and is then the only one marked preferred.
+    const auto preferred = std::find_if(info.timings.begin() + base_timings, info.timings.end(), [](const EdidTiming& timing) { return timing.preferred; });
+    if (preferred != info.timings.end()) {
+        std::rotate(info.timings.begin(), preferred, preferred + 1);
+    }
+    for (std::size_t i = 1; i < info.timings.size(); ++i) {
+        info.timings[i].preferred = false;
+    }
+
+    return info;
+}
+
+void applyEdid(const EdidInfo& edid, Display& display)
+{
+    if (!edid.valid)
+        return;
+
+    display.edidVendorId = edid.vendorId;
+    display.edidProductId = edid.productId;
+    display.edidSerialNumber = edid.serialNumber;
+    if (!edid.name.empty()) {
+        display.name = edid.name;
+    }
+    if (!edid.timings.empty()) {
+        const EdidTiming& timing = edid.timings.front();
+        display.size.width = timing.horizontalActive;
+        display.size.height = timing.verticalActive;
+        display.verticalRefreshRate = timing.getRefreshRate();
+    }
+}
+
+EdidCache::EdidCache(std::size_t capacity) : capacity_(capacity)
+{
+    // do nothing
+}
+
+std::shared_ptr<const EdidInfo> EdidCache::get(const uint8_t* data, std::size_t size)
+{
+    const uint64_t hash = hashBlob(data, size);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto found = entries_.find(hash);
+    if (found != entries_.end()) {
+        const Entry& entry = found->second;
+        if (entry.blob.size() == size && 0 == std::memcmp(entry.blob.data(), data, size))
+            return entry.info;
+
+        // A collision; don't let it evict the other blob
+        return std::make_shared<const EdidInfo>(parseEdid(data, size));
+    }
+
+    if (entries_.size() >= capacity_) {
+        entries_.clear();
+    }
+
+    Entry entry;
+    entry.blob.assign(data, data + size);
+    entry.info = std::make_shared<const EdidInfo>(parseEdid(data, size));
+    return entries_.emplace(hash, std::move(entry)).first->second.info;
+}
+
+std::size_t EdidCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+EdidCache& EdidCache::instance()
+{
+    static EdidCache cache;
+    return cache;
+}
+
+std::shared_ptr<const EdidInfo> getEdidInfo(const uint8_t* data, std::size_t size)
+{
+    return EdidCache::instance().get(data, size);
+}
+
+} // end namespace display
+} // end namespace osvr
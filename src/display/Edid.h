@@ -0,0 +1,143 @@
+/** @file
+    @brief Decodes the EDID blobs displays use to describe themselves.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_Edid_h_GUID_8F703FDE_95AC_432D_AF04_1829E3F1C0F7
+#define INCLUDED_Edid_h_GUID_8F703FDE_95AC_432D_AF04_1829E3F1C0F7
+
+// Internal Includes
+#include "Display.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace osvr {
+namespace display {
+
+/**
+ * One video timing a display supports.
+ */
+struct EdidTiming {
+    uint64_t pixelClock = 0;        ///< in Hz
+    uint32_t horizontalActive = 0;
+    uint32_t horizontalBlank = 0;
+    uint32_t verticalActive = 0;    ///< in lines per frame, even if interlaced
+    uint32_t verticalBlank = 0;     ///< in lines per frame, even if interlaced
+    bool interlaced = false;
+    bool preferred = false;         ///< the display's native mode; only the first timing is
+
+    /**
+     * The exact refresh rate, in Hz, derived from the pixel clock and the
+     * total (active plus blanking) size. For interlaced timings this is the
+     * field rate, twice the frame rate.
+     */
+    double getRefreshRate() const;
+
+    bool operator==(const EdidTiming& other) const;
+};
+
+/**
+ * What an EDID blob says about its display.
+ */
+struct EdidInfo {
+    bool valid = false;             ///< the blob started with an EDID header
+    uint8_t version = 0;
+    uint8_t revision = 0;
+    std::string manufacturer;       ///< three-letter PNP ID, such as "SVR"
+    uint32_t vendorId = 0;          ///< manufacturer ID, byte order as Windows reports it
+    uint32_t productId = 0;
+    uint32_t serialNumber = 0;
+    std::string name;               ///< from the monitor name descriptor, if any
+
+    /**
+     * Every detailed timing from the base block and any CTA-861 or DisplayID
+     * extensions, with the one the display prefers first.
+     */
+    std::vector<EdidTiming> timings;
+};
+
+/**
+ * Decodes @p size bytes of EDID at @p data. Malformed or truncated blobs
+ * decode as far as they can; nothing is read past @p size.
+ */
+EdidInfo parseEdid(const uint8_t* data, std::size_t size);
+
+/**
+ * Copies the IDs, name and preferred timing (size and refresh rate) from
+ * @p edid into @p display, leaving fields the EDID doesn't provide alone.
+ */
+void applyEdid(const EdidInfo& edid, Display& display);
+
+/**
+ * Remembers decoded EDID blobs, keyed by a hash of their contents, so that
+ * enumerating the same displays again skips the decoding.
+ */
+class EdidCache {
+public:
+    /**
+     * @param capacity How many blobs to remember; the cache starts over
+     * once it's full.
+     */
+    explicit EdidCache(std::size_t capacity = 32);
+
+    /**
+     * Returns the cached decoding of a blob, decoding it first if needed.
+     */
+    std::shared_ptr<const EdidInfo> get(const uint8_t* data, std::size_t size);
+
+    std::size_t size() const;
+
+    /**
+     * The cache used by the display enumerators.
+     */
+    static EdidCache& instance();
+
+private:
+    struct Entry {
+        std::vector<uint8_t> blob;
+        std::shared_ptr<const EdidInfo> info;
+    };
+
+    const std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, Entry> entries_;
+};
+
+/**
+ * Decodes @p size bytes of EDID at @p data through the shared cache.
+ */
+std::shared_ptr<const EdidInfo> getEdidInfo(const uint8_t* data, std::size_t size);
+
+} // end namespace display
+} // end namespace osvr
+
+#endif // INCLUDED_Edid_h_GUID_8F703FDE_95AC_432D_AF04_1829E3F1C0F7
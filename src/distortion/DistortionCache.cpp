@@ -0,0 +1,198 @@
+/** @file
+    @brief Baked distortion grids saved to disk between runs.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DistortionCache.h"
+#include "DistortionGrid.h"
+#include "DistortionModel.h"
+#include "io/MappedFile.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdio>           // for std::remove, std::rename
+#include <cstring>          // for std::memcmp, std::memcpy
+#include <memory>           // for std::shared_ptr, std::make_shared
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace distortion {
+
+static_assert(sizeof(CacheHeader) == 40, "CacheHeader shouldn't need padding");
+
+namespace {
+
+    /// 64-bit FNV-1a, continued from @p hash.
+    uint64_t hashBytes(uint64_t hash, const void* data, std::size_t size)
+    {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    /// Hashes the length first so that moving text between strings changes the key.
+    uint64_t hashString(uint64_t hash, const std::string& text)
+    {
+        const uint64_t size = text.size();
+        hash = hashBytes(hash, &size, sizeof(size));
+        return hashBytes(hash, text.data(), text.size());
+    }
+
+} // end anonymous namespace
+
+DistortionCache::DistortionCache(const std::string& path) : path_(path)
+{
+    // do nothing
+}
+
+uint64_t DistortionCache::computeKey(const std::string& display_descriptor, const std::string& render_manager_config, std::size_t grid_size)
+{
+    const uint64_t size = grid_size;
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash = hashString(hash, display_descriptor);
+    hash = hashString(hash, render_manager_config);
+    return hashBytes(hash, &size, sizeof(size));
+}
+
+std::vector<DistortionGrid> DistortionCache::load(uint64_t key)
+{
+    std::vector<DistortionGrid> grids;
+
+    // The grids share the mapping, which stays open as long as any of them does
+    auto file = std::make_shared<io::MappedFile>();
+    if (!file->open(path_)) {
+        error_ = file->getError();
+        return grids;
+    }
+
+    const auto fail = [&](const std::string& reason) {
+        error_ = path_ + ": " + reason;
+        return std::vector<DistortionGrid>();
+    };
+
+    if (file->size() < sizeof(CacheHeader))
+        return fail("too small to be a distortion cache");
+
+    const auto* header = static_cast<const CacheHeader*>(file->data());
+    if (std::memcmp(header->magic, CacheMagic, sizeof(CacheMagic)) != 0)
+        return fail("not a distortion cache");
+    if (header->version != CacheVersion)
+        return fail("unsupported distortion cache version " + std::to_string(header->version));
+    if (header->headerSize != sizeof(CacheHeader) || header->pointSize != sizeof(DistortedPoint))
+        return fail("unexpected point layout");
+    if (header->key != key)
+        return fail("baked for a different configuration");
+
+    // Check the sizes against what the file holds one factor at a time, so
+    // that a damaged header can't overflow into a plausible total.
+    const uint64_t body = file->size() - sizeof(CacheHeader);
+    if (body % sizeof(DistortedPoint) != 0)
+        return fail("damaged");
+    const uint64_t points_stored = body / sizeof(DistortedPoint);
+    if (header->gridSize < 2 || header->gridSize > points_stored / header->gridSize)
+        return fail("damaged");
+    const uint64_t grid_points = header->gridSize * header->gridSize;
+    if (header->gridCount < 1 || header->gridCount > points_stored / grid_points || header->gridCount * grid_points != points_stored)
+        return fail("damaged");
+
+    const auto* points = reinterpret_cast<const DistortedPoint*>(static_cast<const char*>(file->data()) + sizeof(CacheHeader));
+    for (uint32_t i = 0; i < header->gridCount; ++i) {
+        grids.emplace_back(static_cast<std::size_t>(header->gridSize), std::shared_ptr<const DistortedPoint>(file, points + i * grid_points));
+    }
+    error_.clear();
+    return grids;
+}
+
+bool DistortionCache::store(uint64_t key, const std::vector<const DistortionGrid*>& grids)
+{
+    if (grids.empty()) {
+        error_ = path_ + ": no grids to store";
+        return false;
+    }
+
+    const std::size_t grid_size = grids.front()->getSize();
+    for (const auto* grid : grids) {
+        if (grid->getSize() != grid_size) {
+            error_ = path_ + ": grids of different sizes";
+            return false;
+        }
+    }
+
+    // Write a new file and then move it over the old one, so a process that
+    // has the old one mapped keeps its pages and a crash leaves no torn cache.
+    const std::string temporary_path = path_ + ".tmp";
+    const std::size_t grid_bytes = grid_size * grid_size * sizeof(DistortedPoint);
+    {
+        io::MappedFile file;
+        if (!file.create(temporary_path, sizeof(CacheHeader) + grids.size() * grid_bytes)) {
+            error_ = file.getError();
+            return false;
+        }
+
+        CacheHeader header = {};
+        std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+        header.version = CacheVersion;
+        header.headerSize = sizeof(CacheHeader);
+        header.pointSize = sizeof(DistortedPoint);
+        header.gridCount = static_cast<uint32_t>(grids.size());
+        header.key = key;
+        header.gridSize = grid_size;
+
+        auto* data = static_cast<char*>(file.data());
+        std::memcpy(data, &header, sizeof(header));
+        for (std::size_t i = 0; i < grids.size(); ++i) {
+            std::memcpy(data + sizeof(CacheHeader) + i * grid_bytes, grids[i]->getPoints(), grid_bytes);
+        }
+    }
+
+    // Windows won't rename over an existing file
+    if (0 != std::rename(temporary_path.c_str(), path_.c_str())) {
+        std::remove(path_.c_str());
+        if (0 != std::rename(temporary_path.c_str(), path_.c_str())) {
+            std::remove(temporary_path.c_str());
+            error_ = path_ + ": unable to replace the distortion cache";
+            return false;
+        }
+    }
+
+    error_.clear();
+    return true;
+}
+
+const std::string& DistortionCache::getPath() const
+{
+    return path_;
+}
+
+const std::string& DistortionCache::getError() const
+{
+    return error_;
+}
+
+} // end namespace distortion
+} // end namespace osvr
@@ -0,0 +1,108 @@
+/** @file
+    @brief Baked distortion grids saved to disk between runs.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DistortionCache_h_GUID_C4C4FE37_FF14_4DC3_9FD2_10F00C7D9C52
+#define INCLUDED_DistortionCache_h_GUID_C4C4FE37_FF14_4DC3_9FD2_10F00C7D9C52
+
+// Internal Includes
+#include "DistortionGrid.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace distortion {
+
+/**
+ * A cache file is a CacheHeader followed by the points of each grid, row by
+ * row, in the byte order of the machine that wrote it. It's mapped rather
+ * than read, so the grids it holds are used straight from the page cache.
+ */
+static const char CacheMagic[8] = { 'O', 'S', 'V', 'R', 'D', 'I', 'S', 'T' };
+
+/// Bump this whenever the file layout or the way grids are baked changes.
+static const uint32_t CacheVersion = 1;
+
+struct CacheHeader {
+    char magic[8];              ///< CacheMagic
+    uint32_t version;           ///< CacheVersion
+    uint32_t headerSize;        ///< sizeof(CacheHeader)
+    uint32_t pointSize;         ///< sizeof(DistortedPoint)
+    uint32_t gridCount;         ///< grids stored, one per eye
+    uint64_t key;               ///< DistortionCache::computeKey() of what was baked
+    uint64_t gridSize;          ///< points per side of each grid
+};
+
+/**
+ * Stores baked DistortionGrid%s in a file so later runs with the same
+ * configuration can skip baking them.
+ */
+class DistortionCache {
+public:
+    /**
+     * Uses the cache file at @p path, which needn't exist yet.
+     */
+    explicit DistortionCache(const std::string& path);
+
+    /**
+     * Hashes everything the baked grids depend on. Any change to these gives
+     * a different key, which makes an existing cache file stale.
+     */
+    static uint64_t computeKey(const std::string& display_descriptor, const std::string& render_manager_config, std::size_t grid_size);
+
+    /**
+     * Maps the cache file and returns its grids if they were stored for
+     * @p key. Returns no grids if the file is missing, stale, from another
+     * version or damaged; getError() says which.
+     */
+    std::vector<DistortionGrid> load(uint64_t key);
+
+    /**
+     * Replaces the cache file with @p grids, stored for @p key. The grids
+     * must all be the same size.
+     */
+    bool store(uint64_t key, const std::vector<const DistortionGrid*>& grids);
+
+    const std::string& getPath() const;
+
+    /**
+     * Describes why the last load() or store() failed.
+     */
+    const std::string& getError() const;
+
+private:
+    std::string path_;
+    std::string error_;
+};
+
+} // end namespace distortion
+} // end namespace osvr
+
+#endif // INCLUDED_DistortionCache_h_GUID_C4C4FE37_FF14_4DC3_9FD2_10F00C7D9C52
@@ -0,0 +1,100 @@
+/** @file
+    @brief A distortion model baked into a grid for fast lookups.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DistortionGrid.h"
+#include "DistortionModel.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::fill, std::max, std::min
+#include <cstddef>          // for std::size_t
+#include <memory>           // for std::shared_ptr, std::make_shared
+#include <utility>          // for std::move
+#include <vector>
+
+namespace osvr {
+namespace distortion {
+
+DistortionGrid::DistortionGrid(const DistortionModel& model, int eye, std::size_t size) : size_(std::max<std::size_t>(size, 2)), scale_(static_cast<float>(size_ - 1))
+{
+    // Evaluate a row at a time so polynomial models can vectorize
+    auto points = std::make_shared<std::vector<DistortedPoint> >(size_ * size_);
+    std::vector<float> u(size_), v(size_);
+    for (std::size_t column = 0; column < size_; ++column) {
+        u[column] = static_cast<float>(column) / scale_;
+    }
+    for (std::size_t row = 0; row < size_; ++row) {
+        std::fill(v.begin(), v.end(), static_cast<float>(row) / scale_);
+        model.computeBatch(eye, u.data(), v.data(), size_, &(*points)[row * size_]);
+    }
+    points_ = std::shared_ptr<const DistortedPoint>(points, points->data());
+}
+
+DistortionGrid::DistortionGrid(std::size_t size, std::shared_ptr<const DistortedPoint> points) : size_(std::max<std::size_t>(size, 2)), scale_(static_cast<float>(size_ - 1)), points_(std::move(points))
+{
+    // do nothing
+}
+
+DistortedPoint DistortionGrid::lookup(float u, float v) const
+{
+    // Find the cell, keeping the last row and column inside the grid
+    const float x = std::min(std::max(u, 0.0f), 1.0f) * scale_;
+    const float y = std::min(std::max(v, 0.0f), 1.0f) * scale_;
+    const std::size_t column = std::min(static_cast<std::size_t>(x), size_ - 2);
+    const std::size_t row = std::min(static_cast<std::size_t>(y), size_ - 2);
+    const float fx = x - static_cast<float>(column);
+    const float fy = y - static_cast<float>(row);
+
+    const DistortedPoint* points = points_.get();
+    const DistortedPoint& top_left = points[row * size_ + column];
+    const DistortedPoint& top_right = points[row * size_ + column + 1];
+    const DistortedPoint& bottom_left = points[(row + 1) * size_ + column];
+    const DistortedPoint& bottom_right = points[(row + 1) * size_ + column + 1];
+
+    DistortedPoint point;
+    for (int channel = 0; channel < NumChannels; ++channel) {
+        for (int axis = 0; axis < 2; ++axis) {
+            const float top = top_left.channels[channel][axis] + fx * (top_right.channels[channel][axis] - top_left.channels[channel][axis]);
+            const float bottom = bottom_left.channels[channel][axis] + fx * (bottom_right.channels[channel][axis] - bottom_left.channels[channel][axis]);
+            point.channels[channel][axis] = top + fy * (bottom - top);
+        }
+    }
+    return point;
+}
+
+std::size_t DistortionGrid::getSize() const
+{
+    return size_;
+}
+
+const DistortedPoint* DistortionGrid::getPoints() const
+{
+    return points_.get();
+}
+
+} // end namespace distortion
+} // end namespace osvr
@@ -0,0 +1,84 @@
+/** @file
+    @brief A distortion model baked into a grid for fast lookups.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DistortionGrid_h_GUID_C6601AD2_B061_457D_90C2_692A78241606
+#define INCLUDED_DistortionGrid_h_GUID_C6601AD2_B061_457D_90C2_692A78241606
+
+// Internal Includes
+#include "DistortionModel.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <memory>           // for std::shared_ptr
+
+namespace osvr {
+namespace distortion {
+
+/**
+ * One eye's distortion, sampled on a square grid of points spanning the
+ * screen and interpolated bilinearly in between. Looking a point up costs a
+ * few multiplies however expensive the model is.
+ */
+class DistortionGrid {
+public:
+    /**
+     * Samples @p model for @p eye at @p size by @p size points, corners
+     * included. @p size is at least 2.
+     */
+    DistortionGrid(const DistortionModel& model, int eye, std::size_t size);
+
+    /**
+     * Uses @p size by @p size points baked earlier, such as ones mapped from
+     * a DistortionCache file. @p points keeps them alive; they aren't copied.
+     */
+    DistortionGrid(std::size_t size, std::shared_ptr<const DistortedPoint> points);
+
+    /**
+     * Returns the distortion at (@p u, @p v), which is clamped to the screen.
+     */
+    DistortedPoint lookup(float u, float v) const;
+
+    /**
+     * Points per side.
+     */
+    std::size_t getSize() const;
+
+    /**
+     * The getSize() squared sampled points, row by row from the top.
+     */
+    const DistortedPoint* getPoints() const;
+
+private:
+    std::size_t size_;
+    float scale_;                   ///< size_ - 1, as a float
+    std::shared_ptr<const DistortedPoint> points_;
+};
+
+} // end namespace distortion
+} // end namespace osvr
+
+#endif // INCLUDED_DistortionGrid_h_GUID_C6601AD2_B061_457D_90C2_692A78241606
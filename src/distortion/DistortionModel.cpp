@@ -0,0 +1,361 @@
+/** @file
+    @brief Lens distortion as described by an OSVR display descriptor.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DistortionModel.h"
+
+// Library/third-party includes
+#include <Eigen/Core>
+#include <json/reader.h>
+#include <json/value.h>
+
+// Standard includes
+#include <algorithm>        // for std::min
+#include <cmath>            // for std::sqrt, std::abs
+#include <cstddef>          // for std::size_t
+#include <cstring>          // for std::memcpy
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace distortion {
+
+static_assert(sizeof(DistortedPoint) == 6 * sizeof(float), "DistortedPoint must be six packed floats");
+
+namespace {
+
+    /// Points evaluated together by computeBatch(): enough to keep the SIMD
+    /// units busy, few enough to live on the stack.
+    const int BatchSize = 64;
+    using BatchArray = Eigen::Array<float, BatchSize, 1>;
+
+    /// One coordinate of one channel across a run of DistortedPoints
+    using ChannelMap = Eigen::Map<Eigen::Array<float, Eigen::Dynamic, 1>, Eigen::Unaligned, Eigen::InnerStride<6> >;
+
+    const char* const ChannelNames[NumChannels] = {"red", "green", "blue"};
+
+    std::vector<double> readCoefficients(const Json::Value& distortion, const std::string& name)
+    {
+        const Json::Value& values = distortion[name];
+        if (!values.isArray() || values.empty())
+            throw std::runtime_error("The display descriptor's distortion is missing " + name + ".");
+
+        std::vector<double> coefficients;
+        for (Json::ArrayIndex i = 0; i < values.size(); ++i) {
+            if (!values[i].isNumeric())
+                throw std::runtime_error("The display descriptor's " + name + " must be numbers.");
+            coefficients.push_back(values[i].asDouble());
+        }
+        return coefficients;
+    }
+
+    bool isIdentityPolynomial(const std::vector<double>& coefficients)
+    {
+        for (std::size_t i = 0; i < coefficients.size(); ++i) {
+            if (coefficients[i] != (1 == i ? 1.0 : 0.0))
+                return false;
+        }
+        return coefficients.size() >= 2;
+    }
+
+    double cross(const double a[2], const double b[2], const double c[2])
+    {
+        return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+    }
+
+    double distanceSquared(const double a[2], const double b[2])
+    {
+        const double dx = a[0] - b[0];
+        const double dy = a[1] - b[1];
+        return dx * dx + dy * dy;
+    }
+
+} // end anonymous namespace
+
+DistortionModel::DistortionModel()
+{
+    // do nothing
+}
+
+DistortionModel DistortionModel::fromDisplayDescriptor(const std::string& descriptor)
+{
+    DistortionModel model;
+    if (descriptor.empty())
+        return model;
+
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(descriptor, root, false))
+        throw std::runtime_error("Unable to parse the display descriptor: " + reader.getFormattedErrorMessages());
+
+    const Json::Value& hmd = root.isMember("hmd") ? root["hmd"] : root;
+
+    // OSVR measures the center of projection up from the bottom; SteamVR
+    // measures down from the top.
+    const Json::Value& eyes = hmd["eyes"];
+    for (Json::ArrayIndex eye = 0; eye < 2 && eyes.isArray() && eye < eyes.size(); ++eye) {
+        model.center_[eye][0] = eyes[eye].get("center_proj_x", 0.5).asDouble();
+        model.center_[eye][1] = 1.0 - eyes[eye].get("center_proj_y", 0.5).asDouble();
+    }
+
+    const Json::Value& distortion = hmd["distortion"];
+    if (!distortion.isObject())
+        return model;
+
+    const std::string type = distortion.get("type", "").asString();
+    if ("rgb_symmetric_polynomials" == type) {
+        model.distanceScale_[0] = distortion.get("distance_scale_x", 1.0).asDouble();
+        model.distanceScale_[1] = distortion.get("distance_scale_y", 1.0).asDouble();
+        if (!(model.distanceScale_[0] > 0.0) || !(model.distanceScale_[1] > 0.0))
+            throw std::runtime_error("The display descriptor's distortion distance scales must be positive.");
+
+        bool identity = true;
+        for (int channel = 0; channel < NumChannels; ++channel) {
+            model.coefficients_[channel] = readCoefficients(distortion, std::string("polynomial_coeffs_") + ChannelNames[channel]);
+            identity = identity && isIdentityPolynomial(model.coefficients_[channel]);
+        }
+        model.type_ = identity ? Type::None : Type::Polynomial;
+    } else if ("mono_point_samples" == type || "rgb_point_samples" == type) {
+        for (int channel = 0; channel < NumChannels; ++channel) {
+            const std::string name = ("mono_point_samples" == type) ? type : std::string(ChannelNames[channel]) + "_point_samples";
+            const Json::Value& eye_samples = distortion[name];
+            if (!eye_samples.isArray() || eye_samples.size() < 2)
+                throw std::runtime_error("The display descriptor's distortion needs " + name + " for both eyes.");
+
+            for (Json::ArrayIndex eye = 0; eye < 2; ++eye) {
+                const Json::Value& samples = eye_samples[eye];
+                for (Json::ArrayIndex i = 0; samples.isArray() && i < samples.size(); ++i) {
+                    const Json::Value& sample = samples[i];
+                    if (!sample.isArray() || sample.size() != 2 || sample[0].size() != 2 || sample[1].size() != 2)
+                        throw std::runtime_error("Each of the display descriptor's " + name + " must be [[in x, in y], [out x, out y]].");
+
+                    PointSample point;
+                    point.in[0] = sample[0][0].asDouble();
+                    point.in[1] = 1.0 - sample[0][1].asDouble();
+                    point.out[0] = sample[1][0].asDouble();
+                    point.out[1] = 1.0 - sample[1][1].asDouble();
+                    model.samples_[eye][channel].push_back(point);
+                }
+            }
+        }
+        model.type_ = Type::PointSamples;
+    } else if (type.empty() && (distortion.isMember("k1_red") || distortion.isMember("k1_green") || distortion.isMember("k1_blue"))) {
+        // The original form: r' = r (1 + k1 r^2) per channel
+        bool identity = true;
+        for (int channel = 0; channel < NumChannels; ++channel) {
+            const double k1 = distortion.get(std::string("k1_") + ChannelNames[channel], 0.0).asDouble();
+            model.coefficients_[channel] = {0.0, 1.0, 0.0, k1};
+            identity = identity && (0.0 == k1);
+        }
+        model.type_ = identity ? Type::None : Type::Polynomial;
+    } else if (!type.empty()) {
+        throw std::runtime_error("Unsupported distortion type in the display descriptor: " + type);
+    }
+
+    return model;
+}
+
+DistortionModel::Type DistortionModel::getType() const
+{
+    return type_;
+}
+
+bool DistortionModel::isIdentity() const
+{
+    return Type::None == type_;
+}
+
+void DistortionModel::getCenter(int eye, double& u, double& v) const
+{
+    eye = (0 == eye) ? 0 : 1;
+    u = center_[eye][0];
+    v = center_[eye][1];
+}
+
+DistortedPoint DistortionModel::compute(int eye, float u, float v) const
+{
+    DistortedPoint point;
+    for (int channel = 0; channel < NumChannels; ++channel) {
+        double out_u, out_v;
+        compute(eye, static_cast<Channel>(channel), u, v, out_u, out_v);
+        point.channels[channel][0] = static_cast<float>(out_u);
+        point.channels[channel][1] = static_cast<float>(out_v);
+    }
+    return point;
+}
+
+void DistortionModel::compute(int eye, Channel channel, double u, double v, double& out_u, double& out_v) const
+{
+    eye = (0 == eye) ? 0 : 1;
+    switch (type_) {
+    case Type::Polynomial:
+        computePolynomial(eye, channel, u, v, out_u, out_v);
+        break;
+    case Type::PointSamples:
+        computePointSamples(eye, channel, u, v, out_u, out_v);
+        break;
+    case Type::None:
+    default:
+        out_u = u;
+        out_v = v;
+        break;
+    }
+}
+
+void DistortionModel::computeBatch(int eye, const float* u, const float* v, std::size_t count, DistortedPoint* out) const
+{
+    eye = (0 == eye) ? 0 : 1;
+    if (Type::Polynomial == type_) {
+        computePolynomialBatch(eye, u, v, count, out);
+        return;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = compute(eye, u[i], v[i]);
+    }
+}
+
+void DistortionModel::computePolynomial(int eye, Channel channel, double u, double v, double& out_u, double& out_v) const
+{
+    // Offsets from the center of projection, in units of the distance scale
+    const double* center = center_[eye];
+    const double x = (u - center[0]) / distanceScale_[0];
+    const double y = (v - center[1]) / distanceScale_[1];
+    const double r = std::sqrt(x * x + y * y);
+
+    const auto& coefficients = coefficients_[channel];
+    double ratio;
+    if (r > 1e-12) {
+        double distorted_r = 0.0;
+        for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it) {
+            distorted_r = distorted_r * r + *it;
+        }
+        ratio = distorted_r / r;
+    } else {
+        // The limit of r'/r at the center
+        ratio = (coefficients.size() > 1) ? coefficients[1] : 0.0;
+    }
+
+    out_u = center[0] + x * ratio * distanceScale_[0];
+    out_v = center[1] + y * ratio * distanceScale_[1];
+}
+
+void DistortionModel::computePolynomialBatch(int eye, const float* u, const float* v, std::size_t count, DistortedPoint* out) const
+{
+    const float center_u = static_cast<float>(center_[eye][0]);
+    const float center_v = static_cast<float>(center_[eye][1]);
+    const float scale_u = static_cast<float>(distanceScale_[0]);
+    const float scale_v = static_cast<float>(distanceScale_[1]);
+
+    BatchArray x, y, r, ratio;
+    for (std::size_t start = 0; start < count; start += BatchSize) {
+        // Pad a short final batch with the center rather than garbage
+        const std::size_t size = std::min<std::size_t>(BatchSize, count - start);
+        if (size < static_cast<std::size_t>(BatchSize)) {
+            x.setConstant(center_u);
+            y.setConstant(center_v);
+        }
+        std::memcpy(x.data(), u + start, size * sizeof(float));
+        std::memcpy(y.data(), v + start, size * sizeof(float));
+
+        x = (x - center_u) / scale_u;
+        y = (y - center_v) / scale_v;
+        r = (x.square() + y.square()).sqrt();
+
+        for (int channel = 0; channel < NumChannels; ++channel) {
+            // r'/r = c0 / r + c1 + c2 r + ..., by Horner's rule from the top
+            const auto& coefficients = coefficients_[channel];
+            ratio.setConstant(coefficients.size() > 1 ? static_cast<float>(coefficients.back()) : 0.0f);
+            for (std::size_t k = coefficients.size() - 1; k > 1; --k) {
+                ratio = ratio * r + static_cast<float>(coefficients[k - 1]);
+            }
+            if (coefficients[0] != 0.0) {
+                ratio += (r > 1e-12f).select(static_cast<float>(coefficients[0]) / r, 0.0f);
+            }
+
+            ChannelMap(&out[start].channels[channel][0], size) = (center_u + x * ratio * scale_u).head(size);
+            ChannelMap(&out[start].channels[channel][1], size) = (center_v + y * ratio * scale_v).head(size);
+        }
+    }
+}
+
+void DistortionModel::computePointSamples(int eye, Channel channel, double u, double v, double& out_u, double& out_v) const
+{
+    // Interpolate (or extrapolate) linearly across the triangle of the three
+    // nearest samples that aren't in a line.
+    const auto& samples = samples_[eye][channel];
+    const double point[2] = {u, v};
+    out_u = u;
+    out_v = v;
+    if (samples.empty())
+        return;
+
+    const double epsilon = 1e-12;
+    const PointSample* nearest[3] = {nullptr, nullptr, nullptr};
+    double best[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    for (const auto& sample : samples) {
+        const double distance = distanceSquared(sample.in, point);
+        if (distance < best[0]) {
+            best[0] = distance;
+            nearest[0] = &sample;
+        }
+    }
+    for (const auto& sample : samples) {
+        const double distance = distanceSquared(sample.in, point);
+        if (distance < best[1] && distanceSquared(sample.in, nearest[0]->in) > epsilon) {
+            best[1] = distance;
+            nearest[1] = &sample;
+        }
+    }
+    if (nearest[1]) {
+        for (const auto& sample : samples) {
+            const double distance = distanceSquared(sample.in, point);
+            if (distance < best[2] && std::abs(cross(nearest[0]->in, nearest[1]->in, sample.in)) > epsilon) {
+                best[2] = distance;
+                nearest[2] = &sample;
+            }
+        }
+    }
+
+    const PointSample& a = *nearest[0];
+    if (!nearest[2]) {
+        // Too few samples for a triangle; shift by the nearest one's offset
+        out_u = u + a.out[0] - a.in[0];
+        out_v = v + a.out[1] - a.in[1];
+        return;
+    }
+
+    const PointSample& b = *nearest[1];
+    const PointSample& c = *nearest[2];
+    const double area = cross(a.in, b.in, c.in);
+    const double s = cross(a.in, point, c.in) / area;
+    const double t = cross(a.in, b.in, point) / area;
+    out_u = a.out[0] + s * (b.out[0] - a.out[0]) + t * (c.out[0] - a.out[0]);
+    out_v = a.out[1] + s * (b.out[1] - a.out[1]) + t * (c.out[1] - a.out[1]);
+}
+
+} // end namespace distortion
+} // end namespace osvr
@@ -0,0 +1,143 @@
+/** @file
+    @brief Lens distortion as described by an OSVR display descriptor.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DistortionModel_h_GUID_226CD6A5_32E8_4FC3_AE3E_165858D2DE55
+#define INCLUDED_DistortionModel_h_GUID_226CD6A5_32E8_4FC3_AE3E_165858D2DE55
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace distortion {
+
+enum Channel {
+    Red,
+    Green,
+    Blue,
+    NumChannels
+};
+
+/**
+ * Where one point on an eye's screen samples the rendered eye image, for each
+ * color channel. Coordinates are in [0, 1] with (0, 0) at the top left, as
+ * SteamVR uses them, and laid out like vr::DistortionCoordinates_t.
+ */
+struct DistortedPoint {
+    float channels[NumChannels][2];
+};
+
+/**
+ * Maps screen coordinates to rendered-image coordinates for each eye, using
+ * the "distortion" and "eyes" sections of an OSVR display descriptor. This
+ * evaluates the model directly; DistortionGrid bakes it for fast lookups.
+ */
+class DistortionModel {
+public:
+    enum class Type {
+        None,           ///< the image is shown as rendered
+        Polynomial,     ///< radial polynomials per color channel
+        PointSamples    ///< measured input/output pairs, interpolated
+    };
+
+    /**
+     * A model that leaves coordinates unchanged.
+     */
+    DistortionModel();
+
+    /**
+     * Reads the distortion described by the display descriptor JSON in
+     * @p descriptor. A descriptor without distortion, or an empty string,
+     * gives a model of type None.
+     *
+     * @throws std::runtime_error if the descriptor can't be parsed or its
+     * distortion section is malformed.
+     */
+    static DistortionModel fromDisplayDescriptor(const std::string& descriptor);
+
+    Type getType() const;
+
+    /**
+     * Returns true if compute() always returns its input.
+     */
+    bool isIdentity() const;
+
+    /**
+     * Where @p eye's lens is centered on its screen, in SteamVR's coordinates.
+     */
+    void getCenter(int eye, double& u, double& v) const;
+
+    /**
+     * Maps the point (@p u, @p v) on @p eye's screen to where each color
+     * channel should sample the rendered image.
+     */
+    DistortedPoint compute(int eye, float u, float v) const;
+
+    /**
+     * Evaluates one channel, in double precision.
+     */
+    void compute(int eye, Channel channel, double u, double v, double& out_u, double& out_v) const;
+
+    /**
+     * Maps @p count points at once, (@p u[i], @p v[i]) to @p out[i].
+     * Polynomial models are evaluated for several points per instruction in
+     * single precision, all three channels sharing each point's radius;
+     * point samples are looked up one point at a time.
+     */
+    void computeBatch(int eye, const float* u, const float* v, std::size_t count, DistortedPoint* out) const;
+
+private:
+    struct PointSample {
+        double in[2];
+        double out[2];
+    };
+
+    void computePolynomial(int eye, Channel channel, double u, double v, double& out_u, double& out_v) const;
+    void computePolynomialBatch(int eye, const float* u, const float* v, std::size_t count, DistortedPoint* out) const;
+    void computePointSamples(int eye, Channel channel, double u, double v, double& out_u, double& out_v) const;
+
+    Type type_ = Type::None;
+
+    /// Center of projection of each eye, in SteamVR's coordinates
+    double center_[2][2] = {{0.5, 0.5}, {0.5, 0.5}};
+
+    /// Polynomial coefficients for each channel, lowest order first
+    std::vector<double> coefficients_[NumChannels];
+    double distanceScale_[2] = {1.0, 1.0};
+
+    /// Samples for each eye and channel, in SteamVR's coordinates
+    std::vector<PointSample> samples_[2][NumChannels];
+};
+
+} // end namespace distortion
+} // end namespace osvr
+
+#endif // INCLUDED_DistortionModel_h_GUID_226CD6A5_32E8_4FC3_AE3E_165858D2DE55
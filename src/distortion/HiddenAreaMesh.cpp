@@ -0,0 +1,220 @@
+/** @file
+    @brief Triangles covering the parts of an eye's rendered image that the
+    lens never shows.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "HiddenAreaMesh.h"
+#include "DistortionModel.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::max, std::min
+#include <cmath>            // for std::abs, std::sqrt
+#include <cstddef>          // for std::size_t
+#include <limits>
+#include <vector>
+
+namespace osvr {
+namespace distortion {
+
+namespace {
+
+    struct Point {
+        double x;
+        double y;
+    };
+
+    /// Extra room left around the visible outline, in image units: about a
+    /// pixel of a 1k-wide eye.
+    const double Margin = 1e-3;
+
+    /// Triangles smaller than this hide nothing and are dropped
+    const double MinArea = 1e-9;
+
+    double distanceSquared(const Point& a, const Point& b)
+    {
+        const double dx = a.x - b.x;
+        const double dy = a.y - b.y;
+        return dx * dx + dy * dy;
+    }
+
+    /// The point @p t of the way around the screen's edge, clockwise from the
+    /// top left corner, one unit per side.
+    Point screenEdge(double t)
+    {
+        const int side = std::min(static_cast<int>(t), 3);
+        const double f = t - side;
+        switch (side) {
+        case 0:
+            return {f, 0.0};
+        case 1:
+            return {1.0, f};
+        case 2:
+            return {1.0 - f, 1.0};
+        default:
+            return {0.0, 1.0 - f};
+        }
+    }
+
+    /// Where @p screen samples the image, taking whichever channel reaches
+    /// furthest from @p center so no channel's samples get hidden.
+    Point outermostSample(const DistortionModel& model, int eye, const Point& center, const Point& screen)
+    {
+        const DistortedPoint point = model.compute(eye, static_cast<float>(screen.x), static_cast<float>(screen.y));
+        Point outermost = {point.channels[0][0], point.channels[0][1]};
+        for (int channel = 1; channel < NumChannels; ++channel) {
+            const Point sample = {point.channels[channel][0], point.channels[channel][1]};
+            if (distanceSquared(sample, center) > distanceSquared(outermost, center))
+                outermost = sample;
+        }
+        return outermost;
+    }
+
+    /// Where the ray from @p center through @p through leaves the image, and
+    /// which side (0 top, 1 right, 2 bottom, 3 left) it leaves by.
+    Point imageEdge(const Point& center, const Point& through, int& side)
+    {
+        const double dx = through.x - center.x;
+        const double dy = through.y - center.y;
+        double t = std::numeric_limits<double>::max();
+        side = 0;
+        const auto consider = [&](double candidate, int candidate_side) {
+            if (candidate < t) {
+                t = candidate;
+                side = candidate_side;
+            }
+        };
+        if (dy < 0.0)
+            consider(-center.y / dy, 0);
+        if (dx > 0.0)
+            consider((1.0 - center.x) / dx, 1);
+        if (dy > 0.0)
+            consider((1.0 - center.y) / dy, 2);
+        if (dx < 0.0)
+            consider(-center.x / dx, 3);
+        return {center.x + t * dx, center.y + t * dy};
+    }
+
+    /// The image corner clockwise after @p side
+    Point cornerAfter(int side)
+    {
+        static const Point corners[4] = {{1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {0.0, 0.0}};
+        return corners[side];
+    }
+
+    /// Rounding can leave points on the image's edge a hair outside it
+    MeshVertex toVertex(const Point& point)
+    {
+        return {static_cast<float>(std::min(std::max(point.x, 0.0), 1.0)), static_cast<float>(std::min(std::max(point.y, 0.0), 1.0))};
+    }
+
+    void addTriangle(std::vector<MeshVertex>& mesh, const Point& a, const Point& b, const Point& c)
+    {
+        const double area = 0.5 * std::abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x));
+        if (area < MinArea)
+            return;
+        mesh.push_back(toVertex(a));
+        mesh.push_back(toVertex(b));
+        mesh.push_back(toVertex(c));
+    }
+
+} // end anonymous namespace
+
+std::vector<MeshVertex> computeHiddenAreaMesh(const DistortionModel& model, int eye, std::size_t tessellation, std::size_t max_triangles)
+{
+    std::vector<MeshVertex> mesh;
+    if (model.isIdentity() || tessellation < 1 || max_triangles < 12)
+        return mesh;
+
+    // Each segment of the outline takes two triangles, plus one more for each
+    // of the image's four corners.
+    const std::size_t per_side = std::min(tessellation, (max_triangles - 4) / 8);
+    const std::size_t count = 4 * per_side;
+
+    const DistortedPoint middle = model.compute(eye, 0.5f, 0.5f);
+    const Point center = {middle.channels[Green][0], middle.channels[Green][1]};
+    if (!(center.x > 0.0 && center.x < 1.0 && center.y > 0.0 && center.y < 1.0))
+        return mesh;
+
+    // Trace the distorted screen edge, and also halfway between each pair of
+    // points to see how far the true outline bulges past the straight line.
+    std::vector<Point> outline(count);
+    std::vector<double> bulge(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        outline[i] = outermostSample(model, eye, center, screenEdge(static_cast<double>(i) / per_side));
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const Point& a = outline[i];
+        const Point& b = outline[(i + 1) % count];
+        const Point halfway = outermostSample(model, eye, center, screenEdge((i + 0.5) / per_side));
+
+        double nx = b.y - a.y;
+        double ny = a.x - b.x;
+        const double length = std::sqrt(nx * nx + ny * ny);
+        if (length > 0.0) {
+            if (nx * (a.x - center.x) + ny * (a.y - center.y) < 0.0) {
+                nx = -nx;
+                ny = -ny;
+            }
+            bulge[i] = std::max(0.0, (nx * (halfway.x - a.x) + ny * (halfway.y - a.y)) / length);
+        }
+    }
+
+    // Push each point away from the center by enough to clear the bulge on
+    // either side of it, then pair it with where its ray leaves the image.
+    std::vector<Point> inner(count), outer(count);
+    std::vector<int> sides(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double push = 2.0 * std::max(bulge[i], bulge[(i + count - 1) % count]) + Margin;
+        const double radius = std::sqrt(distanceSquared(outline[i], center));
+        Point pushed = outline[i];
+        if (radius > 0.0) {
+            const double scale = 1.0 + push / radius;
+            pushed = {center.x + (outline[i].x - center.x) * scale, center.y + (outline[i].y - center.y) * scale};
+        }
+
+        outer[i] = imageEdge(center, pushed, sides[i]);
+        inner[i] = (distanceSquared(pushed, center) < distanceSquared(outer[i], center)) ? pushed : outer[i];
+    }
+
+    // Fill between the outline and the image's edge, turning the corners
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t next = (i + 1) % count;
+        if ((sides[i] + 1) % 4 == sides[next]) {
+            const Point corner = cornerAfter(sides[i]);
+            addTriangle(mesh, inner[i], outer[i], corner);
+            addTriangle(mesh, inner[i], corner, outer[next]);
+        } else {
+            addTriangle(mesh, inner[i], outer[i], outer[next]);
+        }
+        addTriangle(mesh, inner[i], outer[next], inner[next]);
+    }
+
+    return mesh;
+}
+
+} // end namespace distortion
+} // end namespace osvr
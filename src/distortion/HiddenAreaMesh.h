@@ -0,0 +1,66 @@
+/** @file
+    @brief Triangles covering the parts of an eye's rendered image that the
+    lens never shows.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_HiddenAreaMesh_h_GUID_26FFB91C_1626_42DE_9EEB_F9FF37475631
+#define INCLUDED_HiddenAreaMesh_h_GUID_26FFB91C_1626_42DE_9EEB_F9FF37475631
+
+// Internal Includes
+#include "DistortionModel.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <vector>
+
+namespace osvr {
+namespace distortion {
+
+/**
+ * A point in an eye's rendered image, in [0, 1] with (0, 0) at the top left.
+ * Laid out like vr::HmdVector2_t.
+ */
+struct MeshVertex {
+    float u;
+    float v;
+};
+
+/**
+ * Builds triangles, three vertices each, covering the parts of @p eye's
+ * rendered image that @p model never samples for any color channel: the
+ * region outside the outline the screen's edges trace once distorted.
+ *
+ * The outline is followed with @p tessellation points per screen side, fewer
+ * if needed to stay within @p max_triangles, and pushed outward enough to
+ * cover the curve between them, so the mesh never hides a visible pixel.
+ * Returns no triangles if the model samples the whole image.
+ */
+std::vector<MeshVertex> computeHiddenAreaMesh(const DistortionModel& model, int eye, std::size_t tessellation, std::size_t max_triangles);
+
+} // end namespace distortion
+} // end namespace osvr
+
+#endif // INCLUDED_HiddenAreaMesh_h_GUID_26FFB91C_1626_42DE_9EEB_F9FF37475631
@@ -0,0 +1,89 @@
+/** @file
+    @brief How finely the rendered image must be sampled to match the screen.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "RenderDensity.h"
+#include "DistortionModel.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>            // for std::abs, std::sqrt
+
+namespace osvr {
+namespace distortion {
+
+namespace {
+
+    /// Step for the central differences, in screen units
+    const double Step = 1e-4;
+
+} // end anonymous namespace
+
+RenderScale computeRenderScale(const DistortionModel& model, int eye, double u, double v, double screen_width, double screen_height)
+{
+    const RenderScale unchanged = {1.0, 1.0};
+    if (!(screen_width > 0.0) || !(screen_height > 0.0))
+        return unchanged;
+
+    // J: how far the rendered image point moves per unit of screen
+    double left[2], right[2], up[2], down[2];
+    model.compute(eye, Green, u - Step, v, left[0], left[1]);
+    model.compute(eye, Green, u + Step, v, right[0], right[1]);
+    model.compute(eye, Green, u, v - Step, up[0], up[1]);
+    model.compute(eye, Green, u, v + Step, down[0], down[1]);
+    const double j00 = (right[0] - left[0]) / (2.0 * Step);
+    const double j10 = (right[1] - left[1]) / (2.0 * Step);
+    const double j01 = (down[0] - up[0]) / (2.0 * Step);
+    const double j11 = (down[1] - up[1]) / (2.0 * Step);
+
+    const double determinant = j00 * j11 - j01 * j10;
+    if (std::abs(determinant) < 1e-12)
+        return unchanged;
+
+    // Its inverse says how far across the screen a step along each of the
+    // rendered image's axes goes; that many screen pixels need as many
+    // rendered ones.
+    const double k00 = j11 / determinant;
+    const double k01 = -j01 / determinant;
+    const double k10 = -j10 / determinant;
+    const double k11 = j00 / determinant;
+    const double aspect = screen_height / screen_width;
+
+    RenderScale scale;
+    scale.x = std::sqrt(k00 * k00 + (aspect * k10) * (aspect * k10));
+    scale.y = std::sqrt((k01 / aspect) * (k01 / aspect) + k11 * k11);
+    return scale;
+}
+
+RenderScale computeCenterRenderScale(const DistortionModel& model, int eye, double screen_width, double screen_height)
+{
+    double u = 0.5, v = 0.5;
+    model.getCenter(eye, u, v);
+    return computeRenderScale(model, eye, u, v, screen_width, screen_height);
+}
+
+} // end namespace distortion
+} // end namespace osvr
@@ -0,0 +1,67 @@
+/** @file
+    @brief How finely the rendered image must be sampled to match the screen.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_RenderDensity_h_GUID_7338897A_A44A_4602_A233_EA9C50246D92
+#define INCLUDED_RenderDensity_h_GUID_7338897A_A44A_4602_A233_EA9C50246D92
+
+// Internal Includes
+#include "DistortionModel.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace distortion {
+
+/**
+ * The rendered image's size, as a multiple of the eye's screen size, along
+ * each of its axes.
+ */
+struct RenderScale {
+    double x;
+    double y;
+};
+
+/**
+ * How large the rendered image must be, relative to the screen, for one of
+ * its pixels to land on each screen pixel at (@p u, @p v) of @p eye's
+ * screen. Worked out from the Jacobian of the green channel's distortion
+ * there; @p screen_width and @p screen_height are the eye's screen size in
+ * pixels, needed when its pixels aren't square in [0, 1] coordinates.
+ */
+RenderScale computeRenderScale(const DistortionModel& model, int eye, double u, double v, double screen_width, double screen_height);
+
+/**
+ * computeRenderScale() at the center of @p eye's lens, where the eye sees
+ * most sharply.
+ */
+RenderScale computeCenterRenderScale(const DistortionModel& model, int eye, double screen_width, double screen_height);
+
+} // end namespace distortion
+} // end namespace osvr
+
+#endif // INCLUDED_RenderDensity_h_GUID_7338897A_A44A_4602_A233_EA9C50246D92
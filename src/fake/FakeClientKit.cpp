@@ -0,0 +1,575 @@
+/** @file
+    @brief An in-process stand-in for the OSVR server, behind the ClientKit C
+    API.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "FakeClientKit.h"
+
+// Library/third-party includes
+#include <osvr/ClientKit/ContextC.h>
+#include <osvr/ClientKit/DisplayC.h>
+#include <osvr/ClientKit/InterfaceC.h>
+#include <osvr/ClientKit/InterfaceCallbackC.h>
+#include <osvr/ClientKit/ParametersC.h>
+
+// Standard includes
+#include <algorithm>        // for std::find
+#include <cstring>          // for std::memcpy
+
+namespace osvr {
+namespace fake {
+
+namespace {
+
+FakeEye makeHdkEye(double x, OSVR_ViewportDimension viewport_left)
+{
+    FakeEye eye = {};
+    eye.pose.translation.data[0] = x;
+    eye.pose.rotation.data[0] = 1.0;
+    eye.viewport[0] = viewport_left;
+    eye.viewport[1] = 0;
+    eye.viewport[2] = 960;
+    eye.viewport[3] = 1080;
+    // 90 degrees across, with square pixels
+    eye.clippingPlanes[0] = -1.0;
+    eye.clippingPlanes[1] = 1.0;
+    eye.clippingPlanes[2] = -1.125;
+    eye.clippingPlanes[3] = 1.125;
+    eye.wantsDistortion = false;
+    eye.radialDistortionPriority = -1;
+    return eye;
+}
+
+} // end anonymous namespace
+
+FakeDisplay makeHdkDisplay()
+{
+    FakeDisplay display;
+    display.width = 1920;
+    display.height = 1080;
+    display.eyes.push_back(makeHdkEye(-0.0315, 0));
+    display.eyes.push_back(makeHdkEye(0.0315, 960));
+    return display;
+}
+
+FakeServer& FakeServer::instance()
+{
+    static FakeServer instance_;
+    return instance_;
+}
+
+FakeServer::FakeServer() : display_(makeHdkDisplay())
+{
+    // do nothing
+}
+
+void FakeServer::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stringParameters_.clear();
+    contextStartupUpdates_ = 0;
+    displayStartupUpdates_ = 0;
+    display_ = makeHdkDisplay();
+    poseReports_.clear();
+    velocityReports_.clear();
+    updateCount_ = 0;
+    deliveredReportCount_ = 0;
+}
+
+void FakeServer::setStringParameter(const std::string& path, const std::string& value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stringParameters_[path] = value;
+}
+
+void FakeServer::setStartupUpdates(std::size_t context_updates, std::size_t display_updates)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    contextStartupUpdates_ = context_updates;
+    displayStartupUpdates_ = display_updates;
+}
+
+void FakeServer::setDisplay(const FakeDisplay& display)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    display_ = display;
+}
+
+void FakeServer::queuePoseReport(const std::string& path, const OSVR_TimeValue& timestamp, const OSVR_PoseReport& report)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    poseReports_.push_back({ path, timestamp, report });
+}
+
+void FakeServer::queueVelocityReport(const std::string& path, const OSVR_TimeValue& timestamp, const OSVR_VelocityReport& report)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    velocityReports_.push_back({ path, timestamp, report });
+}
+
+std::size_t FakeServer::getUpdateCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return updateCount_;
+}
+
+std::size_t FakeServer::getDeliveredReportCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return deliveredReportCount_;
+}
+
+std::size_t FakeServer::getOpenContextCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return contexts_.size();
+}
+
+std::size_t FakeServer::getOpenInterfaceCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return openInterfaceCount_;
+}
+
+FakeServer::Context* FakeServer::openContext()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto context = new Context;
+    context->startupUpdates = contextStartupUpdates_;
+    contexts_.push_back(context);
+    return context;
+}
+
+void FakeServer::closeContext(Context* context)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto found = std::find(begin(contexts_), end(contexts_), context);
+    if (found == end(contexts_))
+        return;
+
+    for (auto iface : context->interfaces) {
+        delete iface;
+        --openInterfaceCount_;
+    }
+    contexts_.erase(found);
+    delete context;
+}
+
+void FakeServer::update(Context* context)
+{
+    std::vector<QueuedReport<OSVR_PoseReport>> pose_reports;
+    std::vector<QueuedReport<OSVR_VelocityReport>> velocity_reports;
+    std::vector<Interface> interfaces;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++context->updates;
+        ++updateCount_;
+        pose_reports.swap(poseReports_);
+        velocity_reports.swap(velocityReports_);
+        for (const auto iface : context->interfaces) {
+            interfaces.push_back(*iface);
+        }
+    }
+
+    // Call back without the lock held, so callbacks may queue more reports.
+    std::size_t delivered = 0;
+    for (const auto& queued : pose_reports) {
+        for (const auto& iface : interfaces) {
+            if (iface.path != queued.path)
+                continue;
+            for (const auto& callback : iface.poseCallbacks) {
+                callback.first(callback.second, &queued.timestamp, &queued.report);
+                ++delivered;
+            }
+        }
+    }
+    for (const auto& queued : velocity_reports) {
+        for (const auto& iface : interfaces) {
+            if (iface.path != queued.path)
+                continue;
+            for (const auto& callback : iface.velocityCallbacks) {
+                callback.first(callback.second, &queued.timestamp, &queued.report);
+                ++delivered;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    deliveredReportCount_ += delivered;
+}
+
+bool FakeServer::hasStarted(const Context* context) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return context->updates >= context->startupUpdates;
+}
+
+bool FakeServer::getStringParameter(const std::string& path, std::string& value) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto found = stringParameters_.find(path);
+    if (found == stringParameters_.end())
+        return false;
+
+    value = found->second;
+    return true;
+}
+
+FakeServer::Interface* FakeServer::openInterface(Context* context, const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iface = new Interface;
+    iface->path = path;
+    context->interfaces.push_back(iface);
+    ++openInterfaceCount_;
+    return iface;
+}
+
+bool FakeServer::closeInterface(Context* context, Interface* iface)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& interfaces = context->interfaces;
+    const auto found = std::find(begin(interfaces), end(interfaces), iface);
+    if (found == end(interfaces))
+        return false;
+
+    interfaces.erase(found);
+    delete iface;
+    --openInterfaceCount_;
+    return true;
+}
+
+bool FakeServer::registerCallback(Interface* iface, OSVR_PoseCallback callback, void* userdata)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    iface->poseCallbacks.emplace_back(callback, userdata);
+    return true;
+}
+
+bool FakeServer::registerCallback(Interface* iface, OSVR_VelocityCallback callback, void* userdata)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    iface->velocityCallbacks.emplace_back(callback, userdata);
+    return true;
+}
+
+FakeServer::Display* FakeServer::openDisplay(Context* context)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return new Display{ context, context->updates + displayStartupUpdates_, display_ };
+}
+
+void FakeServer::closeDisplay(Display* display)
+{
+    delete display;
+}
+
+bool FakeServer::hasStarted(const Display* display) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return display->context->updates >= display->readyAtUpdate;
+}
+
+} // end namespace fake
+} // end namespace osvr
+
+//
+// The ClientKit C API, as far as the driver uses it. The handles the API
+// hands out are the fake server's own objects.
+//
+
+using osvr::fake::FakeEye;
+using osvr::fake::FakeServer;
+
+namespace {
+
+FakeServer::Context* toContext(OSVR_ClientContext ctx)
+{
+    return reinterpret_cast<FakeServer::Context*>(ctx);
+}
+
+FakeServer::Interface* toInterface(OSVR_ClientInterface iface)
+{
+    return reinterpret_cast<FakeServer::Interface*>(iface);
+}
+
+FakeServer::Display* toDisplay(OSVR_DisplayConfig disp)
+{
+    return reinterpret_cast<FakeServer::Display*>(disp);
+}
+
+OSVR_ReturnCode toReturnCode(bool success)
+{
+    return success ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
+}
+
+/// Looks up a surface, failing for anything but the one surface of an
+/// existing eye of the one viewer.
+const FakeEye* getEye(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye, OSVR_SurfaceCount surface = 0)
+{
+    if (!disp || viewer != 0 || surface != 0)
+        return nullptr;
+
+    const auto& eyes = toDisplay(disp)->config.eyes;
+    if (eye >= eyes.size())
+        return nullptr;
+
+    return &eyes[eye];
+}
+
+} // end anonymous namespace
+
+OSVR_ClientContext osvrClientInit(const char[], uint32_t)
+{
+    return reinterpret_cast<OSVR_ClientContext>(FakeServer::instance().openContext());
+}
+
+OSVR_ReturnCode osvrClientUpdate(OSVR_ClientContext ctx)
+{
+    if (!ctx)
+        return OSVR_RETURN_FAILURE;
+
+    FakeServer::instance().update(toContext(ctx));
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientCheckStatus(OSVR_ClientContext ctx)
+{
+    return toReturnCode(ctx && FakeServer::instance().hasStarted(toContext(ctx)));
+}
+
+OSVR_ReturnCode osvrClientShutdown(OSVR_ClientContext ctx)
+{
+    if (!ctx)
+        return OSVR_RETURN_FAILURE;
+
+    FakeServer::instance().closeContext(toContext(ctx));
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetStringParameterLength(OSVR_ClientContext ctx, const char path[], size_t* len)
+{
+    if (!ctx || !path || !len)
+        return OSVR_RETURN_FAILURE;
+
+    // Missing parameters read as empty, as they do from a real server.
+    std::string value;
+    *len = FakeServer::instance().getStringParameter(path, value) ? value.size() + 1 : 0;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetStringParameter(OSVR_ClientContext ctx, const char path[], char* buf, size_t len)
+{
+    if (!ctx || !path || !buf)
+        return OSVR_RETURN_FAILURE;
+
+    std::string value;
+    FakeServer::instance().getStringParameter(path, value);
+    if (len < value.size() + 1)
+        return OSVR_RETURN_FAILURE;
+
+    std::memcpy(buf, value.c_str(), value.size() + 1);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetInterface(OSVR_ClientContext ctx, const char path[], OSVR_ClientInterface* iface)
+{
+    if (!ctx || !path || !iface)
+        return OSVR_RETURN_FAILURE;
+
+    *iface = reinterpret_cast<OSVR_ClientInterface>(FakeServer::instance().openInterface(toContext(ctx), path));
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientFreeInterface(OSVR_ClientContext ctx, OSVR_ClientInterface iface)
+{
+    if (!ctx || !iface)
+        return OSVR_RETURN_FAILURE;
+
+    return toReturnCode(FakeServer::instance().closeInterface(toContext(ctx), toInterface(iface)));
+}
+
+OSVR_ReturnCode osvrRegisterPoseCallback(OSVR_ClientInterface iface, OSVR_PoseCallback cb, void* userdata)
+{
+    return toReturnCode(iface && cb && FakeServer::instance().registerCallback(toInterface(iface), cb, userdata));
+}
+
+OSVR_ReturnCode osvrRegisterVelocityCallback(OSVR_ClientInterface iface, OSVR_VelocityCallback cb, void* userdata)
+{
+    return toReturnCode(iface && cb && FakeServer::instance().registerCallback(toInterface(iface), cb, userdata));
+}
+
+OSVR_ReturnCode osvrClientGetDisplay(OSVR_ClientContext ctx, OSVR_DisplayConfig* disp)
+{
+    if (!ctx || !disp)
+        return OSVR_RETURN_FAILURE;
+
+    *disp = reinterpret_cast<OSVR_DisplayConfig>(FakeServer::instance().openDisplay(toContext(ctx)));
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientFreeDisplay(OSVR_DisplayConfig disp)
+{
+    if (!disp)
+        return OSVR_RETURN_FAILURE;
+
+    FakeServer::instance().closeDisplay(toDisplay(disp));
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientCheckDisplayStartup(OSVR_DisplayConfig disp)
+{
+    return toReturnCode(disp && FakeServer::instance().hasStarted(toDisplay(disp)));
+}
+
+OSVR_ReturnCode osvrClientGetNumDisplayInputs(OSVR_DisplayConfig disp, OSVR_DisplayInputCount* numDisplayInputs)
+{
+    if (!disp || !numDisplayInputs)
+        return OSVR_RETURN_FAILURE;
+
+    *numDisplayInputs = 1;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetDisplayDimensions(OSVR_DisplayConfig disp, OSVR_DisplayInputCount displayInputIndex, OSVR_DisplayDimension* width, OSVR_DisplayDimension* height)
+{
+    if (!disp || displayInputIndex != 0 || !width || !height)
+        return OSVR_RETURN_FAILURE;
+
+    *width = toDisplay(disp)->config.width;
+    *height = toDisplay(disp)->config.height;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetNumViewers(OSVR_DisplayConfig disp, OSVR_ViewerCount* viewers)
+{
+    if (!disp || !viewers)
+        return OSVR_RETURN_FAILURE;
+
+    *viewers = 1;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetViewerPose(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_Pose3* pose)
+{
+    if (!disp || viewer != 0 || !pose)
+        return OSVR_RETURN_FAILURE;
+
+    *pose = OSVR_Pose3{};
+    pose->rotation.data[0] = 1.0;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetNumEyesForViewer(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount* eyes)
+{
+    if (!disp || viewer != 0 || !eyes)
+        return OSVR_RETURN_FAILURE;
+
+    *eyes = static_cast<OSVR_EyeCount>(toDisplay(disp)->config.eyes.size());
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyePose(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye, OSVR_Pose3* pose)
+{
+    const auto fake_eye = getEye(disp, viewer, eye);
+    if (!fake_eye || !pose)
+        return OSVR_RETURN_FAILURE;
+
+    *pose = fake_eye->pose;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetNumSurfacesForViewerEye(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye, OSVR_SurfaceCount* surfaces)
+{
+    if (!getEye(disp, viewer, eye) || !surfaces)
+        return OSVR_RETURN_FAILURE;
+
+    *surfaces = 1;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetRelativeViewportForViewerEyeSurface(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye, OSVR_SurfaceCount surface, OSVR_ViewportDimension* left, OSVR_ViewportDimension* bottom, OSVR_ViewportDimension* width, OSVR_ViewportDimension* height)
+{
+    const auto fake_eye = getEye(disp, viewer, eye, surface);
+    if (!fake_eye || !left || !bottom || !width || !height)
+        return OSVR_RETURN_FAILURE;
+
+    *left = fake_eye->viewport[0];
+    *bottom = fake_eye->viewport[1];
+    *width = fake_eye->viewport[2];
+    *height = fake_eye->viewport[3];
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeSurfaceDisplayInputIndex(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye, OSVR_SurfaceCount surface, OSVR_DisplayInputCount* displayInput)
+{
+    if (!getEye(disp, viewer, eye, surface) || !displayInput)
+        return OSVR_RETURN_FAILURE;
+
+    *displayInput = 0;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeSurfaceProjectionClippingPlanes(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye, OSVR_SurfaceCount surface, double* left, double* right, double* bottom, double* top)
+{
+    const auto fake_eye = getEye(disp, viewer, eye, surface);
+    if (!fake_eye || !left || !right || !bottom || !top)
+        return OSVR_RETURN_FAILURE;
+
+    *left = fake_eye->clippingPlanes[0];
+    *right = fake_eye->clippingPlanes[1];
+    *bottom = fake_eye->clippingPlanes[2];
+    *top = fake_eye->clippingPlanes[3];
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientDoesViewerEyeSurfaceWantDistortion(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye, OSVR_SurfaceCount surface, OSVR_CBool* distortionRequested)
+{
+    const auto fake_eye = getEye(disp, viewer, eye, surface);
+    if (!fake_eye || !distortionRequested)
+        return OSVR_RETURN_FAILURE;
+
+    *distortionRequested = fake_eye->wantsDistortion ? OSVR_TRUE : OSVR_FALSE;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeSurfaceRadialDistortionPriority(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye, OSVR_SurfaceCount surface, OSVR_DistortionPriority* priority)
+{
+    const auto fake_eye = getEye(disp, viewer, eye, surface);
+    if (!fake_eye || !priority)
+        return OSVR_RETURN_FAILURE;
+
+    *priority = fake_eye->radialDistortionPriority;
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetViewerEyeSurfaceRadialDistortion(OSVR_DisplayConfig disp, OSVR_ViewerCount viewer, OSVR_EyeCount eye, OSVR_SurfaceCount surface, OSVR_RadialDistortionParameters* params)
+{
+    const auto fake_eye = getEye(disp, viewer, eye, surface);
+    if (!fake_eye || !params || fake_eye->radialDistortionPriority < 0)
+        return OSVR_RETURN_FAILURE;
+
+    *params = fake_eye->radialDistortion;
+    return OSVR_RETURN_SUCCESS;
+}
@@ -0,0 +1,189 @@
+/** @file
+    @brief An in-process stand-in for the OSVR server, behind the ClientKit C
+    API.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_FakeClientKit_h_GUID_B5C285A8_DDDD_43E1_A4BD_980A8EFB02EF
+#define INCLUDED_FakeClientKit_h_GUID_B5C285A8_DDDD_43E1_A4BD_980A8EFB02EF
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/RenderingTypesC.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace fake {
+
+/**
+ * @brief One eye of the fake display, with a single surface.
+ */
+struct FakeEye {
+    OSVR_Pose3 pose;                                ///< eye pose, in room space
+    OSVR_ViewportDimension viewport[4];             ///< left, bottom, width, height
+    double clippingPlanes[4];                       ///< left, right, bottom, top, at unit distance
+    bool wantsDistortion;
+    OSVR_DistortionPriority radialDistortionPriority; ///< negative if none
+    OSVR_RadialDistortionParameters radialDistortion;
+};
+
+/**
+ * @brief The display configuration the fake server reports: one viewer whose
+ * eyes each have one surface.
+ */
+struct FakeDisplay {
+    OSVR_DisplayDimension width;
+    OSVR_DisplayDimension height;
+    std::vector<FakeEye> eyes;
+};
+
+/**
+ * Returns a display laid out like an OSVR HDK: a 1920x1080 panel split
+ * side-by-side between two eyes 63 mm apart.
+ */
+FakeDisplay makeHdkDisplay();
+
+/**
+ * @brief Stands in for the OSVR server when linked in place of the ClientKit
+ * library.
+ *
+ * This library defines the ClientKit C functions the driver calls, so the
+ * header-only ClientKit C++ wrappers (ClientContext, Interface,
+ * DisplayConfig) run unchanged against it. Whatever the test sets up here is
+ * what every context sees: string parameters, the display, how many updates
+ * startup takes, and reports to deliver. Queued reports are delivered to the
+ * callbacks registered for their path on the next context update, on the
+ * thread calling update, just as the real client library does.
+ *
+ * All members are safe to call from any thread.
+ */
+class FakeServer {
+public:
+    static FakeServer& instance();
+
+    // We're a singleton
+    FakeServer(FakeServer const&) = delete;
+    FakeServer& operator=(FakeServer const&) = delete;
+
+    /**
+     * Forgets all parameters, queued reports and counts, and goes back to an
+     * HDK display that's ready immediately. Contexts still open keep
+     * working.
+     */
+    void reset();
+
+    void setStringParameter(const std::string& path, const std::string& value);
+
+    /**
+     * Sets how many context updates pass before a new context reports it has
+     * started up, and before a new display config does.
+     */
+    void setStartupUpdates(std::size_t context_updates, std::size_t display_updates);
+
+    void setDisplay(const FakeDisplay& display);
+
+    /**
+     * Queues a report for delivery on the next update of any context.
+     */
+    void queuePoseReport(const std::string& path, const OSVR_TimeValue& timestamp, const OSVR_PoseReport& report);
+    void queueVelocityReport(const std::string& path, const OSVR_TimeValue& timestamp, const OSVR_VelocityReport& report);
+
+    /** \name What the driver did with the fake. */
+    //@{
+    std::size_t getUpdateCount() const;
+    std::size_t getDeliveredReportCount() const;
+    std::size_t getOpenContextCount() const;
+    std::size_t getOpenInterfaceCount() const;
+    //@}
+
+    /** \name Implementation of the ClientKit C API. */
+    //@{
+    struct Interface {
+        std::string path;
+        std::vector<std::pair<OSVR_PoseCallback, void*>> poseCallbacks;
+        std::vector<std::pair<OSVR_VelocityCallback, void*>> velocityCallbacks;
+    };
+
+    struct Context {
+        std::size_t updates = 0;
+        std::size_t startupUpdates = 0;
+        std::vector<Interface*> interfaces;
+    };
+
+    struct Display {
+        Context* context;
+        std::size_t readyAtUpdate;
+        FakeDisplay config;
+    };
+
+    Context* openContext();
+    void closeContext(Context* context);
+    void update(Context* context);
+    bool hasStarted(const Context* context) const;
+    bool getStringParameter(const std::string& path, std::string& value) const;
+    Interface* openInterface(Context* context, const std::string& path);
+    bool closeInterface(Context* context, Interface* iface);
+    bool registerCallback(Interface* iface, OSVR_PoseCallback callback, void* userdata);
+    bool registerCallback(Interface* iface, OSVR_VelocityCallback callback, void* userdata);
+    Display* openDisplay(Context* context);
+    void closeDisplay(Display* display);
+    bool hasStarted(const Display* display) const;
+    //@}
+
+private:
+    FakeServer();
+
+    template <typename Report>
+    struct QueuedReport {
+        std::string path;
+        OSVR_TimeValue timestamp;
+        Report report;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::string> stringParameters_;
+    std::size_t contextStartupUpdates_ = 0;
+    std::size_t displayStartupUpdates_ = 0;
+    FakeDisplay display_;
+    std::vector<QueuedReport<OSVR_PoseReport>> poseReports_;
+    std::vector<QueuedReport<OSVR_VelocityReport>> velocityReports_;
+    std::vector<Context*> contexts_;
+    std::size_t updateCount_ = 0;
+    std::size_t deliveredReportCount_ = 0;
+    std::size_t openInterfaceCount_ = 0;
+};
+
+} // end namespace fake
+} // end namespace osvr
+
+#endif // INCLUDED_FakeClientKit_h_GUID_B5C285A8_DDDD_43E1_A4BD_980A8EFB02EF
@@ -0,0 +1,226 @@
+/** @file
+    @brief Stand-ins for SteamVR's server driver host and settings.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_FakeServerDriverHost_h_GUID_0805FB4C_A787_4815_AA58_E1A97C741955
+#define INCLUDED_FakeServerDriverHost_h_GUID_0805FB4C_A787_4815_AA58_E1A97C741955
+
+// Internal Includes
+#include "osvr_compiler_detection.h"    // for OSVR_OVERRIDE
+
+// Library/third-party includes
+#include <openvr_driver.h>
+
+// Standard includes
+#include <atomic>
+#include <cstdint>
+#include <cstring>                      // for std::strncpy
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace osvr {
+namespace fake {
+
+/**
+ * @brief Settings held in memory, set by the test or from the command line.
+ * Keys are looked up regardless of section.
+ */
+class FakeSettings : public vr::IVRSettings {
+public:
+    void set(const std::string& key, const std::string& value)
+    {
+        values_[key] = value;
+    }
+
+    const char* GetSettingsErrorNameFromEnum(vr::EVRSettingsError) OSVR_OVERRIDE
+    {
+        return "";
+    }
+
+    bool Sync(bool, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        return true;
+    }
+
+    bool GetBool(const char*, const char* key, bool default_value, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        const auto value = values_.find(key);
+        return (values_.end() == value) ? default_value : (value->second == "true" || value->second == "1");
+    }
+
+    void SetBool(const char*, const char* key, bool value, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        values_[key] = value ? "true" : "false";
+    }
+
+    int32_t GetInt32(const char*, const char* key, int32_t default_value, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        const auto value = values_.find(key);
+        return (values_.end() == value) ? default_value : static_cast<int32_t>(std::stol(value->second));
+    }
+
+    void SetInt32(const char*, const char* key, int32_t value, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        values_[key] = std::to_string(value);
+    }
+
+    float GetFloat(const char*, const char* key, float default_value, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        const auto value = values_.find(key);
+        return (values_.end() == value) ? default_value : std::stof(value->second);
+    }
+
+    void SetFloat(const char*, const char* key, float value, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        values_[key] = std::to_string(value);
+    }
+
+    void GetString(const char*, const char* key, char* value, uint32_t value_size, const char* default_value, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        if (!value || 0 == value_size)
+            return;
+        const auto found = values_.find(key);
+        const char* result = (values_.end() == found) ? default_value : found->second.c_str();
+        std::strncpy(value, result ? result : "", value_size);
+        value[value_size - 1] = '\0';
+    }
+
+    void SetString(const char*, const char* key, const char* value, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        values_[key] = value ? value : "";
+    }
+
+    void RemoveSection(const char*, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        values_.clear();
+    }
+
+    void RemoveKeyInSection(const char*, const char* key, vr::EVRSettingsError*) OSVR_OVERRIDE
+    {
+        values_.erase(key);
+    }
+
+private:
+    std::map<std::string, std::string> values_;
+};
+
+/**
+ * @brief Stands in for SteamVR: hands out settings and keeps the poses it's
+ * sent.
+ */
+class FakeServerDriverHost : public vr::IServerDriverHost {
+public:
+    FakeSettings& getFakeSettings()
+    {
+        return settings_;
+    }
+
+    uint64_t getPoseCount() const
+    {
+        return poseCount_;
+    }
+
+    uint64_t getPropertiesChangedCount() const
+    {
+        return propertiesChangedCount_;
+    }
+
+    vr::DriverPose_t getLastPose() const
+    {
+        std::lock_guard<std::mutex> lock(lastPoseMutex_);
+        return lastPose_;
+    }
+
+    bool TrackedDeviceAdded(const char*) OSVR_OVERRIDE
+    {
+        return true;
+    }
+
+    void TrackedDevicePoseUpdated(uint32_t, const vr::DriverPose_t& pose) OSVR_OVERRIDE
+    {
+        {
+            std::lock_guard<std::mutex> lock(lastPoseMutex_);
+            lastPose_ = pose;
+        }
+        poseCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void TrackedDevicePropertiesChanged(uint32_t) OSVR_OVERRIDE
+    {
+        propertiesChangedCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void VsyncEvent(double) OSVR_OVERRIDE {}
+    void TrackedDeviceButtonPressed(uint32_t, uint32_t, double) OSVR_OVERRIDE {}
+    void TrackedDeviceButtonUnpressed(uint32_t, uint32_t, double) OSVR_OVERRIDE {}
+    void TrackedDeviceButtonTouched(uint32_t, uint32_t, double) OSVR_OVERRIDE {}
+    void TrackedDeviceButtonUntouched(uint32_t, uint32_t, double) OSVR_OVERRIDE {}
+    void TrackedDeviceAxisUpdated(uint32_t, uint32_t, const vr::VRControllerAxis_t&) OSVR_OVERRIDE {}
+    void MCImageUpdated() OSVR_OVERRIDE {}
+
+    vr::IVRSettings* GetSettings(const char*) OSVR_OVERRIDE
+    {
+        return &settings_;
+    }
+
+    void PhysicalIpdSet(uint32_t, const float) OSVR_OVERRIDE {}
+    void ProximitySensorState(uint32_t, bool) OSVR_OVERRIDE {}
+    void VendorSpecificEvent(uint32_t, vr::EVREventType, const vr::VREvent_Data_t&, double) OSVR_OVERRIDE {}
+
+    bool IsExiting() OSVR_OVERRIDE
+    {
+        return false;
+    }
+
+private:
+    FakeSettings settings_;
+    mutable std::mutex lastPoseMutex_;
+    vr::DriverPose_t lastPose_ = {};
+    std::atomic<uint64_t> poseCount_{0};
+    std::atomic<uint64_t> propertiesChangedCount_{0};
+};
+
+/**
+ * @brief Stands in for SteamVR on the client side: hands out settings.
+ */
+class FakeClientDriverHost : public vr::IClientDriverHost {
+public:
+    FakeSettings& getFakeSettings()
+    {
+        return settings_;
+    }
+
+    vr::IVRSettings* GetSettings(const char*) OSVR_OVERRIDE
+    {
+        return &settings_;
+    }
+
+private:
+    FakeSettings settings_;
+};
+
+} // end namespace fake
+} // end namespace osvr
+
+#endif // INCLUDED_FakeServerDriverHost_h_GUID_0805FB4C_A787_4815_AA58_E1A97C741955
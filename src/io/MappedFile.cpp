@@ -0,0 +1,79 @@
+/** @file
+    @brief A file mapped into memory.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "MappedFile.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <string>
+
+#if defined(_WIN32)
+#include "MappedFile_Windows.h"
+#else
+#include "MappedFile_POSIX.h"
+#endif
+
+namespace osvr {
+namespace io {
+
+MappedFile::MappedFile() : impl_(new Impl)
+{
+    // do nothing
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::isOpen() const
+{
+    return nullptr != data_;
+}
+
+void* MappedFile::data()
+{
+    return data_;
+}
+
+const void* MappedFile::data() const
+{
+    return data_;
+}
+
+std::size_t MappedFile::size() const
+{
+    return size_;
+}
+
+const std::string& MappedFile::getError() const
+{
+    return error_;
+}
+
+} // end namespace io
+} // end namespace osvr
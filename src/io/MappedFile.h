@@ -0,0 +1,96 @@
+/** @file
+    @brief A file mapped into memory.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MappedFile_h_GUID_7DB471B1_7314_476E_B965_8FCAF20658EB
+#define INCLUDED_MappedFile_h_GUID_7DB471B1_7314_476E_B965_8FCAF20658EB
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <memory>           // for std::unique_ptr
+#include <string>
+
+namespace osvr {
+namespace io {
+
+/**
+ * @brief Maps a whole file into memory, either read-only or for writing.
+ *
+ * Failures are reported by return value, with a description available from
+ * getError().
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Creates (or replaces) the file at @p path, sets aside @p size bytes of
+     * disk for it and maps it for writing. The pages are faulted in up front
+     * so that writing to them later doesn't need the kernel.
+     */
+    bool create(const std::string& path, std::size_t size);
+
+    /**
+     * Maps the existing file at @p path read-only.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * Unmaps the file. If it was created for writing, it's first cut down to
+     * @p final_size bytes (if that's smaller than its current size).
+     */
+    void close(std::size_t final_size = static_cast<std::size_t>(-1));
+
+    bool isOpen() const;
+    void* data();
+    const void* data() const;
+    std::size_t size() const;
+
+    /**
+     * Describes the last failure.
+     */
+    const std::string& getError() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool writable_ = false;
+    std::string error_;
+};
+
+} // end namespace io
+} // end namespace osvr
+
+#endif // INCLUDED_MappedFile_h_GUID_7DB471B1_7314_476E_B965_8FCAF20658EB
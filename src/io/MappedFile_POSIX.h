@@ -0,0 +1,170 @@
+/** @file
+    @brief POSIX implementation of MappedFile.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MappedFile_POSIX_h_GUID_2DEC8246_0B3E_48D7_AF17_CE90D7ED89F4
+#define INCLUDED_MappedFile_POSIX_h_GUID_2DEC8246_0B3E_48D7_AF17_CE90D7ED89F4
+
+// Internal Includes
+#include "MappedFile.h"
+
+// Library/third-party includes
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Standard includes
+#include <cerrno>
+#include <cstring>          // for std::strerror
+#include <string>
+
+namespace osvr {
+namespace io {
+
+struct MappedFile::Impl {
+    int fd = -1;
+};
+
+namespace {
+
+std::string describeError(const std::string& what, const std::string& path)
+{
+    return what + " " + path + ": " + std::strerror(errno);
+}
+
+} // end anonymous namespace
+
+bool MappedFile::create(const std::string& path, std::size_t size)
+{
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        error_ = describeError("Unable to create", path);
+        return false;
+    }
+
+    // Reserve the disk space now: running out of it while writing to a
+    // mapping would be a SIGBUS rather than an error we can handle.
+#if defined(__linux__)
+    const int allocated = ::posix_fallocate(fd, 0, static_cast<off_t>(size));
+#else
+    const int allocated = (::ftruncate(fd, static_cast<off_t>(size)) == 0) ? 0 : errno;
+#endif
+    if (allocated != 0) {
+        errno = allocated;
+        error_ = describeError("Unable to allocate space for", path);
+        ::close(fd);
+        ::unlink(path.c_str());
+        return false;
+    }
+
+    int flags = MAP_SHARED;
+#if defined(MAP_POPULATE)
+    flags |= MAP_POPULATE;
+#endif
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, fd, 0);
+    if (MAP_FAILED == data) {
+        error_ = describeError("Unable to map", path);
+        ::close(fd);
+        ::unlink(path.c_str());
+        return false;
+    }
+
+#if !defined(MAP_POPULATE)
+    // Touch every page so the first write to each doesn't fault.
+    const long page_size = ::sysconf(_SC_PAGESIZE);
+    for (std::size_t offset = 0; offset < size; offset += static_cast<std::size_t>(page_size)) {
+        static_cast<volatile char*>(data)[offset] = 0;
+    }
+#endif
+
+    impl_->fd = fd;
+    data_ = data;
+    size_ = size;
+    writable_ = true;
+    return true;
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error_ = describeError("Unable to open", path);
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        error_ = describeError("Unable to get the size of", path);
+        ::close(fd);
+        return false;
+    }
+
+    const auto size = static_cast<std::size_t>(info.st_size);
+    if (0 == size) {
+        error_ = path + " is empty";
+        ::close(fd);
+        return false;
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == data) {
+        error_ = describeError("Unable to map", path);
+        ::close(fd);
+        return false;
+    }
+
+    impl_->fd = fd;
+    data_ = data;
+    size_ = size;
+    writable_ = false;
+    return true;
+}
+
+void MappedFile::close(std::size_t final_size)
+{
+    if (!data_)
+        return;
+
+    ::munmap(data_, size_);
+    if (writable_ && final_size < size_) {
+        if (::ftruncate(impl_->fd, static_cast<off_t>(final_size)) != 0) {
+            // The file is still valid, just bigger than it needs to be.
+        }
+    }
+    ::close(impl_->fd);
+
+    impl_->fd = -1;
+    data_ = nullptr;
+    size_ = 0;
+    writable_ = false;
+}
+
+} // end namespace io
+} // end namespace osvr
+
+#endif // INCLUDED_MappedFile_POSIX_h_GUID_2DEC8246_0B3E_48D7_AF17_CE90D7ED89F4
@@ -0,0 +1,173 @@
+/** @file
+    @brief Windows implementation of MappedFile.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_MappedFile_Windows_h_GUID_953A6435_C5AE_4043_AE55_6F57424ED6E0
+#define INCLUDED_MappedFile_Windows_h_GUID_953A6435_C5AE_4043_AE55_6F57424ED6E0
+
+// Internal Includes
+#include "MappedFile.h"
+
+// Library/third-party includes
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+// Standard includes
+#include <cstdint>
+#include <string>
+
+namespace osvr {
+namespace io {
+
+struct MappedFile::Impl {
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+};
+
+namespace {
+
+std::string describeError(const std::string& what, const std::string& path)
+{
+    return what + " " + path + " (error " + std::to_string(::GetLastError()) + ")";
+}
+
+} // end anonymous namespace
+
+bool MappedFile::create(const std::string& path, std::size_t size)
+{
+    close();
+
+    HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file) {
+        error_ = describeError("Unable to create", path);
+        return false;
+    }
+
+    // Creating the mapping extends the file to the full size.
+    const auto size64 = static_cast<uint64_t>(size);
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xffffffff), nullptr);
+    if (!mapping) {
+        error_ = describeError("Unable to allocate space for", path);
+        ::CloseHandle(file);
+        ::DeleteFileA(path.c_str());
+        return false;
+    }
+
+    void* data = ::MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    if (!data) {
+        error_ = describeError("Unable to map", path);
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        ::DeleteFileA(path.c_str());
+        return false;
+    }
+
+    // Touch every page so the first write to each doesn't fault.
+    SYSTEM_INFO system_info;
+    ::GetSystemInfo(&system_info);
+    for (std::size_t offset = 0; offset < size; offset += system_info.dwPageSize) {
+        static_cast<volatile char*>(data)[offset] = 0;
+    }
+
+    impl_->file = file;
+    impl_->mapping = mapping;
+    data_ = data;
+    size_ = size;
+    writable_ = true;
+    return true;
+}
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file) {
+        error_ = describeError("Unable to open", path);
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!::GetFileSizeEx(file, &file_size)) {
+        error_ = describeError("Unable to get the size of", path);
+        ::CloseHandle(file);
+        return false;
+    }
+
+    const auto size = static_cast<std::size_t>(file_size.QuadPart);
+    if (0 == size) {
+        error_ = path + " is empty";
+        ::CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        error_ = describeError("Unable to map", path);
+        ::CloseHandle(file);
+        return false;
+    }
+
+    void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+    if (!data) {
+        error_ = describeError("Unable to map", path);
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        return false;
+    }
+
+    impl_->file = file;
+    impl_->mapping = mapping;
+    data_ = data;
+    size_ = size;
+    writable_ = false;
+    return true;
+}
+
+void MappedFile::close(std::size_t final_size)
+{
+    if (!data_)
+        return;
+
+    ::UnmapViewOfFile(data_);
+    ::CloseHandle(impl_->mapping);
+    if (writable_ && final_size < size_) {
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(final_size);
+        if (::SetFilePointerEx(impl_->file, end, nullptr, FILE_BEGIN)) {
+            ::SetEndOfFile(impl_->file);
+        }
+    }
+    ::CloseHandle(impl_->file);
+
+    impl_->file = INVALID_HANDLE_VALUE;
+    impl_->mapping = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+    writable_ = false;
+}
+
+} // end namespace io
+} // end namespace osvr
+
+#endif // INCLUDED_MappedFile_Windows_h_GUID_953A6435_C5AE_4043_AE55_6F57424ED6E0
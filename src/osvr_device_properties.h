@@ -1,5 +1,6 @@
 /** @file
-    @brief Header
+    @brief The tracked device properties we know about: each one's type, the
+    device classes it applies to and where its value comes from.
 
     @date 2015
 
@@ -32,709 +33,291 @@
 #include <openvr_driver.h>
 
 // Standard includes
-// - none
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <string>
 
-// Whenever you upgrade OpenVR, make sure you update all the functions below if vr::ETrackedDeviceProperty has changed.
+// Whenever you upgrade OpenVR, make sure you update this list if
+// vr::ETrackedDeviceProperty has changed.
+//
+// Each entry is X(name, type, device class, update, value), where the
+// property is vr::Prop_<name> and the device class is Any, HMD, Controller or
+// TrackingReference. The value is an expression evaluated inside
+// OSVRTrackedDevice, or PropertyNotProvided. Fixed values are read once on
+// activation and kept in a TrackedPropertySnapshot; Live ones are read on
+// every request. Entries must be in enum order with no gaps, which is checked
+// at compile time.
+#define OSVR_TRACKED_DEVICE_PROPERTIES(X) \
+    /* Properties that apply to all device classes */ \
+    X(TrackingSystemName_String,              String,   Any,               Fixed, PropertyNotProvided) \
+    X(ModelNumber_String,                     String,   Any,               Fixed, std::string("OSVR HMD")) \
+    X(SerialNumber_String,                    String,   Any,               Fixed, std::string(GetId())) \
+    X(RenderModelName_String,                 String,   Any,               Fixed, PropertyNotProvided) \
+    X(WillDriftInYaw_Bool,                    Bool,     Any,               Fixed, true) \
+    X(ManufacturerName_String,                String,   Any,               Fixed, PropertyNotProvided) \
+    X(TrackingFirmwareVersion_String,         String,   Any,               Fixed, PropertyNotProvided) \
+    X(HardwareRevision_String,                String,   Any,               Fixed, PropertyNotProvided) \
+    X(AllWirelessDongleDescriptions_String,   String,   Any,               Fixed, PropertyNotProvided) \
+    X(ConnectedWirelessDongle_String,         String,   Any,               Fixed, PropertyNotProvided) \
+    X(DeviceIsWireless_Bool,                  Bool,     Any,               Fixed, false) \
+    X(DeviceIsCharging_Bool,                  Bool,     Any,               Fixed, false) \
+    X(DeviceBatteryPercentage_Float,          Float,    Any,               Fixed, 1.0f /* full battery */) \
+    X(StatusDisplayTransform_Matrix34,        Matrix34, Any,               Fixed, PropertyNotProvided) \
+    X(Firmware_UpdateAvailable_Bool,          Bool,     Any,               Fixed, false) \
+    X(Firmware_ManualUpdate_Bool,             Bool,     Any,               Fixed, false) \
+    X(Firmware_ManualUpdateURL_String,        String,   Any,               Fixed, PropertyNotProvided) \
+    X(HardwareRevision_Uint64,                Uint64,   Any,               Fixed, PropertyNotProvided) \
+    X(FirmwareVersion_Uint64,                 Uint64,   Any,               Fixed, PropertyNotProvided) \
+    X(FPGAVersion_Uint64,                     Uint64,   Any,               Fixed, PropertyNotProvided) \
+    X(VRCVersion_Uint64,                      Uint64,   Any,               Fixed, PropertyNotProvided) \
+    X(RadioVersion_Uint64,                    Uint64,   Any,               Fixed, PropertyNotProvided) \
+    X(DongleVersion_Uint64,                   Uint64,   Any,               Fixed, PropertyNotProvided) \
+    X(BlockServerShutdown_Bool,               Bool,     Any,               Fixed, false) \
+    X(CanUnifyCoordinateSystemWithHmd_Bool,   Bool,     Any,               Fixed, PropertyNotProvided /* TODO */) \
+    X(ContainsProximitySensor_Bool,           Bool,     Any,               Fixed, true) \
+    X(DeviceProvidesBatteryStatus_Bool,       Bool,     Any,               Fixed, false) \
+    X(DeviceCanPowerOff_Bool,                 Bool,     Any,               Fixed, true) \
+    X(Firmware_ProgrammingTarget_String,      String,   Any,               Fixed, PropertyNotProvided) \
+    X(DeviceClass_Int32,                      Int32,    Any,               Fixed, deviceClass_) \
+    X(HasCamera_Bool,                         Bool,     Any,               Fixed, false) \
+    X(DriverVersion_String,                   String,   Any,               Fixed, PropertyNotProvided) \
+    X(Firmware_ForceUpdateRequired_Bool,      Bool,     Any,               Fixed, PropertyNotProvided) \
+    /* Properties that are unique to TrackedDeviceClass_HMD */ \
+    X(ReportsTimeSinceVSync_Bool,             Bool,     HMD,               Fixed, PropertyNotProvided /* TODO */) \
+    X(SecondsFromVsyncToPhotons_Float,        Float,    HMD,               Fixed, PropertyNotProvided /* TODO */) \
+    X(DisplayFrequency_Float,                 Float,    HMD,               Fixed, display_.verticalRefreshRate) \
+    X(UserIpdMeters_Float,                    Float,    HMD,               Fixed, GetIPD()) \
+    X(CurrentUniverseId_Uint64,               Uint64,   HMD,               Fixed, 0) \
+    X(PreviousUniverseId_Uint64,              Uint64,   HMD,               Fixed, 0) \
+    X(DisplayFirmwareVersion_Uint64,          Uint64,   HMD,               Fixed, 192 /* @todo This really should be read from the server */) \
+    X(IsOnDesktop_Bool,                       Bool,     HMD,               Live,  IsDisplayOnDesktop()) \
+    X(DisplayMCType_Int32,                    Int32,    HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayMCOffset_Float,                  Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayMCScale_Float,                   Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(EdidVendorID_Int32,                     Int32,    HMD,               Fixed, display_.edidVendorId) \
+    X(DisplayMCImageLeft_String,              String,   HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayMCImageRight_String,             String,   HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayGCBlackClamp_Float,              Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(EdidProductID_Int32,                    Int32,    HMD,               Fixed, display_.edidProductId) \
+    X(CameraToHeadTransform_Matrix34,         Matrix34, HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayGCType_Int32,                    Int32,    HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayGCOffset_Float,                  Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayGCScale_Float,                   Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayGCPrescale_Float,                Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayGCImage_String,                  String,   HMD,               Fixed, PropertyNotProvided) \
+    X(LensCenterLeftU_Float,                  Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(LensCenterLeftV_Float,                  Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(LensCenterRightU_Float,                 Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(LensCenterRightV_Float,                 Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(UserHeadToEyeDepthMeters_Float,         Float,    HMD,               Fixed, PropertyNotProvided) \
+    X(CameraFirmwareVersion_Uint64,           Uint64,   HMD,               Fixed, PropertyNotProvided) \
+    X(CameraFirmwareDescription_String,       String,   HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayFPGAVersion_Uint64,              Uint64,   HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayBootloaderVersion_Uint64,        Uint64,   HMD,               Fixed, PropertyNotProvided) \
+    X(DisplayHardwareVersion_Uint64,          Uint64,   HMD,               Fixed, PropertyNotProvided) \
+    X(AudioFirmwareVersion_Uint64,            Uint64,   HMD,               Fixed, PropertyNotProvided) \
+    X(CameraCompatibilityMode_Int32,          Int32,    HMD,               Fixed, PropertyNotProvided) \
+    /* Properties that are unique to TrackedDeviceClass_Controller */ \
+    X(AttachedDeviceId_String,                String,   Controller,        Fixed, PropertyNotProvided) \
+    X(SupportedButtons_Uint64,                Uint64,   Controller,        Fixed, PropertyNotProvided /* TODO */) \
+    X(Axis0Type_Int32,                        Int32,    Controller,        Fixed, PropertyNotProvided) \
+    X(Axis1Type_Int32,                        Int32,    Controller,        Fixed, PropertyNotProvided) \
+    X(Axis2Type_Int32,                        Int32,    Controller,        Fixed, PropertyNotProvided) \
+    X(Axis3Type_Int32,                        Int32,    Controller,        Fixed, PropertyNotProvided) \
+    X(Axis4Type_Int32,                        Int32,    Controller,        Fixed, PropertyNotProvided) \
+    /* Properties that are unique to TrackedDeviceClass_TrackingReference */ \
+    X(FieldOfViewLeftDegrees_Float,           Float,    TrackingReference, Fixed, PropertyNotProvided /* TODO */) \
+    X(FieldOfViewRightDegrees_Float,          Float,    TrackingReference, Fixed, PropertyNotProvided /* TODO */) \
+    X(FieldOfViewTopDegrees_Float,            Float,    TrackingReference, Fixed, PropertyNotProvided /* TODO */) \
+    X(FieldOfViewBottomDegrees_Float,         Float,    TrackingReference, Fixed, PropertyNotProvided /* TODO */) \
+    X(TrackingRangeMinimumMeters_Float,       Float,    TrackingReference, Fixed, PropertyNotProvided /* TODO */) \
+    X(TrackingRangeMaximumMeters_Float,       Float,    TrackingReference, Fixed, PropertyNotProvided /* TODO */) \
+    X(ModeLabel_String,                       String,   TrackingReference, Fixed, PropertyNotProvided)
 
-inline bool isWrongDataType(vr::ETrackedDeviceProperty prop, const bool&)
-{
-    switch (prop) {
-    case vr::Prop_WillDriftInYaw_Bool:
-    case vr::Prop_DeviceIsWireless_Bool:
-    case vr::Prop_DeviceIsCharging_Bool:
-    case vr::Prop_Firmware_UpdateAvailable_Bool:
-    case vr::Prop_Firmware_ManualUpdate_Bool:
-    case vr::Prop_BlockServerShutdown_Bool:
-    case vr::Prop_CanUnifyCoordinateSystemWithHmd_Bool:
-    case vr::Prop_ContainsProximitySensor_Bool:
-    case vr::Prop_DeviceProvidesBatteryStatus_Bool:
-    case vr::Prop_DeviceCanPowerOff_Bool:
-    case vr::Prop_HasCamera_Bool:
-    case vr::Prop_ReportsTimeSinceVSync_Bool:
-    case vr::Prop_IsOnDesktop_Bool:
-    case vr::Prop_Firmware_ForceUpdateRequired_Bool:
-    // could be any type
-    case vr::Prop_VendorSpecific_Reserved_Start:
-    case vr::Prop_VendorSpecific_Reserved_End:
-        return false;
-    // Float
-    case vr::Prop_DeviceBatteryPercentage_Float:
-    case vr::Prop_SecondsFromVsyncToPhotons_Float:
-    case vr::Prop_DisplayFrequency_Float:
-    case vr::Prop_UserIpdMeters_Float:
-    case vr::Prop_DisplayMCOffset_Float:
-    case vr::Prop_DisplayMCScale_Float:
-    case vr::Prop_DisplayGCBlackClamp_Float:
-    case vr::Prop_DisplayGCOffset_Float:
-    case vr::Prop_DisplayGCScale_Float:
-    case vr::Prop_DisplayGCPrescale_Float:
-    case vr::Prop_LensCenterLeftU_Float:
-    case vr::Prop_LensCenterLeftV_Float:
-    case vr::Prop_LensCenterRightU_Float:
-    case vr::Prop_LensCenterRightV_Float:
-    case vr::Prop_UserHeadToEyeDepthMeters_Float:
-    case vr::Prop_FieldOfViewLeftDegrees_Float:
-    case vr::Prop_FieldOfViewRightDegrees_Float:
-    case vr::Prop_FieldOfViewTopDegrees_Float:
-    case vr::Prop_FieldOfViewBottomDegrees_Float:
-    case vr::Prop_TrackingRangeMinimumMeters_Float:
-    case vr::Prop_TrackingRangeMaximumMeters_Float:
-    // Int32
-    case vr::Prop_DeviceClass_Int32:
-    case vr::Prop_DisplayMCType_Int32:
-    case vr::Prop_EdidVendorID_Int32:
-    case vr::Prop_EdidProductID_Int32:
-    case vr::Prop_DisplayGCType_Int32:
-    case vr::Prop_Axis0Type_Int32:
-    case vr::Prop_Axis1Type_Int32:
-    case vr::Prop_Axis2Type_Int32:
-    case vr::Prop_Axis3Type_Int32:
-    case vr::Prop_Axis4Type_Int32:
-    case vr::Prop_CameraCompatibilityMode_Int32:
-    // Uint64
-    case vr::Prop_HardwareRevision_Uint64:
-    case vr::Prop_FirmwareVersion_Uint64:
-    case vr::Prop_FPGAVersion_Uint64:
-    case vr::Prop_VRCVersion_Uint64:
-    case vr::Prop_RadioVersion_Uint64:
-    case vr::Prop_DongleVersion_Uint64:
-    case vr::Prop_CurrentUniverseId_Uint64:
-    case vr::Prop_PreviousUniverseId_Uint64:
-    case vr::Prop_DisplayFirmwareVersion_Uint64:
-    case vr::Prop_CameraFirmwareVersion_Uint64:
-    case vr::Prop_DisplayFPGAVersion_Uint64:
-    case vr::Prop_DisplayBootloaderVersion_Uint64:
-    case vr::Prop_DisplayHardwareVersion_Uint64:
-    case vr::Prop_AudioFirmwareVersion_Uint64:
-    case vr::Prop_SupportedButtons_Uint64:
-    // String
-    case vr::Prop_TrackingSystemName_String:
-    case vr::Prop_ModelNumber_String:
-    case vr::Prop_SerialNumber_String:
-    case vr::Prop_RenderModelName_String:
-    case vr::Prop_ManufacturerName_String:
-    case vr::Prop_TrackingFirmwareVersion_String:
-    case vr::Prop_HardwareRevision_String:
-    case vr::Prop_AllWirelessDongleDescriptions_String:
-    case vr::Prop_ConnectedWirelessDongle_String:
-    case vr::Prop_Firmware_ManualUpdateURL_String:
-    case vr::Prop_Firmware_ProgrammingTarget_String:
-    case vr::Prop_DisplayMCImageLeft_String:
-    case vr::Prop_DisplayMCImageRight_String:
-    case vr::Prop_DisplayGCImage_String:
-    case vr::Prop_CameraFirmwareDescription_String:
-    case vr::Prop_AttachedDeviceId_String:
-    case vr::Prop_ModeLabel_String:
-    case vr::Prop_DriverVersion_String:
-    // Matrix34
-    case vr::Prop_StatusDisplayTransform_Matrix34:
-    case vr::Prop_CameraToHeadTransform_Matrix34:
-        return true;
-    }
+enum class TrackedPropertyUpdate {
+    Fixed,
+    Live
+};
 
-    return true;
-}
+enum class TrackedPropertyType {
+    Bool,
+    Float,
+    Int32,
+    Uint64,
+    String,
+    Matrix34
+};
 
-inline bool isWrongDataType(vr::ETrackedDeviceProperty prop, const float&)
-{
-    switch (prop) {
-    case vr::Prop_DeviceBatteryPercentage_Float:
-    case vr::Prop_SecondsFromVsyncToPhotons_Float:
-    case vr::Prop_DisplayFrequency_Float:
-    case vr::Prop_UserIpdMeters_Float:
-    case vr::Prop_DisplayMCOffset_Float:
-    case vr::Prop_DisplayMCScale_Float:
-    case vr::Prop_DisplayGCBlackClamp_Float:
-    case vr::Prop_DisplayGCOffset_Float:
-    case vr::Prop_DisplayGCScale_Float:
-    case vr::Prop_DisplayGCPrescale_Float:
-    case vr::Prop_LensCenterLeftU_Float:
-    case vr::Prop_LensCenterLeftV_Float:
-    case vr::Prop_LensCenterRightU_Float:
-    case vr::Prop_LensCenterRightV_Float:
-    case vr::Prop_UserHeadToEyeDepthMeters_Float:
-    case vr::Prop_FieldOfViewLeftDegrees_Float:
-    case vr::Prop_FieldOfViewRightDegrees_Float:
-    case vr::Prop_FieldOfViewTopDegrees_Float:
-    case vr::Prop_FieldOfViewBottomDegrees_Float:
-    case vr::Prop_TrackingRangeMinimumMeters_Float:
-    case vr::Prop_TrackingRangeMaximumMeters_Float:
-    // could be any type
-    case vr::Prop_VendorSpecific_Reserved_Start:
-    case vr::Prop_VendorSpecific_Reserved_End:
-        return false;
-    // Bool
-    case vr::Prop_WillDriftInYaw_Bool:
-    case vr::Prop_DeviceIsWireless_Bool:
-    case vr::Prop_DeviceIsCharging_Bool:
-    case vr::Prop_Firmware_UpdateAvailable_Bool:
-    case vr::Prop_Firmware_ManualUpdate_Bool:
-    case vr::Prop_BlockServerShutdown_Bool:
-    case vr::Prop_CanUnifyCoordinateSystemWithHmd_Bool:
-    case vr::Prop_ContainsProximitySensor_Bool:
-    case vr::Prop_DeviceProvidesBatteryStatus_Bool:
-    case vr::Prop_DeviceCanPowerOff_Bool:
-    case vr::Prop_HasCamera_Bool:
-    case vr::Prop_ReportsTimeSinceVSync_Bool:
-    case vr::Prop_IsOnDesktop_Bool:
-    case vr::Prop_Firmware_ForceUpdateRequired_Bool:
-    // Int32
-    case vr::Prop_DeviceClass_Int32:
-    case vr::Prop_DisplayMCType_Int32:
-    case vr::Prop_EdidVendorID_Int32:
-    case vr::Prop_EdidProductID_Int32:
-    case vr::Prop_DisplayGCType_Int32:
-    case vr::Prop_Axis0Type_Int32:
-    case vr::Prop_Axis1Type_Int32:
-    case vr::Prop_Axis2Type_Int32:
-    case vr::Prop_Axis3Type_Int32:
-    case vr::Prop_Axis4Type_Int32:
-    case vr::Prop_CameraCompatibilityMode_Int32:
-    // Uint64
-    case vr::Prop_HardwareRevision_Uint64:
-    case vr::Prop_FirmwareVersion_Uint64:
-    case vr::Prop_FPGAVersion_Uint64:
-    case vr::Prop_VRCVersion_Uint64:
-    case vr::Prop_RadioVersion_Uint64:
-    case vr::Prop_DongleVersion_Uint64:
-    case vr::Prop_CurrentUniverseId_Uint64:
-    case vr::Prop_PreviousUniverseId_Uint64:
-    case vr::Prop_DisplayFirmwareVersion_Uint64:
-    case vr::Prop_CameraFirmwareVersion_Uint64:
-    case vr::Prop_DisplayFPGAVersion_Uint64:
-    case vr::Prop_DisplayBootloaderVersion_Uint64:
-    case vr::Prop_DisplayHardwareVersion_Uint64:
-    case vr::Prop_AudioFirmwareVersion_Uint64:
-    case vr::Prop_SupportedButtons_Uint64:
-    // String
-    case vr::Prop_TrackingSystemName_String:
-    case vr::Prop_ModelNumber_String:
-    case vr::Prop_SerialNumber_String:
-    case vr::Prop_RenderModelName_String:
-    case vr::Prop_ManufacturerName_String:
-    case vr::Prop_TrackingFirmwareVersion_String:
-    case vr::Prop_HardwareRevision_String:
-    case vr::Prop_AllWirelessDongleDescriptions_String:
-    case vr::Prop_ConnectedWirelessDongle_String:
-    case vr::Prop_Firmware_ManualUpdateURL_String:
-    case vr::Prop_Firmware_ProgrammingTarget_String:
-    case vr::Prop_DisplayMCImageLeft_String:
-    case vr::Prop_DisplayMCImageRight_String:
-    case vr::Prop_DisplayGCImage_String:
-    case vr::Prop_CameraFirmwareDescription_String:
-    case vr::Prop_AttachedDeviceId_String:
-    case vr::Prop_ModeLabel_String:
-    case vr::Prop_DriverVersion_String:
-    // Matrix34
-    case vr::Prop_StatusDisplayTransform_Matrix34:
-    case vr::Prop_CameraToHeadTransform_Matrix34:
-        return true;
-    }
+/**
+ * @brief The device classes a property applies to.
+ */
+enum class TrackedPropertyClass {
+    Any,
+    HMD,
+    Controller,
+    TrackingReference
+};
 
-    return true;
-}
+/**
+ * @brief Stands in for the value of a property we don't provide.
+ */
+struct TrackedPropertyNotProvided {};
+
+constexpr TrackedPropertyNotProvided PropertyNotProvided = {};
+
+/**
+ * @brief Holds a property's value, whatever its type, unless it's a string.
+ */
+struct TrackedPropertyScalars {
+    bool asBool = false;
+    float asFloat = 0.0f;
+    int32_t asInt32 = 0;
+    uint64_t asUint64 = 0;
+    vr::HmdMatrix34_t asMatrix34 = {{{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}}};
+};
 
-inline bool isWrongDataType(vr::ETrackedDeviceProperty prop, const int32_t&)
+/**
+ * @brief Holds a property's value, whatever its type.
+ */
+struct TrackedPropertyValue : TrackedPropertyScalars {
+    std::string asString;
+};
+
+struct TrackedPropertyInfo {
+    vr::ETrackedDeviceProperty prop;
+    const char* name;
+    TrackedPropertyType type;
+    TrackedPropertyClass deviceClass;
+    TrackedPropertyUpdate update;
+};
+
+inline constexpr bool appliesTo(TrackedPropertyClass property_class, vr::ETrackedDeviceClass device_class)
 {
-    switch (prop) {
-    case vr::Prop_DeviceClass_Int32:
-    case vr::Prop_DisplayMCType_Int32:
-    case vr::Prop_EdidVendorID_Int32:
-    case vr::Prop_EdidProductID_Int32:
-    case vr::Prop_DisplayGCType_Int32:
-    case vr::Prop_Axis0Type_Int32:
-    case vr::Prop_Axis1Type_Int32:
-    case vr::Prop_Axis2Type_Int32:
-    case vr::Prop_Axis3Type_Int32:
-    case vr::Prop_Axis4Type_Int32:
-    case vr::Prop_CameraCompatibilityMode_Int32:
-    // could be any type
-    case vr::Prop_VendorSpecific_Reserved_Start:
-    case vr::Prop_VendorSpecific_Reserved_End:
-        return false;
-    // Bool
-    case vr::Prop_WillDriftInYaw_Bool:
-    case vr::Prop_DeviceIsWireless_Bool:
-    case vr::Prop_DeviceIsCharging_Bool:
-    case vr::Prop_Firmware_UpdateAvailable_Bool:
-    case vr::Prop_Firmware_ManualUpdate_Bool:
-    case vr::Prop_BlockServerShutdown_Bool:
-    case vr::Prop_CanUnifyCoordinateSystemWithHmd_Bool:
-    case vr::Prop_ContainsProximitySensor_Bool:
-    case vr::Prop_DeviceProvidesBatteryStatus_Bool:
-    case vr::Prop_DeviceCanPowerOff_Bool:
-    case vr::Prop_HasCamera_Bool:
-    case vr::Prop_ReportsTimeSinceVSync_Bool:
-    case vr::Prop_IsOnDesktop_Bool:
-    case vr::Prop_Firmware_ForceUpdateRequired_Bool:
-    // Float
-    case vr::Prop_DeviceBatteryPercentage_Float:
-    case vr::Prop_SecondsFromVsyncToPhotons_Float:
-    case vr::Prop_DisplayFrequency_Float:
-    case vr::Prop_UserIpdMeters_Float:
-    case vr::Prop_DisplayMCOffset_Float:
-    case vr::Prop_DisplayMCScale_Float:
-    case vr::Prop_DisplayGCBlackClamp_Float:
-    case vr::Prop_DisplayGCOffset_Float:
-    case vr::Prop_DisplayGCScale_Float:
-    case vr::Prop_DisplayGCPrescale_Float:
-    case vr::Prop_LensCenterLeftU_Float:
-    case vr::Prop_LensCenterLeftV_Float:
-    case vr::Prop_LensCenterRightU_Float:
-    case vr::Prop_LensCenterRightV_Float:
-    case vr::Prop_UserHeadToEyeDepthMeters_Float:
-    case vr::Prop_FieldOfViewLeftDegrees_Float:
-    case vr::Prop_FieldOfViewRightDegrees_Float:
-    case vr::Prop_FieldOfViewTopDegrees_Float:
-    case vr::Prop_FieldOfViewBottomDegrees_Float:
-    case vr::Prop_TrackingRangeMinimumMeters_Float:
-    case vr::Prop_TrackingRangeMaximumMeters_Float:
-    // Uint64
-    case vr::Prop_HardwareRevision_Uint64:
-    case vr::Prop_FirmwareVersion_Uint64:
-    case vr::Prop_FPGAVersion_Uint64:
-    case vr::Prop_VRCVersion_Uint64:
-    case vr::Prop_RadioVersion_Uint64:
-    case vr::Prop_DongleVersion_Uint64:
-    case vr::Prop_CurrentUniverseId_Uint64:
-    case vr::Prop_PreviousUniverseId_Uint64:
-    case vr::Prop_DisplayFirmwareVersion_Uint64:
-    case vr::Prop_CameraFirmwareVersion_Uint64:
-    case vr::Prop_DisplayFPGAVersion_Uint64:
-    case vr::Prop_DisplayBootloaderVersion_Uint64:
-    case vr::Prop_DisplayHardwareVersion_Uint64:
-    case vr::Prop_AudioFirmwareVersion_Uint64:
-    case vr::Prop_SupportedButtons_Uint64:
-    // String
-    case vr::Prop_TrackingSystemName_String:
-    case vr::Prop_ModelNumber_String:
-    case vr::Prop_SerialNumber_String:
-    case vr::Prop_RenderModelName_String:
-    case vr::Prop_ManufacturerName_String:
-    case vr::Prop_TrackingFirmwareVersion_String:
-    case vr::Prop_HardwareRevision_String:
-    case vr::Prop_AllWirelessDongleDescriptions_String:
-    case vr::Prop_ConnectedWirelessDongle_String:
-    case vr::Prop_Firmware_ManualUpdateURL_String:
-    case vr::Prop_Firmware_ProgrammingTarget_String:
-    case vr::Prop_DisplayMCImageLeft_String:
-    case vr::Prop_DisplayMCImageRight_String:
-    case vr::Prop_DisplayGCImage_String:
-    case vr::Prop_CameraFirmwareDescription_String:
-    case vr::Prop_AttachedDeviceId_String:
-    case vr::Prop_ModeLabel_String:
-    case vr::Prop_DriverVersion_String:
-    // Matrix34
-    case vr::Prop_StatusDisplayTransform_Matrix34:
-    case vr::Prop_CameraToHeadTransform_Matrix34:
-        return true;
+    return (TrackedPropertyClass::Any == property_class)
+        || (TrackedPropertyClass::HMD == property_class && vr::TrackedDeviceClass_HMD == device_class)
+        || (TrackedPropertyClass::Controller == property_class && vr::TrackedDeviceClass_Controller == device_class)
+        || (TrackedPropertyClass::TrackingReference == property_class && vr::TrackedDeviceClass_TrackingReference == device_class);
+}
+
+namespace detail {
+
+/**
+ * @brief The property list as an array, split into blocks of 1000 to match
+ * vr::ETrackedDeviceProperty, so a property's entry is found by indexing.
+ *
+ * It's a template only so the arrays can be defined in this header.
+ */
+template <typename Dummy = void>
+struct TrackedPropertyTable {
+    static constexpr TrackedPropertyInfo entries[] = {
+#define OSVR_PROPERTY_INFO(NAME, TYPE, DEVICE_CLASS, UPDATE, VALUE) \
+        {vr::Prop_##NAME, "Prop_" #NAME, TrackedPropertyType::TYPE, TrackedPropertyClass::DEVICE_CLASS, TrackedPropertyUpdate::UPDATE},
+        OSVR_TRACKED_DEVICE_PROPERTIES(OSVR_PROPERTY_INFO)
+#undef OSVR_PROPERTY_INFO
+    };
+
+    static constexpr std::size_t size = sizeof(entries) / sizeof(entries[0]);
+
+    /// Blocks past this aren't indexed.
+    static constexpr int32_t MaxBlock = 4;
+
+    static constexpr int32_t getBlock(std::size_t index)
+    {
+        return static_cast<int32_t>(entries[index].prop) / 1000;
     }
 
-    return true;
-}
+    /// Number of entries for properties below @p prop.
+    static constexpr std::size_t countBelow(int32_t prop, std::size_t index = 0)
+    {
+        return (index == size) ? 0 : (static_cast<int32_t>(entries[index].prop) < prop ? 1 : 0) + countBelow(prop, index + 1);
+    }
 
-inline bool isWrongDataType(vr::ETrackedDeviceProperty prop, const uint64_t&)
-{
-    switch (prop) {
-    case vr::Prop_HardwareRevision_Uint64:
-    case vr::Prop_FirmwareVersion_Uint64:
-    case vr::Prop_FPGAVersion_Uint64:
-    case vr::Prop_VRCVersion_Uint64:
-    case vr::Prop_RadioVersion_Uint64:
-    case vr::Prop_DongleVersion_Uint64:
-    case vr::Prop_CurrentUniverseId_Uint64:
-    case vr::Prop_PreviousUniverseId_Uint64:
-    case vr::Prop_DisplayFirmwareVersion_Uint64:
-    case vr::Prop_CameraFirmwareVersion_Uint64:
-    case vr::Prop_DisplayFPGAVersion_Uint64:
-    case vr::Prop_DisplayBootloaderVersion_Uint64:
-    case vr::Prop_DisplayHardwareVersion_Uint64:
-    case vr::Prop_AudioFirmwareVersion_Uint64:
-    case vr::Prop_SupportedButtons_Uint64:
-    // could be any type
-    case vr::Prop_VendorSpecific_Reserved_Start:
-    case vr::Prop_VendorSpecific_Reserved_End:
-        return false;
-    // Bool
-    case vr::Prop_WillDriftInYaw_Bool:
-    case vr::Prop_DeviceIsWireless_Bool:
-    case vr::Prop_DeviceIsCharging_Bool:
-    case vr::Prop_Firmware_UpdateAvailable_Bool:
-    case vr::Prop_Firmware_ManualUpdate_Bool:
-    case vr::Prop_BlockServerShutdown_Bool:
-    case vr::Prop_CanUnifyCoordinateSystemWithHmd_Bool:
-    case vr::Prop_ContainsProximitySensor_Bool:
-    case vr::Prop_DeviceProvidesBatteryStatus_Bool:
-    case vr::Prop_DeviceCanPowerOff_Bool:
-    case vr::Prop_HasCamera_Bool:
-    case vr::Prop_ReportsTimeSinceVSync_Bool:
-    case vr::Prop_IsOnDesktop_Bool:
-    case vr::Prop_Firmware_ForceUpdateRequired_Bool:
-    // Float
-    case vr::Prop_DeviceBatteryPercentage_Float:
-    case vr::Prop_SecondsFromVsyncToPhotons_Float:
-    case vr::Prop_DisplayFrequency_Float:
-    case vr::Prop_UserIpdMeters_Float:
-    case vr::Prop_DisplayMCOffset_Float:
-    case vr::Prop_DisplayMCScale_Float:
-    case vr::Prop_DisplayGCBlackClamp_Float:
-    case vr::Prop_DisplayGCOffset_Float:
-    case vr::Prop_DisplayGCScale_Float:
-    case vr::Prop_DisplayGCPrescale_Float:
-    case vr::Prop_LensCenterLeftU_Float:
-    case vr::Prop_LensCenterLeftV_Float:
-    case vr::Prop_LensCenterRightU_Float:
-    case vr::Prop_LensCenterRightV_Float:
-    case vr::Prop_UserHeadToEyeDepthMeters_Float:
-    case vr::Prop_FieldOfViewLeftDegrees_Float:
-    case vr::Prop_FieldOfViewRightDegrees_Float:
-    case vr::Prop_FieldOfViewTopDegrees_Float:
-    case vr::Prop_FieldOfViewBottomDegrees_Float:
-    case vr::Prop_TrackingRangeMinimumMeters_Float:
-    case vr::Prop_TrackingRangeMaximumMeters_Float:
-    // Int32
-    case vr::Prop_DeviceClass_Int32:
-    case vr::Prop_DisplayMCType_Int32:
-    case vr::Prop_EdidVendorID_Int32:
-    case vr::Prop_EdidProductID_Int32:
-    case vr::Prop_DisplayGCType_Int32:
-    case vr::Prop_Axis0Type_Int32:
-    case vr::Prop_Axis1Type_Int32:
-    case vr::Prop_Axis2Type_Int32:
-    case vr::Prop_Axis3Type_Int32:
-    case vr::Prop_Axis4Type_Int32:
-    case vr::Prop_CameraCompatibilityMode_Int32:
-    // String
-    case vr::Prop_TrackingSystemName_String:
-    case vr::Prop_ModelNumber_String:
-    case vr::Prop_SerialNumber_String:
-    case vr::Prop_RenderModelName_String:
-    case vr::Prop_ManufacturerName_String:
-    case vr::Prop_TrackingFirmwareVersion_String:
-    case vr::Prop_HardwareRevision_String:
-    case vr::Prop_AllWirelessDongleDescriptions_String:
-    case vr::Prop_ConnectedWirelessDongle_String:
-    case vr::Prop_Firmware_ManualUpdateURL_String:
-    case vr::Prop_Firmware_ProgrammingTarget_String:
-    case vr::Prop_DisplayMCImageLeft_String:
-    case vr::Prop_DisplayMCImageRight_String:
-    case vr::Prop_DisplayGCImage_String:
-    case vr::Prop_CameraFirmwareDescription_String:
-    case vr::Prop_AttachedDeviceId_String:
-    case vr::Prop_ModeLabel_String:
-    case vr::Prop_DriverVersion_String:
-    // Matrix34
-    case vr::Prop_StatusDisplayTransform_Matrix34:
-    case vr::Prop_CameraToHeadTransform_Matrix34:
-        return true;
+    /// True if every entry from @p index on follows the one before it, or
+    /// starts a later block.
+    static constexpr bool isInOrder(std::size_t index = 0)
+    {
+        return (index >= size) || ((0 == index ? entries[index].prop % 1000 == 0
+                                               : (entries[index].prop == entries[index - 1].prop + 1
+                                                  || (entries[index].prop % 1000 == 0 && getBlock(index) > getBlock(index - 1))))
+                                   && isInOrder(index + 1));
     }
 
-    return true;
-}
+    static constexpr std::size_t blockStarts[] = {countBelow(0),    countBelow(1000), countBelow(2000),
+                                                  countBelow(3000), countBelow(4000), countBelow(5000)};
+};
 
-inline bool isWrongDataType(vr::ETrackedDeviceProperty prop, const char*)
+template <typename Dummy>
+constexpr TrackedPropertyInfo TrackedPropertyTable<Dummy>::entries[];
+
+template <typename Dummy>
+constexpr std::size_t TrackedPropertyTable<Dummy>::blockStarts[];
+
+static_assert(TrackedPropertyTable<>::isInOrder(), "OSVR_TRACKED_DEVICE_PROPERTIES must be in enum order with no gaps.");
+static_assert(TrackedPropertyTable<>::getBlock(TrackedPropertyTable<>::size - 1) <= TrackedPropertyTable<>::MaxBlock, "Raise MaxBlock to cover every property.");
+
+} // end namespace detail
+
+/**
+ * Returns what we know about @p prop, or nullptr if it isn't in the list.
+ */
+inline const TrackedPropertyInfo* getTrackedPropertyInfo(vr::ETrackedDeviceProperty prop)
 {
-    switch (prop) {
-    case vr::Prop_TrackingSystemName_String:
-    case vr::Prop_ModelNumber_String:
-    case vr::Prop_SerialNumber_String:
-    case vr::Prop_RenderModelName_String:
-    case vr::Prop_ManufacturerName_String:
-    case vr::Prop_TrackingFirmwareVersion_String:
-    case vr::Prop_HardwareRevision_String:
-    case vr::Prop_AllWirelessDongleDescriptions_String:
-    case vr::Prop_ConnectedWirelessDongle_String:
-    case vr::Prop_Firmware_ManualUpdateURL_String:
-    case vr::Prop_Firmware_ProgrammingTarget_String:
-    case vr::Prop_DisplayMCImageLeft_String:
-    case vr::Prop_DisplayMCImageRight_String:
-    case vr::Prop_DisplayGCImage_String:
-    case vr::Prop_CameraFirmwareDescription_String:
-    case vr::Prop_AttachedDeviceId_String:
-    case vr::Prop_ModeLabel_String:
-    case vr::Prop_DriverVersion_String:
-    // could be any type
-    case vr::Prop_VendorSpecific_Reserved_Start:
-    case vr::Prop_VendorSpecific_Reserved_End:
-        return false;
-    // Bool
-    case vr::Prop_WillDriftInYaw_Bool:
-    case vr::Prop_DeviceIsWireless_Bool:
-    case vr::Prop_DeviceIsCharging_Bool:
-    case vr::Prop_Firmware_UpdateAvailable_Bool:
-    case vr::Prop_Firmware_ManualUpdate_Bool:
-    case vr::Prop_BlockServerShutdown_Bool:
-    case vr::Prop_CanUnifyCoordinateSystemWithHmd_Bool:
-    case vr::Prop_ContainsProximitySensor_Bool:
-    case vr::Prop_DeviceProvidesBatteryStatus_Bool:
-    case vr::Prop_DeviceCanPowerOff_Bool:
-    case vr::Prop_HasCamera_Bool:
-    case vr::Prop_ReportsTimeSinceVSync_Bool:
-    case vr::Prop_IsOnDesktop_Bool:
-    case vr::Prop_Firmware_ForceUpdateRequired_Bool:
-    // Float
-    case vr::Prop_DeviceBatteryPercentage_Float:
-    case vr::Prop_SecondsFromVsyncToPhotons_Float:
-    case vr::Prop_DisplayFrequency_Float:
-    case vr::Prop_UserIpdMeters_Float:
-    case vr::Prop_DisplayMCOffset_Float:
-    case vr::Prop_DisplayMCScale_Float:
-    case vr::Prop_DisplayGCBlackClamp_Float:
-    case vr::Prop_DisplayGCOffset_Float:
-    case vr::Prop_DisplayGCScale_Float:
-    case vr::Prop_DisplayGCPrescale_Float:
-    case vr::Prop_LensCenterLeftU_Float:
-    case vr::Prop_LensCenterLeftV_Float:
-    case vr::Prop_LensCenterRightU_Float:
-    case vr::Prop_LensCenterRightV_Float:
-    case vr::Prop_UserHeadToEyeDepthMeters_Float:
-    case vr::Prop_FieldOfViewLeftDegrees_Float:
-    case vr::Prop_FieldOfViewRightDegrees_Float:
-    case vr::Prop_FieldOfViewTopDegrees_Float:
-    case vr::Prop_FieldOfViewBottomDegrees_Float:
-    case vr::Prop_TrackingRangeMinimumMeters_Float:
-    case vr::Prop_TrackingRangeMaximumMeters_Float:
-    // Int32
-    case vr::Prop_DeviceClass_Int32:
-    case vr::Prop_DisplayMCType_Int32:
-    case vr::Prop_EdidVendorID_Int32:
-    case vr::Prop_EdidProductID_Int32:
-    case vr::Prop_DisplayGCType_Int32:
-    case vr::Prop_Axis0Type_Int32:
-    case vr::Prop_Axis1Type_Int32:
-    case vr::Prop_Axis2Type_Int32:
-    case vr::Prop_Axis3Type_Int32:
-    case vr::Prop_Axis4Type_Int32:
-    case vr::Prop_CameraCompatibilityMode_Int32:
-    // Uint64
-    case vr::Prop_HardwareRevision_Uint64:
-    case vr::Prop_FirmwareVersion_Uint64:
-    case vr::Prop_FPGAVersion_Uint64:
-    case vr::Prop_VRCVersion_Uint64:
-    case vr::Prop_RadioVersion_Uint64:
-    case vr::Prop_DongleVersion_Uint64:
-    case vr::Prop_CurrentUniverseId_Uint64:
-    case vr::Prop_PreviousUniverseId_Uint64:
-    case vr::Prop_DisplayFirmwareVersion_Uint64:
-    case vr::Prop_CameraFirmwareVersion_Uint64:
-    case vr::Prop_DisplayFPGAVersion_Uint64:
-    case vr::Prop_DisplayBootloaderVersion_Uint64:
-    case vr::Prop_DisplayHardwareVersion_Uint64:
-    case vr::Prop_AudioFirmwareVersion_Uint64:
-    case vr::Prop_SupportedButtons_Uint64:
-    // Matrix34
-    case vr::Prop_StatusDisplayTransform_Matrix34:
-    case vr::Prop_CameraToHeadTransform_Matrix34:
-        return true;
-    }
+    using Table = detail::TrackedPropertyTable<>;
+    const auto block = static_cast<int32_t>(prop) / 1000;
+    if (prop < 0 || block > Table::MaxBlock)
+        return nullptr;
 
-    return true;
+    const auto index = Table::blockStarts[block] + static_cast<std::size_t>(prop % 1000);
+    if (index >= Table::blockStarts[block + 1])
+        return nullptr;
+
+    return &Table::entries[index];
 }
 
-inline bool isWrongDataType(vr::ETrackedDeviceProperty prop, vr::HmdMatrix34_t)
+/**
+ * Returns the number of properties in the list.
+ */
+inline constexpr std::size_t getTrackedPropertyCount()
 {
-    switch (prop)
-    {
-    case vr::Prop_StatusDisplayTransform_Matrix34:
-    case vr::Prop_CameraToHeadTransform_Matrix34:
-    // could be any type
-    case vr::Prop_VendorSpecific_Reserved_Start:
-    case vr::Prop_VendorSpecific_Reserved_End:
-        return false;
-    // Bool
-    case vr::Prop_WillDriftInYaw_Bool:
-    case vr::Prop_DeviceIsWireless_Bool:
-    case vr::Prop_DeviceIsCharging_Bool:
-    case vr::Prop_Firmware_UpdateAvailable_Bool:
-    case vr::Prop_Firmware_ManualUpdate_Bool:
-    case vr::Prop_BlockServerShutdown_Bool:
-    case vr::Prop_CanUnifyCoordinateSystemWithHmd_Bool:
-    case vr::Prop_ContainsProximitySensor_Bool:
-    case vr::Prop_DeviceProvidesBatteryStatus_Bool:
-    case vr::Prop_DeviceCanPowerOff_Bool:
-    case vr::Prop_HasCamera_Bool:
-    case vr::Prop_ReportsTimeSinceVSync_Bool:
-    case vr::Prop_IsOnDesktop_Bool:
-    case vr::Prop_Firmware_ForceUpdateRequired_Bool:
-    // Float
-    case vr::Prop_DeviceBatteryPercentage_Float:
-    case vr::Prop_SecondsFromVsyncToPhotons_Float:
-    case vr::Prop_DisplayFrequency_Float:
-    case vr::Prop_UserIpdMeters_Float:
-    case vr::Prop_DisplayMCOffset_Float:
-    case vr::Prop_DisplayMCScale_Float:
-    case vr::Prop_DisplayGCBlackClamp_Float:
-    case vr::Prop_DisplayGCOffset_Float:
-    case vr::Prop_DisplayGCScale_Float:
-    case vr::Prop_DisplayGCPrescale_Float:
-    case vr::Prop_LensCenterLeftU_Float:
-    case vr::Prop_LensCenterLeftV_Float:
-    case vr::Prop_LensCenterRightU_Float:
-    case vr::Prop_LensCenterRightV_Float:
-    case vr::Prop_UserHeadToEyeDepthMeters_Float:
-    case vr::Prop_FieldOfViewLeftDegrees_Float:
-    case vr::Prop_FieldOfViewRightDegrees_Float:
-    case vr::Prop_FieldOfViewTopDegrees_Float:
-    case vr::Prop_FieldOfViewBottomDegrees_Float:
-    case vr::Prop_TrackingRangeMinimumMeters_Float:
-    case vr::Prop_TrackingRangeMaximumMeters_Float:
-    // Int32
-    case vr::Prop_DeviceClass_Int32:
-    case vr::Prop_DisplayMCType_Int32:
-    case vr::Prop_EdidVendorID_Int32:
-    case vr::Prop_EdidProductID_Int32:
-    case vr::Prop_DisplayGCType_Int32:
-    case vr::Prop_Axis0Type_Int32:
-    case vr::Prop_Axis1Type_Int32:
-    case vr::Prop_Axis2Type_Int32:
-    case vr::Prop_Axis3Type_Int32:
-    case vr::Prop_Axis4Type_Int32:
-    case vr::Prop_CameraCompatibilityMode_Int32:
-    // Uint64
-    case vr::Prop_HardwareRevision_Uint64:
-    case vr::Prop_FirmwareVersion_Uint64:
-    case vr::Prop_FPGAVersion_Uint64:
-    case vr::Prop_VRCVersion_Uint64:
-    case vr::Prop_RadioVersion_Uint64:
-    case vr::Prop_DongleVersion_Uint64:
-    case vr::Prop_CurrentUniverseId_Uint64:
-    case vr::Prop_PreviousUniverseId_Uint64:
-    case vr::Prop_DisplayFirmwareVersion_Uint64:
-    case vr::Prop_CameraFirmwareVersion_Uint64:
-    case vr::Prop_DisplayFPGAVersion_Uint64:
-    case vr::Prop_DisplayBootloaderVersion_Uint64:
-    case vr::Prop_DisplayHardwareVersion_Uint64:
-    case vr::Prop_AudioFirmwareVersion_Uint64:
-    case vr::Prop_SupportedButtons_Uint64:
-    // String
-    case vr::Prop_TrackingSystemName_String:
-    case vr::Prop_ModelNumber_String:
-    case vr::Prop_SerialNumber_String:
-    case vr::Prop_RenderModelName_String:
-    case vr::Prop_ManufacturerName_String:
-    case vr::Prop_TrackingFirmwareVersion_String:
-    case vr::Prop_HardwareRevision_String:
-    case vr::Prop_AllWirelessDongleDescriptions_String:
-    case vr::Prop_ConnectedWirelessDongle_String:
-    case vr::Prop_Firmware_ManualUpdateURL_String:
-    case vr::Prop_Firmware_ProgrammingTarget_String:
-    case vr::Prop_DisplayMCImageLeft_String:
-    case vr::Prop_DisplayMCImageRight_String:
-    case vr::Prop_DisplayGCImage_String:
-    case vr::Prop_CameraFirmwareDescription_String:
-    case vr::Prop_AttachedDeviceId_String:
-    case vr::Prop_ModeLabel_String:
-    case vr::Prop_DriverVersion_String:
-        return true;
-    }
-
-    return true;
+    return detail::TrackedPropertyTable<>::size;
 }
 
-inline bool isWrongDeviceClass(vr::ETrackedDeviceProperty prop, vr::ETrackedDeviceClass device_class)
+/**
+ * Returns the property at @p index in the list.
+ */
+inline const TrackedPropertyInfo& getTrackedPropertyInfoAt(std::size_t index)
 {
-    switch (prop) {
-    // General properties that apply to all device classes
-    case vr::Prop_TrackingSystemName_String:
-    case vr::Prop_ModelNumber_String:
-    case vr::Prop_SerialNumber_String:
-    case vr::Prop_RenderModelName_String:
-    case vr::Prop_WillDriftInYaw_Bool:
-    case vr::Prop_ManufacturerName_String:
-    case vr::Prop_TrackingFirmwareVersion_String:
-    case vr::Prop_HardwareRevision_String:
-    case vr::Prop_AllWirelessDongleDescriptions_String:
-    case vr::Prop_ConnectedWirelessDongle_String:
-    case vr::Prop_DeviceIsWireless_Bool:
-    case vr::Prop_DeviceIsCharging_Bool:
-    case vr::Prop_DeviceBatteryPercentage_Float:
-    case vr::Prop_StatusDisplayTransform_Matrix34:
-    case vr::Prop_Firmware_UpdateAvailable_Bool:
-    case vr::Prop_Firmware_ManualUpdate_Bool:
-    case vr::Prop_Firmware_ManualUpdateURL_String:
-    case vr::Prop_HardwareRevision_Uint64:
-    case vr::Prop_FirmwareVersion_Uint64:
-    case vr::Prop_FPGAVersion_Uint64:
-    case vr::Prop_VRCVersion_Uint64:
-    case vr::Prop_RadioVersion_Uint64:
-    case vr::Prop_DongleVersion_Uint64:
-    case vr::Prop_BlockServerShutdown_Bool:
-    case vr::Prop_CanUnifyCoordinateSystemWithHmd_Bool:
-    case vr::Prop_ContainsProximitySensor_Bool:
-    case vr::Prop_DeviceProvidesBatteryStatus_Bool:
-    case vr::Prop_DeviceCanPowerOff_Bool:
-    case vr::Prop_Firmware_ProgrammingTarget_String:
-    case vr::Prop_DeviceClass_Int32:
-    case vr::Prop_HasCamera_Bool:
-    case vr::Prop_Firmware_ForceUpdateRequired_Bool:
-    case vr::Prop_DriverVersion_String:
-        return false;
-
-    // Properties that are unique to TrackedDeviceClass_HMD
-    case vr::Prop_ReportsTimeSinceVSync_Bool:
-    case vr::Prop_SecondsFromVsyncToPhotons_Float:
-    case vr::Prop_DisplayFrequency_Float:
-    case vr::Prop_UserIpdMeters_Float:
-    case vr::Prop_CurrentUniverseId_Uint64:
-    case vr::Prop_PreviousUniverseId_Uint64:
-    case vr::Prop_DisplayFirmwareVersion_Uint64:
-    case vr::Prop_IsOnDesktop_Bool:
-    case vr::Prop_DisplayMCType_Int32:
-    case vr::Prop_DisplayMCOffset_Float:
-    case vr::Prop_DisplayMCScale_Float:
-    case vr::Prop_EdidVendorID_Int32:
-    case vr::Prop_DisplayMCImageLeft_String:
-    case vr::Prop_DisplayMCImageRight_String:
-    case vr::Prop_DisplayGCBlackClamp_Float:
-    case vr::Prop_EdidProductID_Int32:
-    case vr::Prop_CameraToHeadTransform_Matrix34:
-    case vr::Prop_DisplayGCType_Int32:
-    case vr::Prop_DisplayGCOffset_Float:
-    case vr::Prop_DisplayGCScale_Float:
-    case vr::Prop_DisplayGCPrescale_Float:
-    case vr::Prop_DisplayGCImage_String:
-    case vr::Prop_LensCenterLeftU_Float:
-    case vr::Prop_LensCenterLeftV_Float:
-    case vr::Prop_LensCenterRightU_Float:
-    case vr::Prop_LensCenterRightV_Float:
-    case vr::Prop_UserHeadToEyeDepthMeters_Float:
-    case vr::Prop_CameraFirmwareVersion_Uint64:
-    case vr::Prop_CameraFirmwareDescription_String:
-    case vr::Prop_DisplayFPGAVersion_Uint64:
-    case vr::Prop_DisplayBootloaderVersion_Uint64:
-    case vr::Prop_DisplayHardwareVersion_Uint64:
-    case vr::Prop_AudioFirmwareVersion_Uint64:
-    case vr::Prop_CameraCompatibilityMode_Int32:
-        return (vr::TrackedDeviceClass_HMD != device_class);
-
-    // Properties that are unique to TrackedDeviceClass_Controller
-    case vr::Prop_AttachedDeviceId_String:
-    case vr::Prop_SupportedButtons_Uint64:
-    case vr::Prop_Axis0Type_Int32:
-    case vr::Prop_Axis1Type_Int32:
-    case vr::Prop_Axis2Type_Int32:
-    case vr::Prop_Axis3Type_Int32:
-    case vr::Prop_Axis4Type_Int32:
-        return (vr::TrackedDeviceClass_Controller != device_class);
-
-    // Properties that are unique to TrackedDeviceClass_TrackingReference
-    case vr::Prop_FieldOfViewLeftDegrees_Float:
-    case vr::Prop_FieldOfViewRightDegrees_Float:
-    case vr::Prop_FieldOfViewTopDegrees_Float:
-    case vr::Prop_FieldOfViewBottomDegrees_Float:
-    case vr::Prop_TrackingRangeMinimumMeters_Float:
-    case vr::Prop_TrackingRangeMaximumMeters_Float:
-    case vr::Prop_ModeLabel_String:
-        return (vr::TrackedDeviceClass_TrackingReference != device_class);
-
-    // Vendors are free to expose private debug data in this reserved region
-    case vr::Prop_VendorSpecific_Reserved_Start:
-    case vr::Prop_VendorSpecific_Reserved_End:
-        return true;
-    }
+    return detail::TrackedPropertyTable<>::entries[index];
+}
 
-    return true;
+/**
+ * Returns the position of @p info in the list, for indexing per-property
+ * arrays.
+ */
+inline std::size_t getTrackedPropertyIndex(const TrackedPropertyInfo& info)
+{
+    return static_cast<std::size_t>(&info - detail::TrackedPropertyTable<>::entries);
 }
 
+/**
+ * @brief The values of a device's Fixed properties, read once so requests for
+ * them are answered without recomputing anything or allocating.
+ *
+ * Entries are in list order; those for Live properties are unused. Strings
+ * are kept back to back, each with its terminating null, ready to be copied
+ * out.
+ */
+struct TrackedPropertySnapshot {
+    struct Entry {
+        vr::ETrackedPropertyError error = vr::TrackedProp_UnknownProperty;
+        TrackedPropertyScalars value;
+        uint32_t stringOffset = 0;
+        uint32_t stringSize = 0;        ///< including the terminating null
+    };
+
+    Entry entries[getTrackedPropertyCount()];
+    std::string strings;
+};
+
 #endif // INCLUDED_osvr_device_properties_h_GUID_5212DE9D_B211_4139_A140_45A578EFA47E
 
@@ -27,14 +27,14 @@
 #define INCLUDED_pretty_print_h_GUID_5CF0EE2E_1739_4CA8_BA5A_F72B8BEB3591
 
 // Internal Includes
-// - none
+#include "osvr_device_properties.h"
 
 // Library/third-party includes
 #include <openvr_driver.h>
 
 // Standard includes
 #include <ostream>
-#include <sstream>
+#include <string>
 
 using std::to_string;
 
@@ -48,180 +48,16 @@ inline std::string to_string(const std::string& str)
 
 inline std::string to_string(const vr::ETrackedDeviceProperty& value)
 {
+    if (const auto info = getTrackedPropertyInfo(value))
+        return info->name;
+
     switch (value) {
-        case vr::Prop_TrackingSystemName_String:
-            return "Prop_TrackingSystemName_String";
-        case vr::Prop_ModelNumber_String:
-            return "Prop_ModelNumber_String";
-        case vr::Prop_SerialNumber_String:
-            return "Prop_SerialNumber_String";
-        case vr::Prop_RenderModelName_String:
-            return "Prop_RenderModelName_String";
-        case vr::Prop_WillDriftInYaw_Bool:
-            return "Prop_WillDriftInYaw_Bool";
-        case vr::Prop_ManufacturerName_String:
-            return "Prop_ManufacturerName_String";
-        case vr::Prop_TrackingFirmwareVersion_String:
-            return "Prop_TrackingFirmwareVersion_String";
-        case vr::Prop_HardwareRevision_String:
-            return "Prop_HardwareRevision_String";
-        case vr::Prop_AllWirelessDongleDescriptions_String:
-            return "Prop_AllWirelessDongleDescriptions_String";
-        case vr::Prop_ConnectedWirelessDongle_String:
-            return "Prop_ConnectedWirelessDongle_String";
-        case vr::Prop_DeviceIsWireless_Bool:
-            return "Prop_DeviceIsWireless_Bool";
-        case vr::Prop_DeviceIsCharging_Bool:
-            return "Prop_DeviceIsCharging_Bool";
-        case vr::Prop_DeviceBatteryPercentage_Float:
-            return "Prop_DeviceBatteryPercentage_Float";
-        case vr::Prop_StatusDisplayTransform_Matrix34:
-            return "Prop_StatusDisplayTransform_Matrix34";
-        case vr::Prop_Firmware_UpdateAvailable_Bool:
-            return "Prop_Firmware_UpdateAvailable_Bool";
-        case vr::Prop_Firmware_ManualUpdate_Bool:
-            return "Prop_Firmware_ManualUpdate_Bool";
-        case vr::Prop_Firmware_ManualUpdateURL_String:
-            return "Prop_Firmware_ManualUpdateURL_String";
-        case vr::Prop_HardwareRevision_Uint64:
-            return "Prop_HardwareRevision_Uint64";
-        case vr::Prop_FirmwareVersion_Uint64:
-            return "Prop_FirmwareVersion_Uint64";
-        case vr::Prop_FPGAVersion_Uint64:
-            return "Prop_FPGAVersion_Uint64";
-        case vr::Prop_VRCVersion_Uint64:
-            return "Prop_VRCVersion_Uint64";
-        case vr::Prop_RadioVersion_Uint64:
-            return "Prop_RadioVersion_Uint64";
-        case vr::Prop_DongleVersion_Uint64:
-            return "Prop_DongleVersion_Uint64";
-        case vr::Prop_BlockServerShutdown_Bool:
-            return "Prop_BlockServerShutdown_Bool";
-        case vr::Prop_CanUnifyCoordinateSystemWithHmd_Bool:
-            return "Prop_CanUnifyCoordinateSystemWithHmd_Bool";
-        case vr::Prop_ContainsProximitySensor_Bool:
-            return "Prop_ContainsProximitySensor_Bool";
-        case vr::Prop_DeviceProvidesBatteryStatus_Bool:
-            return "Prop_DeviceProvidesBatteryStatus_Bool";
-        case vr::Prop_DeviceCanPowerOff_Bool:
-            return "Prop_DeviceCanPowerOff_Bool";
-        case vr::Prop_Firmware_ProgrammingTarget_String:
-            return "Prop_Firmware_ProgrammingTarget_String";
-        case vr::Prop_DeviceClass_Int32:
-            return "Prop_DeviceClass_Int32";
-        case vr::Prop_HasCamera_Bool:
-            return "Prop_HasCamera_Bool";
-        case vr::Prop_DriverVersion_String:
-            return "Prop_DriverVersion_String";
-        case vr::Prop_Firmware_ForceUpdateRequired_Bool:
-            return "Prop_Firmware_ForceUpdateRequired_Bool";
-        case vr::Prop_ReportsTimeSinceVSync_Bool:
-            return "Prop_ReportsTimeSinceVSync_Bool";
-        case vr::Prop_SecondsFromVsyncToPhotons_Float:
-            return "Prop_SecondsFromVsyncToPhotons_Float";
-        case vr::Prop_DisplayFrequency_Float:
-            return "Prop_DisplayFrequency_Float";
-        case vr::Prop_UserIpdMeters_Float:
-            return "Prop_UserIpdMeters_Float";
-        case vr::Prop_CurrentUniverseId_Uint64:
-            return "Prop_CurrentUniverseId_Uint64";
-        case vr::Prop_PreviousUniverseId_Uint64:
-            return "Prop_PreviousUniverseId_Uint64";
-        case vr::Prop_DisplayFirmwareVersion_Uint64:
-            return "Prop_DisplayFirmwareVersion_Uint64";
-        case vr::Prop_IsOnDesktop_Bool:
-            return "Prop_IsOnDesktop_Bool";
-        case vr::Prop_DisplayMCType_Int32:
-            return "Prop_DisplayMCType_Int32";
-        case vr::Prop_DisplayMCOffset_Float:
-            return "Prop_DisplayMCOffset_Float";
-        case vr::Prop_DisplayMCScale_Float:
-            return "Prop_DisplayMCScale_Float";
-        case vr::Prop_EdidVendorID_Int32:
-            return "Prop_EdidVendorID_Int32";
-        case vr::Prop_DisplayMCImageLeft_String:
-            return "Prop_DisplayMCImageLeft_String";
-        case vr::Prop_DisplayMCImageRight_String:
-            return "Prop_DisplayMCImageRight_String";
-        case vr::Prop_DisplayGCBlackClamp_Float:
-            return "Prop_DisplayGCBlackClamp_Float";
-        case vr::Prop_EdidProductID_Int32:
-            return "Prop_EdidProductID_Int32";
-        case vr::Prop_CameraToHeadTransform_Matrix34:
-            return "Prop_CameraToHeadTransform_Matrix34";
-        case vr::Prop_DisplayGCType_Int32:
-            return "Prop_DisplayGCType_Int32";
-        case vr::Prop_DisplayGCOffset_Float:
-            return "Prop_DisplayGCOffset_Float";
-        case vr::Prop_DisplayGCScale_Float:
-            return "Prop_DisplayGCScale_Float";
-        case vr::Prop_DisplayGCPrescale_Float:
-            return "Prop_DisplayGCPrescale_Float";
-        case vr::Prop_DisplayGCImage_String:
-            return "Prop_DisplayGCImage_String";
-        case vr::Prop_LensCenterLeftU_Float:
-            return "Prop_LensCenterLeftU_Float";
-        case vr::Prop_LensCenterLeftV_Float:
-            return "Prop_LensCenterLeftV_Float";
-        case vr::Prop_LensCenterRightU_Float:
-            return "Prop_LensCenterRightU_Float";
-        case vr::Prop_LensCenterRightV_Float:
-            return "Prop_LensCenterRightV_Float";
-        case vr::Prop_UserHeadToEyeDepthMeters_Float:
-            return "Prop_UserHeadToEyeDepthMeters_Float";
-        case vr::Prop_CameraFirmwareVersion_Uint64:
-            return "Prop_CameraFirmwareVersion_Uint64";
-        case vr::Prop_CameraFirmwareDescription_String:
-            return "Prop_CameraFirmwareDescription_String";
-        case vr::Prop_DisplayFPGAVersion_Uint64:
-            return "Prop_DisplayFPGAVersion_Uint64";
-        case vr::Prop_DisplayBootloaderVersion_Uint64:
-            return "Prop_DisplayBootloaderVersion_Uint64";
-        case vr::Prop_DisplayHardwareVersion_Uint64:
-            return "Prop_DisplayHardwareVersion_Uint64";
-        case vr::Prop_AudioFirmwareVersion_Uint64:
-            return "Prop_AudioFirmwareVersion_Uint64";
-        case vr::Prop_CameraCompatibilityMode_Int32:
-            return "Prop_CameraCompatibilityMode_Int32";
-        case vr::Prop_AttachedDeviceId_String:
-            return "Prop_AttachedDeviceId_String";
-        case vr::Prop_SupportedButtons_Uint64:
-            return "Prop_SupportedButtons_Uint64";
-        case vr::Prop_Axis0Type_Int32:
-            return "Prop_Axis0Type_Int32";
-        case vr::Prop_Axis1Type_Int32:
-            return "Prop_Axis1Type_Int32";
-        case vr::Prop_Axis2Type_Int32:
-            return "Prop_Axis2Type_Int32";
-        case vr::Prop_Axis3Type_Int32:
-            return "Prop_Axis3Type_Int32";
-        case vr::Prop_Axis4Type_Int32:
-            return "Prop_Axis4Type_Int32";
-        case vr::Prop_FieldOfViewLeftDegrees_Float:
-            return "Prop_FieldOfViewLeftDegrees_Float";
-        case vr::Prop_FieldOfViewRightDegrees_Float:
-            return "Prop_FieldOfViewRightDegrees_Float";
-        case vr::Prop_FieldOfViewTopDegrees_Float:
-            return "Prop_FieldOfViewTopDegrees_Float";
-        case vr::Prop_FieldOfViewBottomDegrees_Float:
-            return "Prop_FieldOfViewBottomDegrees_Float";
-        case vr::Prop_TrackingRangeMinimumMeters_Float:
-            return "Prop_TrackingRangeMinimumMeters_Float";
-        case vr::Prop_TrackingRangeMaximumMeters_Float:
-            return "Prop_TrackingRangeMaximumMeters_Float";
-        case vr::Prop_ModeLabel_String:
-            return "Prop_ModeLabel_String";
         case vr::Prop_VendorSpecific_Reserved_Start:
             return "Prop_VendorSpecific_Reserved_Start";
         case vr::Prop_VendorSpecific_Reserved_End:
             return "Prop_VendorSpecific_Reserved_End";
         default:
-            {
-                std::ostringstream oss;
-                oss << value;
-                std::string val = oss.str();
-                return val;
-            }
+            return std::to_string(static_cast<int>(value));
     }
 }
 
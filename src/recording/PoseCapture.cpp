@@ -0,0 +1,127 @@
+/** @file
+    @brief Reads a capture file written by PoseRecorder.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseCapture.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::min
+#include <atomic>           // for std::atomic_thread_fence
+#include <cstring>          // for std::memcmp
+
+namespace osvr {
+namespace recording {
+
+bool PoseCapture::open(const std::string& path)
+{
+    close();
+
+    if (!file_.open(path)) {
+        error_ = file_.getError();
+        return false;
+    }
+
+    const auto fail = [&](const std::string& reason) {
+        error_ = path + ": " + reason;
+        file_.close();
+        return false;
+    };
+
+    if (file_.size() < sizeof(CaptureHeader))
+        return fail("too small to be a pose capture");
+
+    const auto* header = static_cast<const CaptureHeader*>(file_.data());
+    if (std::memcmp(header->magic, CaptureMagic, sizeof(CaptureMagic)) != 0)
+        return fail("not a pose capture");
+    if (header->version != CaptureVersion)
+        return fail("unsupported capture version " + std::to_string(header->version));
+    if (header->headerSize != sizeof(CaptureHeader) || header->recordSize != sizeof(PoseRecord))
+        return fail("unexpected record layout");
+
+    // A capture still being written (or cut short) may have a count that
+    // runs past the end of what's in the file; only use complete records.
+    const uint64_t count = header->count;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const auto stored = (file_.size() - sizeof(CaptureHeader)) / sizeof(PoseRecord);
+
+    header_ = header;
+    records_ = reinterpret_cast<const PoseRecord*>(static_cast<const char*>(file_.data()) + sizeof(CaptureHeader));
+    size_ = static_cast<std::size_t>(std::min<uint64_t>(count, stored));
+    error_.clear();
+    return true;
+}
+
+void PoseCapture::close()
+{
+    file_.close();
+    header_ = nullptr;
+    records_ = nullptr;
+    size_ = 0;
+}
+
+bool PoseCapture::isOpen() const
+{
+    return nullptr != header_;
+}
+
+const CaptureHeader& PoseCapture::getHeader() const
+{
+    return *header_;
+}
+
+std::size_t PoseCapture::size() const
+{
+    return size_;
+}
+
+bool PoseCapture::empty() const
+{
+    return 0 == size_;
+}
+
+const PoseRecord& PoseCapture::operator[](std::size_t index) const
+{
+    return records_[index];
+}
+
+const PoseRecord* PoseCapture::begin() const
+{
+    return records_;
+}
+
+const PoseRecord* PoseCapture::end() const
+{
+    return records_ + size_;
+}
+
+const std::string& PoseCapture::getError() const
+{
+    return error_;
+}
+
+} // end namespace recording
+} // end namespace osvr
@@ -0,0 +1,87 @@
+/** @file
+    @brief Reads a capture file written by PoseRecorder.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseCapture_h_GUID_A52AC9B3_34D5_4EEA_9D34_8AA8223DAF02
+#define INCLUDED_PoseCapture_h_GUID_A52AC9B3_34D5_4EEA_9D34_8AA8223DAF02
+
+// Internal Includes
+#include "PoseRecord.h"
+#include "io/MappedFile.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <string>
+
+namespace osvr {
+namespace recording {
+
+/**
+ * @brief A read-only view of a capture file.
+ *
+ * The file is mapped rather than read, so opening even a long capture is
+ * cheap and records are paged in as they're used.
+ */
+class PoseCapture {
+public:
+    /**
+     * Opens and checks the capture at @p path.
+     *
+     * @return false if the file can't be read or isn't a capture this
+     * version understands; see getError().
+     */
+    bool open(const std::string& path);
+
+    void close();
+
+    bool isOpen() const;
+
+    const CaptureHeader& getHeader() const;
+
+    /**
+     * Returns the number of complete records in the capture.
+     */
+    std::size_t size() const;
+    bool empty() const;
+
+    const PoseRecord& operator[](std::size_t index) const;
+    const PoseRecord* begin() const;
+    const PoseRecord* end() const;
+
+    const std::string& getError() const;
+
+private:
+    io::MappedFile file_;
+    const CaptureHeader* header_ = nullptr;
+    const PoseRecord* records_ = nullptr;
+    std::size_t size_ = 0;
+    std::string error_;
+};
+
+} // end namespace recording
+} // end namespace osvr
+
+#endif // INCLUDED_PoseCapture_h_GUID_A52AC9B3_34D5_4EEA_9D34_8AA8223DAF02
@@ -0,0 +1,109 @@
+/** @file
+    @brief On-disk layout of a pose capture.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseRecord_h_GUID_F92E1BD8_7700_4691_AB6B_A3C303302566
+#define INCLUDED_PoseRecord_h_GUID_F92E1BD8_7700_4691_AB6B_A3C303302566
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdint>
+#include <type_traits>
+
+namespace osvr {
+namespace recording {
+
+/**
+ * A capture file is a CaptureHeader followed by up to @c capacity
+ * PoseRecord%s, all in the byte order of the machine that recorded them.
+ * Both structures only hold fixed-width fields so the layout doesn't depend
+ * on the OpenVR or OSVR headers in use.
+ */
+static const char CaptureMagic[8] = { 'O', 'S', 'V', 'R', 'P', 'O', 'S', 'E' };
+static const uint32_t CaptureVersion = 1;
+
+struct CaptureHeader {
+    char magic[8];              ///< CaptureMagic
+    uint32_t version;           ///< CaptureVersion
+    uint32_t headerSize;        ///< sizeof(CaptureHeader)
+    uint32_t recordSize;        ///< sizeof(PoseRecord)
+    uint32_t reserved;
+    uint64_t capacity;          ///< number of records the file has room for
+    uint64_t count;             ///< number of records written so far
+    uint64_t dropped;           ///< records discarded because the file was full
+    double startHostTime;       ///< host time when recording started, in seconds
+    uint8_t padding[8];
+};
+
+/**
+ * The fields of a vr::DriverPose_t.
+ */
+struct DriverPoseRecord {
+    enum Flags : uint32_t {
+        PoseIsValid = 1 << 0,
+        WillDriftInYaw = 1 << 1,
+        ShouldApplyHeadModel = 1 << 2
+    };
+
+    double poseTimeOffset;
+    double worldFromDriverRotation[4];      ///< w, x, y, z
+    double worldFromDriverTranslation[3];
+    double driverFromHeadRotation[4];       ///< w, x, y, z
+    double driverFromHeadTranslation[3];
+    double position[3];
+    double velocity[3];
+    double acceleration[3];
+    double rotation[4];                     ///< w, x, y, z
+    double angularVelocity[3];
+    double angularAcceleration[3];
+    int32_t result;                         ///< vr::ETrackingResult
+    uint32_t flags;                         ///< Flags
+};
+
+/**
+ * One tracker report and the pose the driver handed to the host for it.
+ */
+struct PoseRecord {
+    int64_t osvrSeconds;                    ///< report timestamp
+    int32_t osvrMicroseconds;
+    int32_t sensor;
+    double hostTime;                        ///< host time when the report arrived, in seconds
+    double reportPosition[3];
+    double reportOrientation[4];            ///< w, x, y, z
+    DriverPoseRecord driverPose;
+};
+
+static_assert(sizeof(CaptureHeader) == 64, "CaptureHeader layout changed; bump CaptureVersion.");
+static_assert(sizeof(DriverPoseRecord) == 280, "DriverPoseRecord layout changed; bump CaptureVersion.");
+static_assert(sizeof(PoseRecord) == 360, "PoseRecord layout changed; bump CaptureVersion.");
+static_assert(std::is_pod<CaptureHeader>::value && std::is_pod<PoseRecord>::value, "Capture structures must be plain data.");
+
+} // end namespace recording
+} // end namespace osvr
+
+#endif // INCLUDED_PoseRecord_h_GUID_F92E1BD8_7700_4691_AB6B_A3C303302566
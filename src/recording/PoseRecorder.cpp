@@ -0,0 +1,80 @@
+/** @file
+    @brief Appends pose records to a capture file.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseRecorder.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>          // for std::memcpy, std::memset
+
+namespace osvr {
+namespace recording {
+
+PoseRecorder::~PoseRecorder()
+{
+    close();
+}
+
+bool PoseRecorder::open(const std::string& path, std::size_t capacity, double start_host_time)
+{
+    close();
+
+    if (!file_.create(path, sizeof(CaptureHeader) + capacity * sizeof(PoseRecord)))
+        return false;
+
+    header_ = static_cast<CaptureHeader*>(file_.data());
+    records_ = reinterpret_cast<PoseRecord*>(static_cast<char*>(file_.data()) + sizeof(CaptureHeader));
+    capacity_ = capacity;
+    count_ = 0;
+    dropped_ = 0;
+
+    std::memset(header_, 0, sizeof(CaptureHeader));
+    std::memcpy(header_->magic, CaptureMagic, sizeof(CaptureMagic));
+    header_->version = CaptureVersion;
+    header_->headerSize = sizeof(CaptureHeader);
+    header_->recordSize = sizeof(PoseRecord);
+    header_->capacity = capacity_;
+    header_->startHostTime = start_host_time;
+
+    return true;
+}
+
+void PoseRecorder::close()
+{
+    if (!header_)
+        return;
+
+    header_->count = count_;
+    header_->dropped = dropped_;
+    header_->capacity = count_;
+    header_ = nullptr;
+    records_ = nullptr;
+    file_.close(sizeof(CaptureHeader) + static_cast<std::size_t>(count_) * sizeof(PoseRecord));
+}
+
+} // end namespace recording
+} // end namespace osvr
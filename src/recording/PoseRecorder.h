@@ -0,0 +1,135 @@
+/** @file
+    @brief Appends pose records to a capture file.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseRecorder_h_GUID_A1A827EE_E8B4_4488_BB55_19C7B538488A
+#define INCLUDED_PoseRecorder_h_GUID_A1A827EE_E8B4_4488_BB55_19C7B538488A
+
+// Internal Includes
+#include "PoseRecord.h"
+#include "io/MappedFile.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>           // for std::atomic_thread_fence
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <string>
+
+namespace osvr {
+namespace recording {
+
+/**
+ * @brief Writes pose records into a preallocated, memory-mapped capture file.
+ *
+ * All the file's space is set aside and mapped when it's opened, so
+ * recording a pose is just a copy into memory: no system calls, no
+ * allocation. Once the file is full, further records are counted and
+ * dropped. The header's record count is updated after each record, so a
+ * capture cut short by a crash is still readable up to the last complete
+ * record.
+ *
+ * Only one thread may call record().
+ */
+class PoseRecorder {
+public:
+    PoseRecorder() = default;
+    ~PoseRecorder();
+
+    PoseRecorder(const PoseRecorder&) = delete;
+    PoseRecorder& operator=(const PoseRecorder&) = delete;
+
+    /**
+     * Creates a capture file at @p path with room for @p capacity records.
+     *
+     * @param start_host_time the host time recording starts at, in seconds;
+     * kept in the header for reference.
+     */
+    bool open(const std::string& path, std::size_t capacity, double start_host_time = 0.0);
+
+    /**
+     * Finishes the capture, trimming the file to the records written.
+     */
+    void close();
+
+    bool isOpen() const
+    {
+        return nullptr != header_;
+    }
+
+    /**
+     * Appends a record.
+     */
+    void record(const PoseRecord& pose_record)
+    {
+        if (!header_)
+            return;
+
+        if (count_ >= capacity_) {
+            header_->dropped = ++dropped_;
+            return;
+        }
+
+        records_[count_] = pose_record;
+        ++count_;
+
+        // Publish the record before the count that covers it.
+        std::atomic_thread_fence(std::memory_order_release);
+        header_->count = count_;
+    }
+
+    std::size_t getRecordCount() const
+    {
+        return static_cast<std::size_t>(count_);
+    }
+
+    std::size_t getCapacity() const
+    {
+        return static_cast<std::size_t>(capacity_);
+    }
+
+    std::size_t getDroppedCount() const
+    {
+        return static_cast<std::size_t>(dropped_);
+    }
+
+    const std::string& getError() const
+    {
+        return file_.getError();
+    }
+
+private:
+    io::MappedFile file_;
+    CaptureHeader* header_ = nullptr;
+    PoseRecord* records_ = nullptr;
+    uint64_t capacity_ = 0;
+    uint64_t count_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+} // end namespace recording
+} // end namespace osvr
+
+#endif // INCLUDED_PoseRecorder_h_GUID_A1A827EE_E8B4_4488_BB55_19C7B538488A
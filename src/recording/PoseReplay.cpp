@@ -0,0 +1,136 @@
+/** @file
+    @brief Plays a pose capture back through a tracker callback.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseReplay.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::max
+#include <chrono>
+#include <cmath>            // for std::floor, std::lround
+#include <thread>           // for std::this_thread::sleep_until
+
+namespace osvr {
+namespace recording {
+
+namespace {
+
+double toSeconds(int64_t seconds, int32_t microseconds)
+{
+    return static_cast<double>(seconds) + static_cast<double>(microseconds) * 1e-6;
+}
+
+OSVR_TimeValue toTimeValue(double seconds)
+{
+    OSVR_TimeValue time_value;
+    const double whole = std::floor(seconds);
+    time_value.seconds = static_cast<OSVR_TimeValue_Seconds>(whole);
+    time_value.microseconds = static_cast<OSVR_TimeValue_Microseconds>(std::lround((seconds - whole) * 1e6));
+    if (time_value.microseconds >= 1000000) {
+        time_value.seconds += 1;
+        time_value.microseconds -= 1000000;
+    }
+    return time_value;
+}
+
+} // end anonymous namespace
+
+constexpr double PoseReplay::AsFastAsPossible;
+
+PoseReplay::PoseReplay(const PoseCapture& capture) : capture_(capture), stopRequested_(false)
+{
+    // do nothing
+}
+
+void PoseReplay::setSpeed(double speed)
+{
+    speed_ = std::max(speed, AsFastAsPossible);
+}
+
+double PoseReplay::getSpeed() const
+{
+    return speed_;
+}
+
+std::size_t PoseReplay::run(OSVR_PoseCallback callback, void* userdata)
+{
+    stopRequested_ = false;
+    if (capture_.empty() || !callback)
+        return 0;
+
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    OSVR_TimeValue osvr_start;
+    osvrTimeValueGetNow(&osvr_start);
+    const double osvr_start_seconds = toSeconds(osvr_start.seconds, osvr_start.microseconds);
+    const double first_time = toSeconds(capture_[0].osvrSeconds, capture_[0].osvrMicroseconds);
+    const bool timed = speed_ > AsFastAsPossible;
+
+    std::size_t delivered = 0;
+    for (const auto& record : capture_) {
+        if (stopRequested_.load(std::memory_order_relaxed))
+            break;
+
+        OSVR_TimeValue timestamp;
+        OSVR_PoseReport report;
+        toReport(record, timestamp, report);
+
+        if (timed) {
+            const double elapsed = (toSeconds(timestamp.seconds, timestamp.microseconds) - first_time) / speed_;
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(elapsed)));
+            timestamp = toTimeValue(osvr_start_seconds + elapsed);
+        } else {
+            osvrTimeValueGetNow(&timestamp);
+        }
+
+        callback(userdata, &timestamp, &report);
+        ++delivered;
+    }
+
+    return delivered;
+}
+
+void PoseReplay::stop()
+{
+    stopRequested_ = true;
+}
+
+void PoseReplay::toReport(const PoseRecord& record, OSVR_TimeValue& timestamp, OSVR_PoseReport& report)
+{
+    timestamp.seconds = record.osvrSeconds;
+    timestamp.microseconds = record.osvrMicroseconds;
+    report.sensor = record.sensor;
+    for (int i = 0; i < 3; ++i) {
+        report.pose.translation.data[i] = record.reportPosition[i];
+    }
+    for (int i = 0; i < 4; ++i) {
+        report.pose.rotation.data[i] = record.reportOrientation[i];
+    }
+}
+
+} // end namespace recording
+} // end namespace osvr
@@ -0,0 +1,96 @@
+/** @file
+    @brief Plays a pose capture back through a tracker callback.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseReplay_h_GUID_E7C11359_430F_436B_A86D_9A00B4F7A25C
+#define INCLUDED_PoseReplay_h_GUID_E7C11359_430F_436B_A86D_9A00B4F7A25C
+
+// Internal Includes
+#include "PoseCapture.h"
+#include "PoseRecord.h"
+
+// Library/third-party includes
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Standard includes
+#include <atomic>
+#include <cstddef>          // for std::size_t
+
+namespace osvr {
+namespace recording {
+
+/**
+ * @brief Stands in for the OSVR server by delivering the reports in a
+ * capture to a pose callback, the same way ClientKit would.
+ *
+ * Report timestamps are moved so the first report is stamped with the time
+ * replay started, and the rest keep their original spacing scaled by the
+ * replay speed. When replaying as fast as possible, each report is stamped
+ * with when it's delivered instead, as a live server would, so timing and
+ * latency stay meaningful; filters and velocity estimates then see the
+ * delivery intervals rather than the captured ones.
+ */
+class PoseReplay {
+public:
+    /// Speed that delivers reports as fast as the callback takes them.
+    static constexpr double AsFastAsPossible = 0.0;
+
+    explicit PoseReplay(const PoseCapture& capture);
+
+    /**
+     * Sets the playback speed: 1 for the original timing, 2 for twice as
+     * fast, and so on, or AsFastAsPossible.
+     */
+    void setSpeed(double speed);
+    double getSpeed() const;
+
+    /**
+     * Plays every report through @p callback on this thread, returning when
+     * the capture ends or stop() is called.
+     *
+     * @return the number of reports delivered.
+     */
+    std::size_t run(OSVR_PoseCallback callback, void* userdata);
+
+    /**
+     * Asks run() to return early. Safe to call from any thread.
+     */
+    void stop();
+
+    /**
+     * Converts a record back into the report and timestamp it was captured
+     * from.
+     */
+    static void toReport(const PoseRecord& record, OSVR_TimeValue& timestamp, OSVR_PoseReport& report);
+
+private:
+    const PoseCapture& capture_;
+    double speed_ = 1.0;
+    std::atomic<bool> stopRequested_;
+};
+
+} // end namespace recording
+} // end namespace osvr
+
+#endif // INCLUDED_PoseReplay_h_GUID_E7C11359_430F_436B_A86D_9A00B4F7A25C
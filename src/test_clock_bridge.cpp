@@ -0,0 +1,140 @@
+/** @file
+    @brief Checks that ClockBridge follows the offset and drift between two
+    clocks, preferring the tightest readings, and restarts when one steps.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ClockBridge.h"
+#include "TestCheck.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>                        // for std::abs
+#include <iostream>
+
+namespace {
+
+/// Where the host clock was when the OSVR clock read zero
+const double Offset = -1.46e9;
+
+/// Readings are taken this often, in seconds
+const double ReadingInterval = 0.001;
+
+/**
+ * A host clock running at (1 + @p drift) times the rate of the OSVR clock.
+ */
+double hostTime(double osvr_time, double drift)
+{
+    return osvr_time * (1.0 + drift) + Offset;
+}
+
+void checkOffset()
+{
+    ClockBridge bridge;
+    check(!bridge.isValid(), "A new bridge shouldn't have an estimate.");
+
+    const double start = 1.46e9;
+    bridge.addSample(start, hostTime(start, 0.0), 1e-6);
+    check(bridge.isValid(), "One reading should give an estimate.");
+    check(std::abs(bridge.toHostTime(start) - hostTime(start, 0.0)) < 1e-6, "The first reading should map straight away.");
+
+    for (int i = 1; i < 2000; ++i) {
+        const double osvr_time = start + i * ReadingInterval;
+        bridge.addSample(osvr_time, hostTime(osvr_time, 0.0), 1e-6);
+    }
+    const double later = start + 3.0;
+    check(std::abs(bridge.getOffset(later) - (hostTime(later, 0.0) - later)) < 1e-6, "A fixed offset should be followed exactly.");
+    check(std::abs(bridge.getDrift()) < 1e-9, "Clocks at the same rate shouldn't drift.");
+}
+
+void checkDrift()
+{
+    // The tightest reading of the whole run comes first, so the sampling
+    // intervals have to close on their own rather than wait for a tighter one.
+    const double drift = 1e-4;
+    const double start = 1.46e9;
+    ClockBridge bridge;
+    bridge.addSample(start, hostTime(start, drift), 1e-7);
+    for (int i = 1; i < 60000; ++i) {
+        const double osvr_time = start + i * ReadingInterval;
+        bridge.addSample(osvr_time, hostTime(osvr_time, drift), 1e-5);
+    }
+
+    const double later = start + 60.0;
+    const double error = bridge.toHostTime(later) - hostTime(later, drift);
+    check(std::abs(bridge.getDrift() - drift) < 1e-6, "The drift between the clocks should be estimated.");
+    check(std::abs(error) < 1e-4, "Host times should follow a drifting clock.");
+    std::cout << " - Drift " << bridge.getDrift() << " estimated for " << drift << ", mapping off by " << error * 1e6 << " us after a minute." << std::endl;
+}
+
+void checkTightest()
+{
+    // Every reading but one per interval is late by as much as its
+    // uncertainty; only the tightest is exact.
+    const double start = 1.46e9;
+    ClockBridge bridge;
+    for (int i = 0; i < 20000; ++i) {
+        const double osvr_time = start + i * ReadingInterval;
+        const bool tight = (i % 250 == 137);
+        const double uncertainty = tight ? 1e-6 : 2e-3;
+        const double late = tight ? 0.0 : uncertainty;
+        bridge.addSample(osvr_time, hostTime(osvr_time, 0.0) + late, uncertainty);
+    }
+
+    const double later = start + 20.0;
+    check(std::abs(bridge.toHostTime(later) - hostTime(later, 0.0)) < 1e-5, "The tightest reading of each interval should be the one used.");
+}
+
+void checkStep()
+{
+    const double start = 1.46e9;
+    ClockBridge bridge;
+    double host_time = 0.0;
+    for (int i = 0; i < 5000; ++i) {
+        const double osvr_time = start + i * ReadingInterval;
+        host_time = hostTime(osvr_time, 1e-4);
+        bridge.addSample(osvr_time, host_time, 1e-6);
+    }
+    check(std::abs(bridge.getDrift() - 1e-4) < 1e-6, "The drift should be estimated before the step.");
+
+    // The OSVR clock jumps forward ten seconds while the host clock doesn't.
+    const double stepped = start + 5.0 + 10.0;
+    host_time += ReadingInterval;
+    bridge.addSample(stepped, host_time, 1e-6);
+    check(std::abs(bridge.toHostTime(stepped) - host_time) < 1e-6, "A stepped clock should restart the estimate from the new reading.");
+    check(0.0 == bridge.getDrift(), "A stepped clock should forget the drift until it has readings to fit.");
+}
+
+} // end anonymous namespace
+
+int main()
+{
+    checkOffset();
+    checkDrift();
+    checkTightest();
+    checkStep();
+
+    return finishChecks("Clock bridge");
+}
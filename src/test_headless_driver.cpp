@@ -0,0 +1,717 @@
+/** @file
+    @brief Runs the server driver against a fake OSVR server and SteamVR host,
+    checking and timing startup and the pose path.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "ClientDriver_OSVR.h"          // for ClientDriver_OSVR
+#include "OSVRTrackedDevice.h"          // for OSVRTrackedDevice
+#include "ServerDriver_OSVR.h"          // for ServerDriver_OSVR
+#include "fake/FakeClientKit.h"         // for osvr::fake::FakeServer
+#include "fake/FakeServerDriverHost.h"  // for osvr::fake::FakeServerDriverHost, osvr::fake::FakeClientDriverHost
+#include "recording/PoseCapture.h"      // for osvr::recording::PoseCapture
+#include "recording/PoseRecorder.h"     // for osvr::recording::PoseRecorder
+#include "recording/PoseReplay.h"       // for osvr::recording::PoseReplay
+#include "TestCheck.h"
+
+// Library/third-party includes
+#include <openvr_driver.h>
+#include <osvr/Util/TimeValueC.h>       // for osvrTimeValueGetNow
+
+// Standard includes
+#include <chrono>
+#include <algorithm>                    // for std::min, std::max
+#include <cmath>                        // for std::abs
+#include <cstdio>                       // for std::remove
+#include <cstdlib>                      // for EXIT_SUCCESS, std::strtoull
+#include <iostream>
+#include <string>
+#include <thread>
+
+using osvr::fake::FakeClientDriverHost;
+using osvr::fake::FakeServer;
+using osvr::fake::FakeServerDriverHost;
+using osvr::recording::PoseCapture;
+using osvr::recording::PoseRecord;
+using osvr::recording::PoseRecorder;
+using osvr::recording::PoseReplay;
+
+namespace {
+
+const char* const HeadPath = "/me/head";
+
+/// A display descriptor with mild barrel distortion, the same for each color
+const char* const DisplayDescriptor = R"({
+    "hmd": {
+        "distortion": {
+            "type": "rgb_symmetric_polynomials",
+            "polynomial_coeffs_red": [0, 1, 0, 0.5],
+            "polynomial_coeffs_green": [0, 1, 0, 0.5],
+            "polynomial_coeffs_blue": [0, 1, 0, 0.5]
+        }
+    }
+})";
+
+/// Pulls the screen's edges in, so the corners of each eye's image are never seen
+const char* const HiddenCornersDescriptor = R"({
+    "hmd": {
+        "distortion": {
+            "type": "rgb_symmetric_polynomials",
+            "polynomial_coeffs_red": [0, 1, 0, -0.4],
+            "polynomial_coeffs_green": [0, 1, 0, -0.4],
+            "polynomial_coeffs_blue": [0, 1, 0, -0.4]
+        }
+    }
+})";
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * The OSVR clock's current time, in microseconds.
+ */
+int64_t nowMicroseconds()
+{
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+    return static_cast<int64_t>(now.seconds) * 1000000 + now.microseconds;
+}
+
+OSVR_TimeValue toTimeValue(int64_t time_us)
+{
+    OSVR_TimeValue timestamp;
+    timestamp.seconds = time_us / 1000000;
+    timestamp.microseconds = static_cast<OSVR_TimeValue_Microseconds>(time_us % 1000000);
+    return timestamp;
+}
+
+/**
+ * Queues @p count head poses 1 ms apart, moving along x at 1 m/s, with the
+ * last one stamped now.
+ */
+void queueHeadPoses(std::size_t count)
+{
+    const int64_t now_us = nowMicroseconds();
+    for (std::size_t i = 0; i < count; ++i) {
+        const OSVR_TimeValue timestamp = toTimeValue(now_us - static_cast<int64_t>(count - 1 - i) * 1000);
+        OSVR_PoseReport report = {};
+        report.pose.translation.data[0] = static_cast<double>(i) * 0.001;
+        report.pose.rotation.data[0] = 1.0;
+        FakeServer::instance().queuePoseReport(HeadPath, timestamp, report);
+    }
+}
+
+/**
+ * Reads a property of each type, and some the device should refuse.
+ */
+void checkProperties(vr::ITrackedDeviceServerDriver* device)
+{
+    vr::ETrackedPropertyError error = vr::TrackedProp_Success;
+    check(device->GetBoolTrackedDeviceProperty(vr::Prop_WillDriftInYaw_Bool, &error) && vr::TrackedProp_Success == error, "Bool properties should be readable.");
+    check(vr::TrackedDeviceClass_HMD == device->GetInt32TrackedDeviceProperty(vr::Prop_DeviceClass_Int32, &error) && vr::TrackedProp_Success == error, "The device should say it's an HMD.");
+    check(192 == device->GetUint64TrackedDeviceProperty(vr::Prop_DisplayFirmwareVersion_Uint64, &error) && vr::TrackedProp_Success == error, "Uint64 properties should be readable.");
+
+    char model[vr::k_unTrackingStringSize];
+    check(9 == device->GetStringTrackedDeviceProperty(vr::Prop_ModelNumber_String, model, sizeof(model), &error) && vr::TrackedProp_Success == error
+          && std::string("OSVR HMD") == model, "String properties should be copied out.");
+    check(9 == device->GetStringTrackedDeviceProperty(vr::Prop_ModelNumber_String, model, 4, &error) && vr::TrackedProp_BufferTooSmall == error, "Strings that don't fit should say how much room they need.");
+
+    device->GetFloatTrackedDeviceProperty(vr::Prop_WillDriftInYaw_Bool, &error);
+    check(vr::TrackedProp_WrongDataType == error, "Reading a property as the wrong type should fail.");
+    device->GetFloatTrackedDeviceProperty(vr::Prop_FieldOfViewLeftDegrees_Float, &error);
+    check(vr::TrackedProp_WrongDeviceClass == error, "Reading another device class's property should fail.");
+    device->GetUint64TrackedDeviceProperty(vr::Prop_CameraFirmwareVersion_Uint64, &error);
+    check(vr::TrackedProp_ValueNotProvidedByDevice == error, "Properties we don't provide should say so.");
+    device->GetBoolTrackedDeviceProperty(static_cast<vr::ETrackedDeviceProperty>(1999), &error);
+    check(vr::TrackedProp_UnknownProperty == error, "Unknown properties should be reported as such.");
+
+    // Time the requests SteamVR makes most, once it's started
+    const int num_reads = 100000;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_reads; ++i) {
+        device->GetFloatTrackedDeviceProperty(vr::Prop_UserIpdMeters_Float, &error);
+        device->GetStringTrackedDeviceProperty(vr::Prop_SerialNumber_String, model, sizeof(model), &error);
+    }
+    std::cout << " - Read properties in " << secondsSince(start) / (2 * num_reads) * 1e9 << " ns each." << std::endl;
+}
+
+/**
+ * Checks distortion comes from the display descriptor, and times the
+ * lookups SteamVR makes for each vertex of its distortion mesh.
+ */
+void checkDistortion(vr::IVRDisplayComponent* display)
+{
+    const auto center = display->ComputeDistortion(vr::Eye_Left, 0.5f, 0.5f);
+    check(std::abs(center.rfGreen[0] - 0.5f) < 1e-5f && std::abs(center.rfGreen[1] - 0.5f) < 1e-5f, "The lens center shouldn't be distorted.");
+
+    // r = 0.4: r' = 0.4 + 0.5 * 0.064
+    const auto edge = display->ComputeDistortion(vr::Eye_Left, 0.9f, 0.5f);
+    check(std::abs(edge.rfGreen[0] - 0.932f) < 1e-4f, "The descriptor's distortion should be applied.");
+
+    const int num_vertices = 100000;
+    float sum = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_vertices; ++i) {
+        sum += display->ComputeDistortion(vr::Eye_Right, static_cast<float>(i % 317) / 316.0f, static_cast<float>(i % 311) / 310.0f).rfRed[0];
+    }
+    std::cout << " - Computed distortion in " << secondsSince(start) / num_vertices * 1e9 << " ns per vertex (" << (sum > 0.0f ? "ok" : "?") << ")." << std::endl;
+}
+
+/**
+ * Brings a driver up against the fake server, pushes poses through it and
+ * takes it down again, in the given tracking mode.
+ */
+void run(const std::string& tracking_mode, std::size_t num_poses)
+{
+    std::cout << "Tracking mode '" << tracking_mode << "':" << std::endl;
+
+    auto& server = FakeServer::instance();
+    server.reset();
+    server.setStringParameter("/renderManagerConfig", "{}");
+    server.setStringParameter("/display", DisplayDescriptor);
+    // Make startup wait on a few updates, as a real server does.
+    server.setStartupUpdates(3, 5);
+
+    FakeServerDriverHost host;
+    host.getFakeSettings().set("trackingMode", tracking_mode);
+    // Exercise the quality multiplier in one of the runs
+    const bool higher_quality = ("thread" == tracking_mode);
+    if (higher_quality)
+        host.getFakeSettings().set("renderQuality", "1.5");
+    else
+        host.getFakeSettings().set("renderGovernor", "true");
+    host.getFakeSettings().set("displayCheckInterval", "0");
+
+    ServerDriver_OSVR driver;
+    auto start = std::chrono::steady_clock::now();
+    const auto init_error = driver.Init(nullptr, &host, "", "");
+    const double init_time = secondsSince(start);
+    check(vr::VRInitError_None == init_error, "Init() should succeed.");
+    check(1 == driver.GetTrackedDeviceCount(), "There should be one tracked device.");
+    if (anyCheckFailed())
+        return;
+
+    auto device = driver.GetTrackedDeviceDriver(0);
+    vr::ETrackedPropertyError error = vr::TrackedProp_UnknownProperty;
+    device->GetInt32TrackedDeviceProperty(vr::Prop_DeviceClass_Int32, &error);
+    check(vr::TrackedProp_Success == error, "Properties should be readable before Activate().");
+
+    start = std::chrono::steady_clock::now();
+    const auto activate_error = device->Activate(0);
+    const double activate_time = secondsSince(start);
+    check(vr::VRInitError_None == activate_error, "Activate() should succeed.");
+    check(1 == server.getOpenInterfaceCount(), "Activate() should open the head interface.");
+    std::cout << " - Init() took " << init_time * 1e6 << " us, Activate() took " << activate_time * 1e6 << " us." << std::endl;
+
+    checkProperties(device);
+
+    auto display = static_cast<vr::IVRDisplayComponent*>(device->GetComponent(vr::IVRDisplayComponent_Version));
+    check(nullptr != display, "The device should have a display component.");
+    if (display) {
+        uint32_t x = 0, y = 0, width = 0, height = 0;
+        display->GetEyeOutputViewport(vr::Eye_Right, &x, &y, &width, &height);
+        check(960 == x && 960 == width && 1080 == height, "The right eye should get the right half of the display.");
+
+        // The distortion leaves the lens centers unmagnified, so the eyes'
+        // own resolution is right at the default quality.
+        display->GetRecommendedRenderTargetSize(&width, &height);
+        const uint32_t expected_width = higher_quality ? 1440 : 960;
+        const uint32_t expected_height = higher_quality ? 1620 : 1080;
+        check(expected_width == width && expected_height == height, "The render target should match the eyes' pixel density at the lens centers.");
+
+        checkDistortion(display);
+
+        if (!higher_quality) {
+            // Frames twice as slow as the 60 Hz descriptor allows should make
+            // the governor shrink the target, but not below its 0.5 default.
+            auto tracked_device = static_cast<OSVRTrackedDevice*>(device);
+            for (int frame = 0; frame < 120; ++frame) {
+                tracked_device->ReportFrameTime(2.0 / 60.0);
+            }
+            display->GetRecommendedRenderTargetSize(&width, &height);
+            check(width < 960 && height < 1080 && width >= 480 && height >= 540, "Slow frames should shrink the render target within the governor's bounds.");
+            std::cout << " - Governor shrank the render target to " << width << "x" << height << "." << std::endl;
+        }
+
+        if (!higher_quality) {
+            // Move the eyes apart and change the lenses on the server; the
+            // next frames should pick the new configuration up and tell the
+            // host. Meanwhile another thread asks for distortion, as the
+            // compositor would, and should only ever see the old lenses or
+            // the new ones.
+            auto wider_display = osvr::fake::makeHdkDisplay();
+            wider_display.eyes[0].pose.translation.data[0] = -0.035;
+            wider_display.eyes[1].pose.translation.data[0] = 0.035;
+            wider_display.eyes[1].viewport[2] = 900;
+            server.setDisplay(wider_display);
+            server.setStringParameter("/display", HiddenCornersDescriptor);
+
+            std::atomic<bool> switching(true);
+            std::atomic<bool> mixed(false);
+            std::thread reader([&] {
+                while (switching) {
+                    // r = 0.4: r' = 0.4 + 0.5 * 0.064 before, 0.4 - 0.4 * 0.064 after
+                    const float x = display->ComputeDistortion(vr::Eye_Left, 0.9f, 0.5f).rfGreen[0];
+                    if (std::abs(x - 0.932f) > 1e-4f && std::abs(x - 0.8744f) > 1e-4f)
+                        mixed = true;
+                }
+            });
+            for (int frame = 0; frame < 10; ++frame) {
+                driver.RunFrame();
+            }
+            switching = false;
+            reader.join();
+
+            check(!mixed, "Distortion asked for during a change should be wholly old or wholly new.");
+            const auto edge = display->ComputeDistortion(vr::Eye_Left, 0.9f, 0.5f);
+            check(std::abs(edge.rfGreen[0] - 0.8744f) < 1e-4f, "A new display descriptor should change the distortion.");
+            const float ipd = device->GetFloatTrackedDeviceProperty(vr::Prop_UserIpdMeters_Float, &error);
+            check(std::abs(ipd - 0.07f) < 1e-6f, "A new display configuration should update the IPD.");
+            display->GetEyeOutputViewport(vr::Eye_Right, &x, &y, &width, &height);
+            check(900 == width, "A new display configuration should update the viewports.");
+            check(1 == host.getPropertiesChangedCount(), "The host should hear the properties changed once.");
+        }
+    }
+
+    queueHeadPoses(num_poses);
+    start = std::chrono::steady_clock::now();
+    if ("thread" == tracking_mode) {
+        // Our own thread delivers the poses; wait for it.
+        while (host.getPoseCount() < num_poses && secondsSince(start) < 5.0) {
+            std::this_thread::yield();
+        }
+    } else {
+        driver.RunFrame();
+    }
+    const double pose_time = secondsSince(start);
+    check(host.getPoseCount() == num_poses, "The host should receive every pose.");
+    std::cout << " - Delivered " << host.getPoseCount() << " poses in " << pose_time * 1e3 << " ms ("
+              << pose_time / num_poses * 1e9 << " ns/pose)." << std::endl;
+
+    auto tracked_device = static_cast<OSVRTrackedDevice*>(device);
+    const auto& latency = tracked_device->GetLatencyStats();
+    check(latency.reportToHost.getCount() == num_poses, "Every pose should have its latency measured.");
+    const auto driver_latency = latency.callbackToHost.getSummary();
+    std::cout << " - Callback to host: p50 " << driver_latency.p50 * 1e9 << " ns, p99 " << driver_latency.p99 * 1e9
+              << " ns, p99.9 " << driver_latency.p999 * 1e9 << " ns." << std::endl;
+    tracked_device->ResetLatencyStats();
+    check(0 == latency.reportToHost.getCount(), "Resetting should clear the latency stats.");
+
+    const auto last_pose = device->GetPose();
+    const double last_x = static_cast<double>(num_poses - 1) * 0.001;
+    check(last_pose.poseIsValid, "The last pose should be valid.");
+    check(std::abs(last_pose.vecPosition[0] - last_x) < 1e-9, "GetPose() should return the last position reported.");
+    check(std::abs(last_pose.vecVelocity[0] - 1.0) < 0.01, "The estimated velocity should match the motion reported.");
+    check(last_pose.poseTimeOffset <= 0.0 && last_pose.poseTimeOffset > -0.5, "The last pose should be recent.");
+
+    device->Deactivate();
+    check(0 == server.getOpenInterfaceCount(), "Deactivate() should free the head interface.");
+    driver.Cleanup();
+    check(0 == server.getOpenContextCount(), "Cleanup() should shut the context down.");
+}
+
+/**
+ * Sends @p request to @p device, returning the response.
+ */
+std::string debugRequest(vr::ITrackedDeviceServerDriver* device, const char* request, uint32_t buffer_size = vr::k_unMaxDriverDebugResponseSize)
+{
+    std::string buffer(buffer_size, 'x');
+    device->DebugRequest(request, &buffer[0], buffer_size);
+    return buffer.c_str();
+}
+
+bool contains(const std::string& text, const char* part)
+{
+    return std::string::npos != text.find(part);
+}
+
+/**
+ * Exercises the debug requests against a device with a pose filter.
+ */
+void runDebugRequests()
+{
+    std::cout << "Debug requests:" << std::endl;
+
+    auto& server = FakeServer::instance();
+    server.reset();
+
+    FakeServerDriverHost host;
+    host.getFakeSettings().set("poseFilters", "oneEuro");
+
+    ServerDriver_OSVR driver;
+    check(vr::VRInitError_None == driver.Init(nullptr, &host, "", ""), "Init() should succeed.");
+    auto device = driver.GetTrackedDeviceDriver(0);
+    check(vr::VRInitError_None == device->Activate(0), "Activate() should succeed.");
+    queueHeadPoses(100);
+    driver.RunFrame();
+
+    check(contains(debugRequest(device, "help"), "reset-counters"), "help should list the requests.");
+    check(contains(debugRequest(device, "stats"), "pose reports: 100\n"), "stats should count the pose reports.");
+    check(contains(debugRequest(device, "latency"), "report to host"), "latency should show every stage.");
+    check(contains(debugRequest(device, "filter"), "oneEuro: minCutoff=1"), "filter should list the filters in use.");
+    check(contains(debugRequest(device, "  filter   set oneEuro beta 7.5 "), "oneEuro beta: 7.5 (was 20)"), "filter set should retune a filter.");
+    check(contains(debugRequest(device, "dump-config"), "beta=7.5"), "dump-config should show the retuned filter.");
+    check(contains(debugRequest(device, "filter set oneEuro gamma 1"), "error:"), "filter set should reject unknown parameters.");
+    check(contains(debugRequest(device, "filter set kalman beta 1"), "error:"), "filter set should reject filters not in use.");
+    check(contains(debugRequest(device, "filter set oneEuro beta fast"), "error:"), "filter set should reject values that aren't numbers.");
+    check(contains(debugRequest(device, "reset-counters"), "reset"), "reset-counters should say so.");
+    check(contains(debugRequest(device, "stats"), "pose reports: 0\n"), "reset-counters should zero the report count.");
+    check(contains(debugRequest(device, "governor"), "governor: off"), "governor should show its state.");
+    check(contains(debugRequest(device, "startup"), "display: "), "startup should show each phase of activation.");
+    check(contains(debugRequest(device, "governor frame 20"), "error:"), "governor frame should refuse while the governor is off.");
+    check(contains(debugRequest(device, "governor frame"), "error: usage"), "governor frame should need a frame time.");
+    check(0 == static_cast<OSVRTrackedDevice*>(device)->GetLatencyStats().reportToHost.getCount(), "reset-counters should clear the latency stats.");
+    check(contains(debugRequest(device, "frobnicate"), "unknown request 'frobnicate'"), "Unknown requests should get an error.");
+
+    const auto truncated = debugRequest(device, "dump-config", 64);
+    check(truncated.size() == 63 && contains(truncated, "[truncated]"), "Long responses should be cut off to fit, and say so.");
+    std::cout << " - Checked." << std::endl;
+
+    device->Deactivate();
+    driver.Cleanup();
+}
+
+/**
+ * Delivers a pose report for the head at @p time_us, at @p x along the X
+ * axis.
+ */
+void deliverHeadPose(ServerDriver_OSVR& driver, int64_t time_us, double x)
+{
+    OSVR_PoseReport report = {};
+    report.pose.translation.data[0] = x;
+    report.pose.rotation.data[0] = 1.0;
+    FakeServer::instance().queuePoseReport(HeadPath, toTimeValue(time_us), report);
+    driver.RunFrame();
+}
+
+/**
+ * Checks that velocities the tracker reports are used in place of the
+ * estimated ones while they're under 100 ms old, and not after.
+ */
+void runVelocityReports()
+{
+    std::cout << "Velocity reports:" << std::endl;
+
+    auto& server = FakeServer::instance();
+    server.reset();
+
+    FakeServerDriverHost host;
+    host.getFakeSettings().set("velocitySmoothing", "0");
+
+    ServerDriver_OSVR driver;
+    check(vr::VRInitError_None == driver.Init(nullptr, &host, "", ""), "Init() should succeed.");
+    auto device = driver.GetTrackedDeviceDriver(0);
+    check(vr::VRInitError_None == device->Activate(0), "Activate() should succeed.");
+
+    // Moving at 1 m/s along X by the poses, but 2 m/s along Y and turning
+    // at 1 rad/s about Z by the tracker's own report.
+    const int64_t start_us = nowMicroseconds() - 1000000;
+    deliverHeadPose(driver, start_us, 0.0);
+    OSVR_VelocityReport velocity = {};
+    velocity.state.linearVelocity.data[1] = 2.0;
+    velocity.state.linearVelocityValid = true;
+    velocity.state.angularVelocity.incrementalRotation.data[0] = std::cos(0.005);
+    velocity.state.angularVelocity.incrementalRotation.data[3] = std::sin(0.005);
+    velocity.state.angularVelocity.dt = 0.01;
+    velocity.state.angularVelocityValid = true;
+    server.queueVelocityReport(HeadPath, toTimeValue(start_us + 5000), velocity);
+    driver.RunFrame();
+
+    deliverHeadPose(driver, start_us + 10000, 0.01);
+    auto pose = host.getLastPose();
+    check(std::abs(pose.vecVelocity[0]) < 1e-9 && std::abs(pose.vecVelocity[1] - 2.0) < 1e-9, "A current velocity report should be used in place of the estimate.");
+    check(std::abs(pose.vecAngularVelocity[2] - 1.0) < 1e-9, "A current velocity report's angular velocity should be used.");
+
+    // 95 ms after the report it's still current; 105 ms after, it isn't.
+    deliverHeadPose(driver, start_us + 100000, 0.1);
+    pose = host.getLastPose();
+    check(std::abs(pose.vecVelocity[1] - 2.0) < 1e-9, "A velocity report under 100 ms old should still be used.");
+    deliverHeadPose(driver, start_us + 110000, 0.11);
+    pose = host.getLastPose();
+    check(std::abs(pose.vecVelocity[0] - 1.0) < 1e-6 && std::abs(pose.vecVelocity[1]) < 1e-9, "A velocity report over 100 ms old should give way to the estimate.");
+    check(std::abs(pose.vecAngularVelocity[2]) < 1e-9, "The estimated angular velocity should replace a stale report's.");
+    std::cout << " - Checked." << std::endl;
+
+    device->Deactivate();
+    driver.Cleanup();
+}
+
+/**
+ * Checks that GetPoseAtTime() interpolates between the poses delivered and
+ * stops extrapolating at the limit.
+ */
+void runPoseAtTime()
+{
+    std::cout << "Pose at time:" << std::endl;
+
+    FakeServer::instance().reset();
+    FakeServerDriverHost host;
+    ServerDriver_OSVR driver;
+    check(vr::VRInitError_None == driver.Init(nullptr, &host, "", ""), "Init() should succeed.");
+    auto device = driver.GetTrackedDeviceDriver(0);
+    check(vr::VRInitError_None == device->Activate(0), "Activate() should succeed.");
+    auto tracked_device = static_cast<OSVRTrackedDevice*>(device);
+
+    // 1 m/s along X
+    const int64_t start_us = nowMicroseconds() - 1000000;
+    for (int i = 0; i < 3; ++i) {
+        deliverHeadPose(driver, start_us + i * 10000, i * 0.01);
+    }
+
+    TimedPose older, newer;
+    const auto& history = tracked_device->GetPoseHistory();
+    check(history.get(1, older) && history.get(0, newer), "The poses delivered should be in the history.");
+
+    vr::DriverPose_t pose = {};
+    check(tracked_device->GetPoseAtTime(0.5 * (older.time + newer.time), pose), "A time between two poses should be answered.");
+    check(std::abs(pose.vecPosition[0] - 0.015) < 1e-6, "A time between two poses should give the position between them.");
+    check(std::abs(pose.vecVelocity[0] - 1.0) < 1e-6, "The pose should carry the velocity between the two poses.");
+
+    check(tracked_device->GetPoseAtTime(newer.time + 1.0, pose, 0.05), "A time past the newest pose should be answered.");
+    check(std::abs(pose.vecPosition[0] - 0.07) < 1e-6, "Extrapolation should stop at the limit.");
+
+    TimedPose oldest;
+    check(history.get(history.size() - 1, oldest) && !tracked_device->GetPoseAtTime(oldest.time - 0.001, pose), "A time before the oldest pose should not be answered.");
+    std::cout << " - Checked." << std::endl;
+
+    device->Deactivate();
+    driver.Cleanup();
+}
+
+/**
+ * Watches the poses a replay delivers to the host.
+ */
+struct ReplayObserver {
+    OSVRTrackedDevice* device;
+    FakeServerDriverHost* host;
+    std::size_t delivered = 0;
+    double earliestOffset = 0.0;
+    double latestOffset = 0.0;
+
+    static void callback(void* userdata, const OSVR_TimeValue* timestamp, const OSVR_PoseReport* report)
+    {
+        auto self = static_cast<ReplayObserver*>(userdata);
+        self->device->InjectPoseReport(*timestamp, *report);
+        const double offset = self->host->getLastPose().poseTimeOffset;
+        self->earliestOffset = (0 == self->delivered) ? offset : std::min(self->earliestOffset, offset);
+        self->latestOffset = (0 == self->delivered) ? offset : std::max(self->latestOffset, offset);
+        ++self->delivered;
+    }
+};
+
+/**
+ * Records a capture and replays it through the tracker callback path,
+ * checking that every report reaches the host, paced for the replay speed,
+ * with poses stamped as just measured.
+ */
+void runReplay()
+{
+    std::cout << "Replay:" << std::endl;
+
+    // 200 reports 1 ms apart, moving along X at 1 m/s
+    const std::string path = "test_headless_replay.capture";
+    const std::size_t num_records = 200;
+    {
+        PoseRecorder recorder;
+        check(recorder.open(path, num_records), "The capture should be created.");
+        for (std::size_t i = 0; i < num_records; ++i) {
+            PoseRecord record = {};
+            record.osvrSeconds = 1000;
+            record.osvrMicroseconds = static_cast<int32_t>(i * 1000);
+            record.reportPosition[0] = static_cast<double>(i) * 0.001;
+            record.reportOrientation[0] = 1.0;
+            recorder.record(record);
+        }
+    }
+    PoseCapture capture;
+    check(capture.open(path) && num_records == capture.size(), "The capture should hold every record.");
+
+    FakeServer::instance().reset();
+    FakeServerDriverHost host;
+    ServerDriver_OSVR driver;
+    check(vr::VRInitError_None == driver.Init(nullptr, &host, "", ""), "Init() should succeed.");
+    auto device = driver.GetTrackedDeviceDriver(0);
+    check(vr::VRInitError_None == device->Activate(0), "Activate() should succeed.");
+
+    // At 4x speed the 199 ms of reports take about 50 ms.
+    ReplayObserver observer;
+    observer.device = static_cast<OSVRTrackedDevice*>(device);
+    observer.host = &host;
+    const auto poses_before = host.getPoseCount();
+    PoseReplay replay(capture);
+    replay.setSpeed(4.0);
+    const auto start = std::chrono::steady_clock::now();
+    const auto delivered = replay.run(&ReplayObserver::callback, &observer);
+    const double elapsed = secondsSince(start);
+
+    check(num_records == delivered && num_records == observer.delivered, "Every report should be delivered.");
+    check(num_records == host.getPoseCount() - poses_before, "Every report should reach the host.");
+    check(elapsed >= 0.199 / 4.0 - 0.001, "Replay shouldn't run ahead of its speed.");
+    check(elapsed < 0.199 / 4.0 + 0.25, "Replay shouldn't fall far behind its speed.");
+
+    // Reports are stamped with when they're delivered, so each pose should
+    // be a few milliseconds old at most, never from the future.
+    check(observer.earliestOffset > -0.01 && observer.latestOffset <= 0.001, "Replayed poses should be stamped as just measured.");
+    std::cout << " - " << delivered << " reports in " << elapsed * 1e3 << " ms at 4x, pose time offsets " << observer.earliestOffset * 1e3 << " to " << observer.latestOffset * 1e3 << " ms." << std::endl;
+
+    // As fast as possible stamps each report as it's delivered, so poses are
+    // never from the future however much faster than captured they arrive.
+    ReplayObserver fast_observer;
+    fast_observer.device = observer.device;
+    fast_observer.host = &host;
+    replay.setSpeed(PoseReplay::AsFastAsPossible);
+    check(num_records == replay.run(&ReplayObserver::callback, &fast_observer), "Every report should be delivered as fast as possible too.");
+    check(fast_observer.earliestOffset > -0.01 && fast_observer.latestOffset <= 0.001, "Poses replayed as fast as possible should be stamped as just measured.");
+
+    device->Deactivate();
+    driver.Cleanup();
+    capture.close();
+    std::remove(path.c_str());
+}
+
+/**
+ * Makes sure Activate() gives up at the startup deadline when the display
+ * never starts up, rather than waiting on it forever.
+ */
+void runStartupTimeout()
+{
+    std::cout << "Startup timeout:" << std::endl;
+
+    auto& server = FakeServer::instance();
+    server.reset();
+    server.setStartupUpdates(0, 1000000);
+
+    FakeServerDriverHost host;
+    host.getFakeSettings().set("startupTimeout", "0.05");
+
+    ServerDriver_OSVR driver;
+    check(vr::VRInitError_None == driver.Init(nullptr, &host, "", ""), "Init() should succeed.");
+    auto device = driver.GetTrackedDeviceDriver(0);
+    const auto start = std::chrono::steady_clock::now();
+    const auto activate_error = device->Activate(0);
+    const double activate_time = secondsSince(start);
+    const auto updates = server.getUpdateCount();
+    check(vr::VRInitError_Driver_Failed == activate_error, "Activate() should fail when the display never starts up.");
+    check(activate_time >= 0.05 && activate_time < 0.5, "Activate() should give up at the deadline.");
+    check(updates < 100, "Activate() should back off rather than spin.");
+    check(contains(debugRequest(device, "startup"), "(timed out)"), "startup should show which phase timed out.");
+    std::cout << " - Gave up after " << activate_time * 1e3 << " ms and " << updates << " updates." << std::endl;
+
+    driver.Cleanup();
+    server.reset();
+}
+
+/**
+ * Has the client driver build its hidden area meshes from the display
+ * descriptor, once the server has started up and has one.
+ */
+void runClientDriver()
+{
+    std::cout << "Client driver:" << std::endl;
+
+    auto& server = FakeServer::instance();
+    server.reset();
+    server.setStartupUpdates(1000000, 0);
+
+    FakeClientDriverHost host;
+    host.getFakeSettings().set("hiddenAreaMaxTriangles", "100");
+
+    // Waiting on a server that's down shouldn't stall every request.
+    {
+        ClientDriver_OSVR driver;
+        check(vr::VRInitError_None == driver.Init(nullptr, &host, "", ""), "The client driver's Init() should succeed.");
+        const auto timed_out = driver.GetHiddenAreaMesh(vr::Eye_Left);
+        check(nullptr == timed_out.pVertexData && 0 == timed_out.unTriangleCount, "A server that never starts up should give no mesh.");
+        const auto start = std::chrono::steady_clock::now();
+        const auto waiting = driver.GetHiddenAreaMesh(vr::Eye_Right);
+        check(nullptr == waiting.pVertexData && secondsSince(start) < 0.1, "The server shouldn't be asked again right after a timeout.");
+        driver.Cleanup();
+    }
+
+    // Nor should a descriptor that can't be understood be read twice.
+    {
+        server.setStartupUpdates(0, 0);
+        server.setStringParameter("/display", "{ not json");
+        ClientDriver_OSVR driver;
+        check(vr::VRInitError_None == driver.Init(nullptr, &host, "", ""), "The client driver's Init() should succeed.");
+        const auto unparseable = driver.GetHiddenAreaMesh(vr::Eye_Left);
+        check(nullptr == unparseable.pVertexData && 0 == unparseable.unTriangleCount, "An unparseable descriptor should give no mesh.");
+        host.getFakeSettings().set("hiddenAreaRetryInterval", "0");
+        server.setStartupUpdates(1000000, 0);
+        const auto start = std::chrono::steady_clock::now();
+        const auto again = driver.GetHiddenAreaMesh(vr::Eye_Left);
+        check(nullptr == again.pVertexData && secondsSince(start) < 0.1, "An unparseable descriptor should be final, not read again.");
+        driver.Cleanup();
+    }
+
+    server.reset();
+    server.setStartupUpdates(1000000, 0);
+    host.getFakeSettings().set("hiddenAreaRetryInterval", "0");
+
+    ClientDriver_OSVR driver;
+    check(vr::VRInitError_None == driver.Init(nullptr, &host, "", ""), "The client driver's Init() should succeed.");
+
+    const auto timed_out = driver.GetHiddenAreaMesh(vr::Eye_Left);
+    check(nullptr == timed_out.pVertexData && 0 == timed_out.unTriangleCount, "A server that never starts up should give no mesh.");
+
+    server.setStartupUpdates(0, 0);
+    const auto missing = driver.GetHiddenAreaMesh(vr::Eye_Left);
+    check(nullptr == missing.pVertexData && 0 == missing.unTriangleCount, "A server with no display descriptor should give no mesh.");
+
+    // Neither failure should have been kept
+    server.setStringParameter("/display", HiddenCornersDescriptor);
+    const auto start = std::chrono::steady_clock::now();
+    const auto left = driver.GetHiddenAreaMesh(vr::Eye_Left);
+    const double build_time = secondsSince(start);
+    const auto right = driver.GetHiddenAreaMesh(vr::Eye_Right);
+    check(nullptr != left.pVertexData && left.unTriangleCount > 0 && nullptr != right.pVertexData && right.unTriangleCount > 0, "Each eye should get a hidden area mesh.");
+    check(left.unTriangleCount <= 100 && right.unTriangleCount <= 100, "The meshes should stay within the triangle budget.");
+    check(driver.GetHiddenAreaMesh(vr::Eye_Left).pVertexData == left.pVertexData, "The meshes should be built once and kept.");
+    std::cout << " - Hidden area meshes of " << left.unTriangleCount << " and " << right.unTriangleCount << " triangles took " << build_time * 1e3 << " ms." << std::endl;
+
+    driver.Cleanup();
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const std::size_t num_poses = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    if (num_poses < 2) {
+        std::cerr << "! At least two poses are needed." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    run("frame", num_poses);
+    run("thread", num_poses);
+    runDebugRequests();
+    runVelocityReports();
+    runPoseAtTime();
+    runReplay();
+    runStartupTimeout();
+    runClientDriver();
+
+    return finishChecks("Driver ran headless");
+}
@@ -25,14 +25,21 @@
 // Internal Includes
 #include "osvr_compiler_detection.h"    // for OSVR_OVERRIDE
 #include "ServerDriver_OSVR.h"          // for ServerDriver_OSVR
+#include "OSVRTrackedDevice.h"          // for OSVRTrackedDevice
 #include "driver_osvr.h"                // for factories
+#include "fake/FakeServerDriverHost.h"  // for osvr::fake::FakeServerDriverHost
+#include "recording/PoseCapture.h"      // for osvr::recording::PoseCapture
+#include "recording/PoseReplay.h"       // for osvr::recording::PoseReplay
 
 // Library/third-party includes
 #include <openvr_driver.h>              // for vr::IDriverLog
 
 // Standard includes
-#include <cstdlib> // for EXIT_SUCCESS
+#include <chrono>
+#include <cmath>   // for std::isfinite
+#include <cstdlib> // for EXIT_SUCCESS, std::strtod
 #include <iostream>
+#include <string>
 
 /**
  * Log messages to the console by default.
@@ -50,8 +57,58 @@ public:
     }
 };
 
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [options]\n\n"
+              << "Options:\n"
+              << "  --set <key>=<value>  Driver setting, e.g. --set poseFilters=oneEuro\n"
+              << "  --replay <capture>   Feed a recorded pose capture into the first device\n"
+              << "                       instead of waiting for the OSVR server\n"
+              << "  --speed <factor>     Replay speed relative to the original timing (default 1)\n"
+              << "  --fast               Replay as fast as possible, stamping reports as they're\n"
+              << "                       delivered rather than with their captured spacing" << std::endl;
+}
+
+void replayCallback(void* userdata, const OSVR_TimeValue* timestamp, const OSVR_PoseReport* report)
+{
+    static_cast<OSVRTrackedDevice*>(userdata)->InjectPoseReport(*timestamp, *report);
+}
+
 int main(int argc, char* argv[])
 {
+    osvr::fake::FakeServerDriverHost host;
+    std::string replay_path;
+    double replay_speed = 1.0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if ("--set" == arg && has_value) {
+            const std::string setting = argv[++i];
+            const auto equals = setting.find('=');
+            if (std::string::npos == equals) {
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            host.getFakeSettings().set(setting.substr(0, equals), setting.substr(equals + 1));
+        } else if ("--replay" == arg && has_value) {
+            replay_path = argv[++i];
+        } else if ("--speed" == arg && has_value) {
+            const char* value = argv[++i];
+            char* end = nullptr;
+            replay_speed = std::strtod(value, &end);
+            if (end == value || *end != '\0' || !(replay_speed > 0.0) || !std::isfinite(replay_speed)) {
+                std::cerr << "! Invalid replay speed: " << value << std::endl;
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        } else if ("--fast" == arg) {
+            replay_speed = osvr::recording::PoseReplay::AsFastAsPossible;
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
     // Instantiate the tracker driver
     std::cout << "Instantiating tracker driver..." << std::endl;
     int driver_init_return = 0;
@@ -78,7 +135,7 @@ int main(int argc, char* argv[])
 
     // Initialize the tracker driver
     std::cout << "Initializing the tracker driver..." << std::endl;
-    vr::EVRInitError error = tracker_driver->Init(&logger, nullptr, "", "");
+    vr::EVRInitError error = tracker_driver->Init(&logger, &host, "", "");
     if (vr::VRInitError_None != error) {
         std::cerr << "! Error initializing tracker driver: " << error << "." << std::endl;
         tracker_driver->Cleanup();
@@ -98,6 +155,40 @@ int main(int argc, char* argv[])
     // Grab first tracker
     std::cout << "Acquiring first detected tracker..." << std::endl;
     vr::ITrackedDeviceServerDriver* tracker = tracker_driver->GetTrackedDeviceDriver(0);
+    if (!tracker) {
+        std::cerr << "! Unable to acquire the first tracker." << std::endl;
+        tracker_driver->Cleanup();
+        return EXIT_FAILURE;
+    }
+
+    if (!replay_path.empty()) {
+        osvr::recording::PoseCapture capture;
+        if (!capture.open(replay_path)) {
+            std::cerr << "! Error opening pose capture: " << capture.getError() << std::endl;
+            tracker_driver->Cleanup();
+            return EXIT_FAILURE;
+        }
+
+        osvr::recording::PoseReplay replay(capture);
+        replay.setSpeed(replay_speed);
+        std::cout << "Replaying " << capture.size() << " pose reports ";
+        if (replay_speed > osvr::recording::PoseReplay::AsFastAsPossible) {
+            std::cout << "at " << replay_speed << "x speed..." << std::endl;
+        } else {
+            std::cout << "as fast as possible..." << std::endl;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto delivered = replay.run(&replayCallback, static_cast<OSVRTrackedDevice*>(tracker));
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << " - Delivered " << delivered << " reports in " << elapsed << " s";
+        if (elapsed > 0.0 && delivered > 0) {
+            std::cout << " (" << delivered / elapsed << " reports/s, " << elapsed / delivered * 1e9 << " ns/report)";
+        }
+        std::cout << "." << std::endl;
+        std::cout << " - Host received " << host.getPoseCount() << " pose updates." << std::endl;
+    }
 
     tracker_driver->Cleanup();
 
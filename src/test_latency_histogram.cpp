@@ -0,0 +1,142 @@
+/** @file
+    @brief Checks LatencyHistogram's bucket layout and the quantiles it
+    reports for known distributions.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "LatencyHistogram.h"
+#include "TestCheck.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>                        // for std::abs
+#include <cstddef>                      // for std::size_t
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+/**
+ * Whether a quantile is within half a bucket of @p expected seconds, which
+ * is never more than 1/32 of it.
+ */
+bool nearQuantile(double actual, double expected)
+{
+    return std::abs(actual - expected) <= expected / 32.0;
+}
+
+void checkBuckets()
+{
+    const std::size_t last = LatencyHistogram::BucketCount - 1;
+    bool round_trip = true;
+    bool contiguous = true;
+    bool narrow = true;
+    for (std::size_t bucket = 0; bucket <= last; ++bucket) {
+        const uint64_t lower = LatencyHistogram::getBucketLowerBound(bucket);
+        const uint64_t width = LatencyHistogram::getBucketWidth(bucket);
+        round_trip = round_trip && bucket == LatencyHistogram::getBucket(lower);
+        round_trip = round_trip && bucket == LatencyHistogram::getBucket(lower + width - 1);
+        if (bucket < last) {
+            contiguous = contiguous && LatencyHistogram::getBucketLowerBound(bucket + 1) == lower + width;
+        }
+        if (bucket >= 2 * LatencyHistogram::SubBucketCount) {
+            narrow = narrow && width * LatencyHistogram::SubBucketCount <= lower;
+        }
+    }
+    check(round_trip, "Each bucket's lowest and highest latencies should map back to it.");
+    check(contiguous, "Each bucket should start where the one before it ends.");
+    check(narrow, "No bucket should be wider than 1/16 of its lower bound.");
+
+    // Below 32 ns every nanosecond has its own bucket.
+    check(0 == LatencyHistogram::getBucket(0) && 31 == LatencyHistogram::getBucket(31), "Short latencies should be counted exactly.");
+
+    const uint64_t overflow = uint64_t(1) << (LatencyHistogram::MaxExponent + 1);
+    check(last == LatencyHistogram::getBucket(overflow - 1), "The longest latency that fits should be in the last bucket.");
+    check(last == LatencyHistogram::getBucket(overflow), "Latencies that don't fit should land in the last bucket.");
+    check(last == LatencyHistogram::getBucket(std::numeric_limits<uint64_t>::max()), "The longest possible latency should land in the last bucket.");
+}
+
+void checkUniform()
+{
+    // 1 us to 1 ms, one sample each microsecond
+    LatencyHistogram histogram;
+    check(0.0 == histogram.getQuantile(0.5), "An empty histogram should report zero.");
+    for (int i = 1; i <= 1000; ++i) {
+        histogram.record(i * 1e-6);
+    }
+
+    const auto summary = histogram.getSummary();
+    check(1000 == summary.count, "Every sample should be counted.");
+    check(std::abs(summary.mean - 500.5e-6) <= 1e-9, "The mean should be exact to the nanosecond.");
+    check(std::abs(summary.max - 1e-3) <= 1e-9, "The maximum should be exact to the nanosecond.");
+    check(nearQuantile(summary.p50, 500e-6), "The median should be within half a bucket.");
+    check(nearQuantile(summary.p99, 990e-6), "The 99th percentile should be within half a bucket.");
+    check(nearQuantile(summary.p999, 999e-6), "The 99.9th percentile should be within half a bucket.");
+    check(summary.p999 <= summary.max, "No quantile should exceed the maximum.");
+    check(nearQuantile(histogram.getQuantile(0.0), 1e-6), "The lowest quantile should be the smallest sample.");
+    std::cout << " - Uniform 1 us to 1 ms: p50 " << summary.p50 * 1e6 << " us, p99 " << summary.p99 * 1e6 << " us, p999 " << summary.p999 * 1e6 << " us." << std::endl;
+}
+
+void checkOverflow()
+{
+    // Mostly 2 ms, with two samples of an hour: longer than the buckets go.
+    LatencyHistogram histogram;
+    for (int i = 0; i < 998; ++i) {
+        histogram.record(2e-3);
+    }
+    histogram.record(3600.0);
+    histogram.record(3600.0);
+
+    const auto summary = histogram.getSummary();
+    check(nearQuantile(summary.p50, 2e-3) && nearQuantile(summary.p99, 2e-3), "Outliers shouldn't move the lower quantiles.");
+    check(std::abs(summary.p999 - 3600.0) < 1e-6, "A quantile in the last bucket should be the longest latency seen.");
+    check(std::abs(summary.max - 3600.0) < 1e-6, "The maximum should be exact past the last bucket.");
+}
+
+void checkResetAndNegative()
+{
+    LatencyHistogram histogram;
+    histogram.record(-1e-3);
+    check(1 == histogram.getCount() && 0.0 == histogram.getQuantile(1.0), "A negative latency should count as zero.");
+
+    histogram.record(5e-3);
+    histogram.reset();
+    check(0 == histogram.getCount() && 0.0 == histogram.getSummary().max, "Resetting should clear every count.");
+    histogram.record(1e-3);
+    check(1 == histogram.getCount() && nearQuantile(histogram.getQuantile(0.5), 1e-3), "Samples after a reset should be counted afresh.");
+}
+
+} // end anonymous namespace
+
+int main()
+{
+    checkBuckets();
+    checkUniform();
+    checkOverflow();
+    checkResetAndNegative();
+
+    return finishChecks("Latency histogram");
+}
@@ -0,0 +1,234 @@
+/** @file
+    @brief Checks how each pose filter responds to known motion: the One Euro
+    cutoff rising with speed, exponential convergence, the Kalman filter
+    tracking constant velocity, and reset().
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseFilter.h"
+#include "TestCheck.h"
+
+// Library/third-party includes
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <algorithm>                    // for std::max
+#include <cmath>                        // for std::abs, std::sqrt
+#include <iostream>
+#include <memory>                       // for std::unique_ptr
+#include <string>
+
+namespace {
+
+const double Pi = 3.14159265358979323846;
+
+/// Reports arrive at 1 kHz
+const double Interval = 0.001;
+
+Eigen::Quaterniond yaw(double angle)
+{
+    return Eigen::Quaterniond(Eigen::AngleAxisd(angle, Eigen::Vector3d::UnitZ()));
+}
+
+/**
+ * Runs @p filter over @p count reports of steady motion at @p speed m/s along
+ * X and @p rate rad/s about Z, and returns how far the last output trails
+ * the last report, in meters and radians.
+ */
+void steadyLag(PoseFilter& filter, int count, double speed, double rate, double& position_lag, double& angle_lag)
+{
+    Eigen::Vector3d position;
+    Eigen::Quaterniond orientation;
+    for (int i = 0; i < count; ++i) {
+        const double time = i * Interval;
+        position = Eigen::Vector3d(speed * time, 0.0, 0.0);
+        orientation = yaw(rate * time);
+        filter.filter(Interval, position, orientation);
+    }
+    const double time = (count - 1) * Interval;
+    position_lag = speed * time - position.x();
+    angle_lag = orientation.angularDistance(yaw(rate * time));
+}
+
+void checkOneEuro()
+{
+    // On a ramp an exponential smoother with time constant tau trails the
+    // input by speed * tau. The One Euro filter picks tau from a cutoff of
+    // minCutoff + beta * speed, where the speed is measured from the last
+    // output, so it includes the lag: solving
+    //   lag = speed / (2 pi (minCutoff + beta (speed + lag / dt)))
+    // for the lag gives the quadratic below.
+    OneEuroFilter filter;
+    check(filter.setParameter("minCutoff", 1.0) && filter.setParameter("beta", 20.0), "The One Euro parameters should be settable by name.");
+    const auto expected_lag = [](double speed) {
+        const double a = 2.0 * Pi * 20.0 / Interval;
+        const double b = 2.0 * Pi * (1.0 + 20.0 * speed);
+        return (std::sqrt(b * b + 4.0 * a * speed) - b) / (2.0 * a);
+    };
+
+    double slow_lag = 0.0, slow_angle_lag = 0.0;
+    steadyLag(filter, 10000, 0.01, 0.01, slow_lag, slow_angle_lag);
+    check(std::abs(slow_lag - expected_lag(0.01)) < 1e-6, "Slow motion should lag by what its cutoff gives.");
+    check(std::abs(slow_angle_lag - expected_lag(0.01)) < 1e-6, "Slow turning should lag by what its cutoff gives.");
+
+    filter.reset();
+    double fast_lag = 0.0, fast_angle_lag = 0.0;
+    steadyLag(filter, 10000, 1.0, 1.0, fast_lag, fast_angle_lag);
+    check(std::abs(fast_lag - expected_lag(1.0)) < 1e-6, "Fast motion should raise the cutoff by beta times the speed.");
+    check(std::abs(fast_angle_lag - expected_lag(1.0)) < 1e-6, "Fast turning should raise the cutoff by beta times the rate.");
+
+    // A hundred times the speed with only about ten times the lag
+    check(fast_lag < 20.0 * slow_lag, "Faster motion should lag less for its speed.");
+    std::cout << " - One Euro lag " << slow_lag * 1e3 << " mm at 1 cm/s, " << fast_lag * 1e3 << " mm at 1 m/s." << std::endl;
+
+    // Standing still with 1 mm of jitter
+    filter.reset();
+    double largest = 0.0;
+    for (int i = 0; i < 2000; ++i) {
+        Eigen::Vector3d position((i % 2) ? 0.001 : -0.001, 0.0, 0.0);
+        Eigen::Quaterniond orientation = Eigen::Quaterniond::Identity();
+        filter.filter(Interval, position, orientation);
+        if (i >= 1000)
+            largest = std::max(largest, std::abs(position.x()));
+    }
+    check(largest < 0.0002, "Jitter while still should be smoothed away.");
+}
+
+void checkExponential()
+{
+    ExponentialFilter filter;
+    check(filter.setParameter("alpha", 0.25), "The exponential alpha should be settable by name.");
+
+    Eigen::Vector3d position = Eigen::Vector3d::Zero();
+    Eigen::Quaterniond orientation = yaw(0.0);
+    filter.filter(Interval, position, orientation);
+
+    // Stepping to 1 m and a quarter turn: each report closes a quarter of
+    // the remaining gap.
+    double remaining = 1.0;
+    bool converging = true;
+    for (int i = 0; i < 20; ++i) {
+        position = Eigen::Vector3d(1.0, 0.0, 0.0);
+        orientation = yaw(Pi / 2);
+        filter.filter(Interval, position, orientation);
+        remaining *= 0.75;
+        converging = converging && std::abs(position.x() - (1.0 - remaining)) < 1e-9;
+        converging = converging && std::abs(orientation.angularDistance(yaw(Pi / 2)) - remaining * Pi / 2) < 1e-9;
+    }
+    check(converging, "Each report should close alpha of the remaining gap.");
+
+    filter.setParameter("alpha", 5.0);
+    check(1.0 == filter.getParameter(0), "Alpha should be limited to 1.");
+    filter.setParameter("alpha", 0.0);
+    check(filter.getParameter(0) > 0.0, "Alpha should stay above 0 so outputs still move.");
+}
+
+void checkKalman()
+{
+    // A constant-velocity model should track steady motion with no lag once
+    // the velocity has been learned.
+    KalmanFilter filter;
+    double position_lag = 0.0, angle_lag = 0.0;
+    steadyLag(filter, 2000, 1.0, 2.0, position_lag, angle_lag);
+    check(std::abs(position_lag) < 1e-6, "Steady motion should be tracked without lag.");
+    check(angle_lag < 1e-6, "Steady turning should be tracked without lag.");
+
+    // Starting over from a different place and speed
+    filter.reset();
+    steadyLag(filter, 2000, -0.5, -1.0, position_lag, angle_lag);
+    check(std::abs(position_lag) < 1e-6 && angle_lag < 1e-6, "After reset() a new speed should be learned from scratch.");
+
+    // Noisy measurements of a still pose should be smoothed.
+    filter.setParameter("positionMeasurementNoise", 1e-4);
+    filter.reset();
+    double largest = 0.0;
+    for (int i = 0; i < 2000; ++i) {
+        Eigen::Vector3d position((i % 2) ? 0.001 : -0.001, 0.0, 0.0);
+        Eigen::Quaterniond orientation = Eigen::Quaterniond::Identity();
+        filter.filter(Interval, position, orientation);
+        if (i >= 1000)
+            largest = std::max(largest, std::abs(position.x()));
+    }
+    check(largest < 0.0005, "Measurement noise should be smoothed.");
+}
+
+void checkReset()
+{
+    const char* const names[] = { "oneEuro", "exponential", "kalman" };
+    for (const auto name : names) {
+        std::unique_ptr<PoseFilter> filter = makePoseFilter(name);
+        check(filter && std::string(name) == filter->getName(), std::string("The ") + name + " filter should be made by name.");
+        if (!filter)
+            continue;
+
+        Eigen::Vector3d position = Eigen::Vector3d::Zero();
+        Eigen::Quaterniond orientation = yaw(0.0);
+        filter->filter(Interval, position, orientation);
+        position = Eigen::Vector3d(1.0, 0.0, 0.0);
+        orientation = yaw(1.0);
+        filter->filter(Interval, position, orientation);
+        check(position.x() < 1.0, std::string("The ") + name + " filter should smooth a jump.");
+
+        filter->reset();
+        position = Eigen::Vector3d(5.0, -2.0, 3.0);
+        orientation = yaw(2.0);
+        filter->filter(Interval, position, orientation);
+        check(position == Eigen::Vector3d(5.0, -2.0, 3.0) && orientation.angularDistance(yaw(2.0)) < 1e-12, std::string("The first pose after resetting the ") + name + " filter should pass through.");
+    }
+    check(!makePoseFilter("median"), "Unknown filters shouldn't be made.");
+}
+
+void checkChain()
+{
+    PoseFilterChain chain;
+    check("median" == chain.setStages(" oneEuro, median ,kalman"), "Unknown stage names should be reported.");
+    check(2 == chain.size() && chain.findStage("kalman") && !chain.findStage("exponential"), "Known stages should be kept in order.");
+
+    Eigen::Vector3d position = Eigen::Vector3d::Zero();
+    Eigen::Quaterniond orientation = yaw(0.0);
+    chain.filter(1.0, position, orientation);
+    position = Eigen::Vector3d(1.0, 0.0, 0.0);
+    chain.filter(1.001, position, orientation);
+    check(position.x() < 1.0, "Reports close together should be filtered.");
+
+    // After a gap in tracking the next pose starts over.
+    position = Eigen::Vector3d(2.0, 0.0, 0.0);
+    chain.filter(2.0, position, orientation);
+    check(2.0 == position.x(), "A gap in tracking should restart every stage.");
+    position = Eigen::Vector3d(3.0, 0.0, 0.0);
+    chain.filter(1.5, position, orientation);
+    check(3.0 == position.x(), "A report out of order should restart every stage.");
+}
+
+} // end anonymous namespace
+
+int main()
+{
+    checkOneEuro();
+    checkExponential();
+    checkKalman();
+    checkReset();
+    checkChain();
+
+    return finishChecks("Pose filters");
+}
@@ -0,0 +1,144 @@
+/** @file
+    @brief Multi-threaded stress test for handing poses from the tracker
+    callback thread to GetPose().
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TripleBuffer.h"
+
+// Library/third-party includes
+#include <openvr_driver.h>              // for vr::DriverPose_t
+
+// Standard includes
+#include <atomic>
+#include <cstdlib>                      // for EXIT_SUCCESS, std::strtoull
+#include <iostream>
+#include <thread>
+
+namespace {
+
+/**
+ * Fills every numeric field of the pose with the same value so that a reader
+ * can detect a pose assembled from two different writes.
+ */
+vr::DriverPose_t makePose(double value)
+{
+    vr::DriverPose_t pose = {};
+    pose.poseTimeOffset = value;
+    pose.qWorldFromDriverRotation = { value, value, value, value };
+    pose.qDriverFromHeadRotation = { value, value, value, value };
+    pose.qRotation = { value, value, value, value };
+    for (int i = 0; i < 3; ++i) {
+        pose.vecWorldFromDriverTranslation[i] = value;
+        pose.vecDriverFromHeadTranslation[i] = value;
+        pose.vecPosition[i] = value;
+        pose.vecVelocity[i] = value;
+        pose.vecAcceleration[i] = value;
+        pose.vecAngularVelocity[i] = value;
+        pose.vecAngularAcceleration[i] = value;
+    }
+    return pose;
+}
+
+/**
+ * Returns true if every numeric field of the pose holds the same value.
+ */
+bool isConsistent(const vr::DriverPose_t& pose)
+{
+    const double value = pose.poseTimeOffset;
+    const auto quat_ok = [value](const vr::HmdQuaternion_t& q) {
+        return q.w == value && q.x == value && q.y == value && q.z == value;
+    };
+    if (!quat_ok(pose.qWorldFromDriverRotation) || !quat_ok(pose.qDriverFromHeadRotation) || !quat_ok(pose.qRotation))
+        return false;
+
+    for (int i = 0; i < 3; ++i) {
+        if (pose.vecWorldFromDriverTranslation[i] != value) return false;
+        if (pose.vecDriverFromHeadTranslation[i] != value) return false;
+        if (pose.vecPosition[i] != value) return false;
+        if (pose.vecVelocity[i] != value) return false;
+        if (pose.vecAcceleration[i] != value) return false;
+        if (pose.vecAngularVelocity[i] != value) return false;
+        if (pose.vecAngularAcceleration[i] != value) return false;
+    }
+
+    return true;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const uint64_t num_poses = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+
+    TripleBuffer<vr::DriverPose_t> slot(makePose(0.0));
+    std::atomic<bool> done(false);
+
+    std::cout << "Publishing " << num_poses << " poses..." << std::endl;
+
+    // Plays the part of HmdTrackerCallback.
+    std::thread writer([&]() {
+        for (uint64_t i = 1; i <= num_poses; ++i) {
+            slot.publish(makePose(static_cast<double>(i)));
+        }
+        done = true;
+    });
+
+    // Plays the part of GetPose().
+    uint64_t reads = 0;
+    uint64_t torn = 0;
+    uint64_t went_backwards = 0;
+    double last_value = 0.0;
+    while (true) {
+        const bool writer_finished = done;
+        const vr::DriverPose_t pose = slot.read();
+        ++reads;
+
+        if (!isConsistent(pose)) {
+            ++torn;
+        } else if (pose.poseTimeOffset < last_value) {
+            ++went_backwards;
+        }
+        last_value = pose.poseTimeOffset;
+
+        // One last read after the writer is finished must see the final pose.
+        if (writer_finished)
+            break;
+    }
+    writer.join();
+
+    std::cout << " - " << reads << " reads, " << torn << " torn poses, " << went_backwards << " stale poses." << std::endl;
+
+    if (torn != 0 || went_backwards != 0) {
+        std::cerr << "! Pose handoff is not consistent." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (last_value != static_cast<double>(num_poses)) {
+        std::cerr << "! Final read returned pose " << last_value << " instead of " << num_poses << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << " - Pose handoff is consistent." << std::endl;
+    return EXIT_SUCCESS;
+}
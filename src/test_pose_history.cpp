@@ -0,0 +1,186 @@
+/** @file
+    @brief Checks the poses PoseHistory interpolates and extrapolates, and
+    that queries racing the writer never see a torn pose.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "PoseHistory.h"
+#include "TestCheck.h"
+
+// Library/third-party includes
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <atomic>
+#include <cmath>                        // for std::abs
+#include <cstddef>                      // for std::size_t
+#include <iostream>
+#include <thread>
+
+namespace {
+
+const double Pi = 3.14159265358979323846;
+
+bool near(double actual, double expected, double tolerance = 1e-9)
+{
+    return std::abs(actual - expected) < tolerance;
+}
+
+bool near(const Eigen::Vector3d& actual, const Eigen::Vector3d& expected, double tolerance = 1e-9)
+{
+    return (actual - expected).norm() < tolerance;
+}
+
+Eigen::Quaterniond yaw(double angle)
+{
+    return Eigen::Quaterniond(Eigen::AngleAxisd(angle, Eigen::Vector3d::UnitZ()));
+}
+
+/**
+ * Angle of a rotation about Z.
+ */
+double yawOf(const Eigen::Quaterniond& orientation)
+{
+    const Eigen::AngleAxisd angle_axis(orientation);
+    return (angle_axis.axis().z() < 0.0) ? -angle_axis.angle() : angle_axis.angle();
+}
+
+void checkInterpolation()
+{
+    PoseHistory<8> history;
+    TimedPose pose;
+    check(!history.sample(1.0, pose), "An empty history should have no poses to sample.");
+    history.add(1.0, Eigen::Vector3d::Zero(), yaw(0.0));
+    check(!history.sample(1.0, pose), "One pose isn't enough to sample.");
+
+    // Moving 2 m/s along X and turning a quarter turn per second
+    history.add(2.0, Eigen::Vector3d(2.0, 0.0, 0.0), yaw(Pi / 2));
+    check(2 == history.size(), "The history should hold both poses.");
+
+    check(history.sample(1.5, pose), "A time between the poses should be answered.");
+    check(near(pose.time, 1.5), "The sampled pose should be for the time asked.");
+    check(near(pose.position, Eigen::Vector3d(1.0, 0.0, 0.0)), "The midpoint position should be halfway.");
+    check(near(yawOf(pose.orientation), Pi / 4), "The midpoint orientation should be halfway round.");
+    check(near(pose.linearVelocity, Eigen::Vector3d(2.0, 0.0, 0.0)), "The velocity should be that between the poses.");
+    check(near(pose.angularVelocity, Eigen::Vector3d(0.0, 0.0, Pi / 2)), "The angular velocity should be that between the poses.");
+
+    // Slerp turns at an even rate, where a normalized lerp would be off by
+    // about half a degree here.
+    check(history.sample(1.25, pose), "A time a quarter of the way along should be answered.");
+    check(near(yawOf(pose.orientation), Pi / 8, 1e-9), "Orientations should be spherically interpolated.");
+
+    check(history.sample(1.0, pose) && near(pose.position, Eigen::Vector3d::Zero()), "The oldest pose's own time should give that pose.");
+    check(history.sample(2.0, pose) && near(pose.position, Eigen::Vector3d(2.0, 0.0, 0.0)), "The newest pose's own time should give that pose.");
+    check(!history.sample(0.999, pose), "A time before the oldest pose should not be answered.");
+}
+
+void checkExtrapolation()
+{
+    PoseHistory<8> history;
+    history.add(1.0, Eigen::Vector3d::Zero(), yaw(0.0));
+    history.add(2.0, Eigen::Vector3d(2.0, 0.0, 0.0), yaw(Pi / 2));
+
+    TimedPose pose;
+    check(history.sample(2.02, pose, 0.05), "A time just past the newest pose should be answered.");
+    check(near(pose.time, 2.02) && near(pose.position, Eigen::Vector3d(2.04, 0.0, 0.0)), "Position should be extrapolated along the velocity.");
+    check(near(yawOf(pose.orientation), Pi / 2 + Pi / 2 * 0.02), "Orientation should be extrapolated along the angular velocity.");
+
+    check(history.sample(3.0, pose, 0.05), "A time well past the newest pose should still be answered.");
+    check(near(pose.time, 2.05), "Extrapolation should stop at the limit.");
+    check(near(pose.position, Eigen::Vector3d(2.1, 0.0, 0.0)), "Extrapolated position should stop at the limit.");
+    check(near(yawOf(pose.orientation), Pi / 2 + Pi / 2 * 0.05), "Extrapolated orientation should stop at the limit.");
+
+    check(history.sample(3.0, pose, 0.0) && near(pose.position, Eigen::Vector3d(2.0, 0.0, 0.0)), "No extrapolation allowed should give the newest pose.");
+}
+
+void checkWrapAround()
+{
+    PoseHistory<8> history;
+    for (int i = 0; i < 20; ++i) {
+        history.add(i, Eigen::Vector3d(i, 0.0, 0.0), yaw(0.0));
+    }
+    check(8 == history.size(), "A full history should hold its capacity.");
+
+    TimedPose pose;
+    check(history.get(0, pose) && near(pose.time, 19.0), "Age 0 should be the newest pose.");
+    check(history.get(7, pose) && near(pose.time, 12.0), "The oldest pose should be the one capacity - 1 back.");
+    check(!history.get(8, pose), "Poses past the capacity should be gone.");
+    check(history.sample(12.5, pose) && near(pose.position.x(), 12.5), "Times the history still covers should be answered.");
+    check(!history.sample(11.5, pose), "Times only overwritten poses covered should not be answered.");
+
+    history.clear();
+    check(0 == history.size() && !history.sample(19.0, pose), "Clearing should forget every pose.");
+}
+
+void checkConcurrentReads()
+{
+    // Each pose's position and orientation follow from its time, so any
+    // mixture of two poses' values shows up as a mismatch. A small ring
+    // makes the writer lap the reader often.
+    PoseHistory<4> history;
+    std::atomic<bool> done(false);
+    std::thread writer([&] {
+        for (int i = 0; i < 2000000; ++i) {
+            const double time = i * 0.001;
+            history.add(time, Eigen::Vector3d(time, -time, 2.0 * time), yaw(time));
+        }
+        done = true;
+    });
+
+    std::size_t answered = 0;
+    std::size_t unanswered = 0;
+    std::size_t torn = 0;
+    while (!done) {
+        TimedPose newest;
+        if (!history.get(0, newest))
+            continue;
+        if (!near(newest.position.x(), newest.time) || !near(newest.position.y(), -newest.time))
+            ++torn;
+
+        TimedPose pose;
+        if (!history.sample(newest.time - 0.0015, pose, 0.0)) {
+            ++unanswered;
+            continue;
+        }
+        ++answered;
+        if (!near(pose.position, Eigen::Vector3d(pose.time, -pose.time, 2.0 * pose.time), 1e-6) || pose.orientation.angularDistance(yaw(pose.time)) > 1e-6)
+            ++torn;
+    }
+    writer.join();
+
+    check(0 == torn, "Queries racing the writer should never see a torn pose.");
+    check(answered > 0, "Queries racing the writer should still be answered.");
+    std::cout << " - " << answered << " queries answered and " << unanswered << " given up while the writer ran." << std::endl;
+}
+
+} // end anonymous namespace
+
+int main()
+{
+    checkInterpolation();
+    checkExtrapolation();
+    checkWrapAround();
+    checkConcurrentReads();
+
+    return finishChecks("Pose history");
+}
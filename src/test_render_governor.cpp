@@ -0,0 +1,188 @@
+/** @file
+    @brief Replays frame-time traces against the render resolution governor,
+    simulating how the frame time follows the scale it picks.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "RenderResolutionGovernor.h"
+#include "TestCheck.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>                    // for std::min, std::max
+#include <cmath>                        // for std::sin
+#include <cstddef>                      // for std::size_t
+#include <cstdlib>                      // for EXIT_SUCCESS, EXIT_FAILURE
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double FrameTime = 1.0 / 90.0;
+
+/**
+ * What happened while replaying a trace.
+ */
+struct Replay {
+    std::size_t lateFrames = 0;
+    std::size_t lateFramesInLastQuarter = 0;
+    double minScale = 1.0;
+    double maxScale = 0.0;
+    double finalScale = 0.0;
+    uint64_t changes = 0;
+    uint64_t changesAfterHalf = 0;
+};
+
+/**
+ * Feeds the governor one frame per entry of @p trace, each the time the
+ * frame would take at full scale. Rendering is taken to be fill-bound, so a
+ * frame's time goes with the square of the scale in use.
+ */
+Replay replay(RenderResolutionGovernor& governor, const std::vector<double>& trace)
+{
+    Replay result;
+    uint64_t changes_at_half = 0;
+    for (std::size_t i = 0; i < trace.size(); ++i) {
+        const double scale = governor.getScale();
+        const double frame_time = trace[i] * scale * scale;
+        if (frame_time > FrameTime) {
+            ++result.lateFrames;
+            if (i >= trace.size() * 3 / 4)
+                ++result.lateFramesInLastQuarter;
+        }
+        governor.addFrameTime(frame_time);
+
+        result.minScale = std::min(result.minScale, governor.getScale());
+        result.maxScale = std::max(result.maxScale, governor.getScale());
+        if (i + 1 == trace.size() / 2)
+            changes_at_half = governor.getChangeCount();
+    }
+    result.finalScale = governor.getScale();
+    result.changes = governor.getChangeCount();
+    result.changesAfterHalf = result.changes - changes_at_half;
+    return result;
+}
+
+RenderResolutionGovernor makeGovernor()
+{
+    RenderResolutionGovernor governor;
+    governor.setTargetFrameTime(FrameTime);
+    governor.setBounds(0.5, 1.0);
+    return governor;
+}
+
+std::vector<double> steady(double milliseconds, std::size_t frames)
+{
+    return std::vector<double>(frames, milliseconds * 1e-3);
+}
+
+void print(const std::string& name, const Replay& result)
+{
+    std::cout << " - " << name << ": scale " << result.minScale << "-" << result.maxScale << ", ending at " << result.finalScale << ", "
+              << result.changes << " changes, " << result.lateFrames << " late frames." << std::endl;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    std::cout << "Render resolution governor:" << std::endl;
+
+    {
+        auto governor = makeGovernor();
+        const auto result = replay(governor, steady(6.0, 2000));
+        print("light load", result);
+        check(1.0 == result.minScale && 0 == result.changes, "A light load should keep the full scale.");
+    }
+
+    {
+        auto governor = makeGovernor();
+        const auto result = replay(governor, steady(16.0, 2000));
+        print("heavy load", result);
+        check(result.finalScale < 1.0 && result.finalScale >= 0.5, "A heavy load should scale down, within the bounds.");
+        check(0 == result.lateFramesInLastQuarter, "Once scaled down, frames should be on time.");
+        check(0 == result.changesAfterHalf, "A steady load should settle on one scale.");
+    }
+
+    {
+        // Just over budget at full scale, right where hunting would start
+        auto governor = makeGovernor();
+        const auto result = replay(governor, steady(11.5, 4000));
+        print("borderline load", result);
+        check(result.changes <= 2, "A load near the budget shouldn't make the scale hunt.");
+    }
+
+    {
+        auto governor = makeGovernor();
+        std::vector<double> trace = steady(6.0, 300);
+        const auto spike = steady(20.0, 300);
+        trace.insert(trace.end(), spike.begin(), spike.end());
+        const auto recovery = steady(6.0, 1500);
+        trace.insert(trace.end(), recovery.begin(), recovery.end());
+        const auto result = replay(governor, trace);
+        print("spike", result);
+        check(result.minScale < 0.8, "A heavy spike should scale down.");
+        check(1.0 == result.finalScale, "The scale should recover once the load is light again.");
+    }
+
+    {
+        auto governor = makeGovernor();
+        const auto result = replay(governor, steady(60.0, 1000));
+        print("overload", result);
+        check(0.5 == result.minScale && 0.5 == result.finalScale, "An impossible load should stop at the lower bound.");
+    }
+
+    {
+        // A scene whose cost swings slowly, with frame-to-frame jitter
+        auto governor = makeGovernor();
+        std::vector<double> trace;
+        for (std::size_t i = 0; i < 6000; ++i) {
+            trace.push_back((10.0 + 4.0 * std::sin(i * 0.002) + 0.5 * std::sin(i * 1.7)) * 1e-3);
+        }
+        const auto result = replay(governor, trace);
+        print("varying load", result);
+        check(result.lateFrames < trace.size() / 20, "Few frames should run late on a varying load.");
+        check(result.changes < 40, "The scale should follow a slow swing without hunting.");
+    }
+
+    // Replay a recorded trace too: one frame time per line, in milliseconds
+    // at full scale.
+    if (argc > 1) {
+        std::ifstream file(argv[1]);
+        std::vector<double> trace;
+        double milliseconds = 0.0;
+        while (file >> milliseconds) {
+            trace.push_back(milliseconds * 1e-3);
+        }
+        check(!trace.empty(), std::string("Unable to read a trace from ") + argv[1]);
+
+        auto governor = makeGovernor();
+        print(argv[1], replay(governor, trace));
+    }
+
+    return finishChecks("Render resolution governor");
+}
@@ -0,0 +1,131 @@
+/** @file
+    @brief Checks that StartupWait backs off between updates and keeps to its
+    deadline.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "StartupWait.h"
+#include "TestCheck.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstddef>                      // for std::size_t
+#include <cstdlib>                      // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using std::chrono::microseconds;
+using std::chrono::milliseconds;
+
+/**
+ * Stands in for a context that starts up after a number of updates.
+ */
+struct FakeStartup {
+    std::size_t updatesNeeded;
+    std::size_t updates = 0;
+    std::vector<StartupWait::clock::duration> sleeps;
+
+    explicit FakeStartup(std::size_t updates_needed) : updatesNeeded(updates_needed)
+    {
+        // do nothing
+    }
+
+    bool wait(StartupWait& startup, const char* name)
+    {
+        return startup.wait(name, [this] { return updates >= updatesNeeded; }, [this] { ++updates; },
+                            [this](StartupWait::clock::duration delay) { sleeps.push_back(delay); });
+    }
+};
+
+void checkImmediate()
+{
+    StartupWait startup(std::chrono::seconds(1));
+    FakeStartup context(0);
+    check(context.wait(startup, "context"), "Something already started should be ready.");
+    check(0 == context.updates && context.sleeps.empty(), "Something already started shouldn't be updated or slept on.");
+    check(1 == startup.getPhases().size() && startup.getPhases()[0].ready, "The phase should be recorded as ready.");
+}
+
+void checkBackoff()
+{
+    StartupWait startup(std::chrono::seconds(10), microseconds(50), milliseconds(2));
+    FakeStartup context(5);
+    FakeStartup display(20);
+    check(context.wait(startup, "context"), "The context should start up.");
+    check(display.wait(startup, "display"), "The display should start up.");
+
+    // No sleep after the update that finished the job
+    check(5 == context.updates && 4 == context.sleeps.size(), "The context should take five updates and four sleeps.");
+    bool doubling = true;
+    for (std::size_t i = 0; i < context.sleeps.size(); ++i) {
+        doubling = doubling && context.sleeps[i] == microseconds(50 << i);
+    }
+    check(doubling, "Sleeps should start short and double.");
+
+    bool capped = true;
+    for (const auto& delay : display.sleeps) {
+        capped = capped && delay <= milliseconds(2);
+    }
+    check(capped && display.sleeps.back() == milliseconds(2), "Sleeps should grow to the limit and stop there.");
+
+    const auto& phases = startup.getPhases();
+    check(2 == phases.size() && std::string("context") == phases[0].name && std::string("display") == phases[1].name, "Each phase should be recorded, in order.");
+    check(5 == phases[0].updates && 20 == phases[1].updates, "Each phase should count its updates.");
+}
+
+void checkDeadline()
+{
+    const auto timeout = milliseconds(50);
+    StartupWait startup(timeout);
+    std::size_t updates = 0;
+    const auto start = StartupWait::clock::now();
+    const bool ready = startup.wait("context", [] { return false; }, [&updates] { ++updates; });
+    const auto elapsed = StartupWait::clock::now() - start;
+
+    check(!ready && !startup.getPhases()[0].ready, "Something that never starts should time out.");
+    check(elapsed >= timeout, "The wait should last until the deadline.");
+    check(elapsed < timeout + milliseconds(100), "The wait shouldn't run much past the deadline.");
+    check(updates < 30, "Backing off should keep the updates few.");
+    std::cout << " - Timed out after " << std::chrono::duration<double>(elapsed).count() * 1e3 << " ms and " << updates << " updates." << std::endl;
+
+    // Later phases share the deadline
+    FakeStartup display(1);
+    check(!display.wait(startup, "display") && 0 == display.updates, "A phase started after the deadline should give up at once.");
+}
+
+} // end anonymous namespace
+
+int main()
+{
+    checkImmediate();
+    checkBackoff();
+    checkDeadline();
+
+    return finishChecks("Startup wait");
+}
@@ -0,0 +1,150 @@
+/** @file
+    @brief Checks the velocities VelocityEstimator derives from known motion.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TestCheck.h"
+#include "VelocityEstimator.h"
+
+// Library/third-party includes
+#include <Eigen/Geometry>
+
+// Standard includes
+#include <cmath>                        // for std::abs
+
+namespace {
+
+const double Interval = 0.01;
+
+bool near(const Eigen::Vector3d& actual, const Eigen::Vector3d& expected, double tolerance = 1e-9)
+{
+    return (actual - expected).norm() < tolerance;
+}
+
+Eigen::Quaterniond rotation(double angle, const Eigen::Vector3d& axis)
+{
+    return Eigen::Quaterniond(Eigen::AngleAxisd(angle, axis.normalized()));
+}
+
+void checkLinear()
+{
+    VelocityEstimator estimator(0.0);
+    const Eigen::Vector3d velocity(1.0, -2.0, 0.5);
+    estimator.addSample(0.0, Eigen::Vector3d::Zero(), Eigen::Quaterniond::Identity());
+    check(near(estimator.getLinearVelocity(), Eigen::Vector3d::Zero()), "One sample should give no velocity.");
+    for (int i = 1; i <= 5; ++i) {
+        estimator.addSample(i * Interval, velocity * (i * Interval), Eigen::Quaterniond::Identity());
+    }
+    check(near(estimator.getLinearVelocity(), velocity), "Steady motion should give its velocity.");
+    check(near(estimator.getAngularVelocity(), Eigen::Vector3d::Zero()), "Motion without turning should have no angular velocity.");
+}
+
+void checkAngular()
+{
+    // 2 rad/s about an oblique axis
+    const Eigen::Vector3d axis = Eigen::Vector3d(1.0, 2.0, -1.0).normalized();
+    const double rate = 2.0;
+    VelocityEstimator estimator(0.0);
+    for (int i = 0; i <= 5; ++i) {
+        estimator.addSample(i * Interval, Eigen::Vector3d::Zero(), rotation(rate * i * Interval, axis));
+    }
+    check(near(estimator.getAngularVelocity(), axis * rate, 1e-9), "Steady turning should give its angular velocity.");
+
+    // The same turn with the quaternion's sign flipped halfway through
+    // should still go the short way around.
+    VelocityEstimator flipped(0.0);
+    flipped.addSample(0.0, Eigen::Vector3d::Zero(), rotation(0.0, axis));
+    Eigen::Quaterniond negated = rotation(rate * Interval, axis);
+    negated.coeffs() = -negated.coeffs();
+    flipped.addSample(Interval, Eigen::Vector3d::Zero(), negated);
+    check(near(flipped.getAngularVelocity(), axis * rate, 1e-9), "Either sign of a quaternion should give the same angular velocity.");
+
+    // Turning through pi and beyond, a step at a time
+    VelocityEstimator spinning(0.0);
+    const Eigen::Vector3d z = Eigen::Vector3d::UnitZ();
+    for (int i = 0; i <= 200; ++i) {
+        spinning.addSample(i * Interval, Eigen::Vector3d::Zero(), rotation(3.0 * i * Interval, z));
+    }
+    check(near(spinning.getAngularVelocity(), z * 3.0, 1e-9), "Turning past half a revolution shouldn't flip the angular velocity.");
+}
+
+void checkSmoothing()
+{
+    // Still, then suddenly moving at 1 m/s: each sample closes half of the
+    // remaining gap.
+    VelocityEstimator estimator(0.5);
+    check(0.5 == estimator.getSmoothing(), "The smoothing should be what was asked for.");
+    estimator.addSample(0.0, Eigen::Vector3d::Zero(), Eigen::Quaterniond::Identity());
+    estimator.addSample(Interval, Eigen::Vector3d::Zero(), Eigen::Quaterniond::Identity());
+    double expected = 0.0;
+    for (int i = 1; i <= 4; ++i) {
+        estimator.addSample((i + 1) * Interval, Eigen::Vector3d::UnitX() * (i * Interval), Eigen::Quaterniond::Identity());
+        expected += 0.5 * (1.0 - expected);
+        check(std::abs(estimator.getLinearVelocity().x() - expected) < 1e-9, "Smoothing should move the estimate part of the way each sample.");
+    }
+
+    VelocityEstimator clamped(2.0);
+    check(clamped.getSmoothing() < 1.0, "Smoothing should stay below 1 so estimates still move.");
+}
+
+void checkTimestamps()
+{
+    VelocityEstimator estimator(0.0);
+    estimator.addSample(0.0, Eigen::Vector3d::Zero(), Eigen::Quaterniond::Identity());
+    estimator.addSample(Interval, Eigen::Vector3d::UnitX() * Interval, Eigen::Quaterniond::Identity());
+    const Eigen::Vector3d velocity = estimator.getLinearVelocity();
+
+    // A repeated timestamp, or one slightly out of order, is skipped
+    estimator.addSample(Interval, Eigen::Vector3d::UnitX() * 5.0, Eigen::Quaterniond::Identity());
+    check(near(estimator.getLinearVelocity(), velocity), "A repeated timestamp should be ignored.");
+    estimator.addSample(0.5 * Interval, Eigen::Vector3d::UnitX() * 5.0, Eigen::Quaterniond::Identity());
+    check(near(estimator.getLinearVelocity(), velocity), "A slightly older timestamp should be ignored.");
+
+    // ... and doesn't become the sample the next one is measured from
+    estimator.addSample(2.0 * Interval, Eigen::Vector3d::UnitX() * (2.0 * Interval), Eigen::Quaterniond::Identity());
+    check(near(estimator.getLinearVelocity(), velocity), "Ignored samples shouldn't affect later estimates.");
+
+    // A jump back in time, or a gap in tracking, starts over
+    estimator.addSample(-1.0, Eigen::Vector3d::Zero(), Eigen::Quaterniond::Identity());
+    check(near(estimator.getLinearVelocity(), Eigen::Vector3d::Zero()), "A jump back in time should start over.");
+    estimator.addSample(-1.0 + Interval, Eigen::Vector3d::UnitX() * Interval, Eigen::Quaterniond::Identity());
+    check(near(estimator.getLinearVelocity(), velocity), "Estimates should resume after starting over.");
+    estimator.addSample(0.0, Eigen::Vector3d::UnitX() * 2.0, Eigen::Quaterniond::Identity());
+    check(near(estimator.getLinearVelocity(), Eigen::Vector3d::Zero()), "A gap in tracking should start over.");
+
+    estimator.reset();
+    estimator.addSample(Interval, Eigen::Vector3d::UnitX() * 3.0, Eigen::Quaterniond::Identity());
+    check(near(estimator.getLinearVelocity(), Eigen::Vector3d::Zero()), "Resetting should forget the previous sample.");
+}
+
+} // end anonymous namespace
+
+int main()
+{
+    checkLinear();
+    checkAngular();
+    checkSmoothing();
+    checkTimestamps();
+
+    return finishChecks("Velocity estimator");
+}
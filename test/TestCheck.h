@@ -0,0 +1,79 @@
+/** @file
+    @brief The check() helper the test programs report failures with.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TestCheck_h_GUID_7373EBAC_8C25_465F_B684_515F93C0925E
+#define INCLUDED_TestCheck_h_GUID_7373EBAC_8C25_465F_B684_515F93C0925E
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdlib>          // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>
+#include <string>
+
+/**
+ * How many checks have failed so far in this test program.
+ */
+inline int& checkFailureCount()
+{
+    static int failures = 0;
+    return failures;
+}
+
+inline bool anyCheckFailed()
+{
+    return checkFailureCount() > 0;
+}
+
+/**
+ * Reports @p description, prefixed with "! ", if @p condition is false.
+ * The test carries on either way so that one run shows every failure.
+ */
+inline void check(bool condition, const std::string& description)
+{
+    if (!condition) {
+        std::cerr << "! " << description << std::endl;
+        ++checkFailureCount();
+    }
+}
+
+/**
+ * Ends a test program: prints "<name> OK." if every check passed. Returns
+ * the exit code for main().
+ */
+inline int finishChecks(const char* name)
+{
+    if (anyCheckFailed())
+        return EXIT_FAILURE;
+
+    std::cout << name << " OK." << std::endl;
+    return EXIT_SUCCESS;
+}
+
+#endif // INCLUDED_TestCheck_h_GUID_7373EBAC_8C25_465F_B684_515F93C0925E
@@ -0,0 +1,219 @@
+/** @file
+    @brief Synthetic EDID blobs, one per layout the decoder handles, for the
+    EDID tests and benchmark.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_EdidCorpus_h_GUID_FA358E9B_BED8_4920_8B78_4CECA321F4A8
+#define INCLUDED_EdidCorpus_h_GUID_FA358E9B_BED8_4920_8B78_4CECA321F4A8
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <cstring>          // for std::memcpy
+#include <string>
+#include <vector>
+
+namespace edid_corpus {
+
+/**
+ * Assembles an EDID blob: a base block plus any extension blocks, with their
+ * checksums filled in.
+ */
+class EdidBuilder {
+public:
+    EdidBuilder(const char manufacturer[3], uint16_t product) : blob_(128, 0)
+    {
+        static const uint8_t header[] = {0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00};
+        std::memcpy(blob_.data(), header, sizeof(header));
+
+        const uint32_t id = ((manufacturer[0] - 'A' + 1) << 10) | ((manufacturer[1] - 'A' + 1) << 5) | (manufacturer[2] - 'A' + 1);
+        blob_[8] = static_cast<uint8_t>(id >> 8);
+        blob_[9] = static_cast<uint8_t>(id & 0xff);
+        blob_[10] = static_cast<uint8_t>(product & 0xff);
+        blob_[11] = static_cast<uint8_t>(product >> 8);
+        blob_[18] = 1;
+        blob_[19] = 4;
+    }
+
+    /**
+     * Adds a detailed timing to the next free base block descriptor. The
+     * vertical sizes of an interlaced timing are those of one field.
+     */
+    EdidBuilder& timing(uint32_t pixel_clock_10khz, uint32_t h_active, uint32_t h_blank, uint32_t v_active, uint32_t v_blank, bool interlaced = false)
+    {
+        uint8_t* descriptor = nextDescriptor();
+        writeDetailedTiming(descriptor, pixel_clock_10khz, h_active, h_blank, v_active, v_blank);
+        descriptor[17] = interlaced ? 0x80 : 0x00;
+        return *this;
+    }
+
+    /**
+     * Adds a monitor name descriptor to the next free base block descriptor.
+     */
+    EdidBuilder& name(const std::string& name)
+    {
+        uint8_t* descriptor = nextDescriptor();
+        descriptor[3] = 0xfc;
+        std::string text = name.substr(0, 13);
+        if (text.size() < 13)
+            text += '\n';
+        text.resize(13, ' ');
+        std::memcpy(descriptor + 5, text.data(), 13);
+        return *this;
+    }
+
+    /**
+     * Adds a CTA-861 extension holding just detailed timings, each given as
+     * {clock in 10 kHz, h active, h blank, v active, v blank}.
+     */
+    EdidBuilder& cta(const std::vector<std::vector<uint32_t>>& timings)
+    {
+        uint8_t* block = addExtension(0x02);
+        block[1] = 3;
+        block[2] = 4;
+        for (std::size_t i = 0; i < timings.size(); ++i) {
+            const auto& t = timings[i];
+            writeDetailedTiming(block + 4 + 18 * i, t[0], t[1], t[2], t[3], t[4]);
+        }
+        return *this;
+    }
+
+    /**
+     * Adds a DisplayID extension holding one timing data block: type I
+     * (clock in 10 kHz) or type VII (clock in kHz).
+     */
+    EdidBuilder& displayId(bool type_vii, uint32_t pixel_clock, uint32_t h_active, uint32_t h_blank, uint32_t v_active, uint32_t v_blank, bool preferred)
+    {
+        uint8_t* block = addExtension(0x70);
+        block[1] = type_vii ? 0x20 : 0x12;
+        block[2] = 3 + 20;
+        block[3] = 3; // HMD
+
+        uint8_t* data_block = block + 5;
+        data_block[0] = type_vii ? 0x22 : 0x03;
+        data_block[2] = 20;
+        uint8_t* t = data_block + 3;
+        writeLittleEndian(t, pixel_clock - 1, 3);
+        t[3] = preferred ? 0x80 : 0x00;
+        writeLittleEndian(t + 4, h_active - 1, 2);
+        writeLittleEndian(t + 6, h_blank - 1, 2);
+        writeLittleEndian(t + 12, v_active - 1, 2);
+        writeLittleEndian(t + 14, v_blank - 1, 2);
+        return *this;
+    }
+
+    std::vector<uint8_t> build() const
+    {
+        std::vector<uint8_t> blob = blob_;
+        blob[126] = static_cast<uint8_t>(blob.size() / 128 - 1);
+        for (std::size_t block = 0; block < blob.size(); block += 128) {
+            uint8_t sum = 0;
+            for (std::size_t i = 0; i < 127; ++i)
+                sum = static_cast<uint8_t>(sum + blob[block + i]);
+            blob[block + 127] = static_cast<uint8_t>(0x100 - sum);
+        }
+        return blob;
+    }
+
+private:
+    static void writeLittleEndian(uint8_t* data, uint32_t value, int bytes)
+    {
+        for (int i = 0; i < bytes; ++i)
+            data[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    static void writeDetailedTiming(uint8_t* descriptor, uint32_t pixel_clock_10khz, uint32_t h_active, uint32_t h_blank, uint32_t v_active, uint32_t v_blank)
+    {
+        writeLittleEndian(descriptor, pixel_clock_10khz, 2);
+        descriptor[2] = static_cast<uint8_t>(h_active & 0xff);
+        descriptor[3] = static_cast<uint8_t>(h_blank & 0xff);
+        descriptor[4] = static_cast<uint8_t>(((h_active >> 8) << 4) | (h_blank >> 8));
+        descriptor[5] = static_cast<uint8_t>(v_active & 0xff);
+        descriptor[6] = static_cast<uint8_t>(v_blank & 0xff);
+        descriptor[7] = static_cast<uint8_t>(((v_active >> 8) << 4) | (v_blank >> 8));
+    }
+
+    uint8_t* nextDescriptor()
+    {
+        uint8_t* descriptor = blob_.data() + 54 + 18 * descriptors_++;
+        return descriptor;
+    }
+
+    uint8_t* addExtension(uint8_t tag)
+    {
+        blob_.resize(blob_.size() + 128, 0);
+        uint8_t* block = blob_.data() + blob_.size() - 128;
+        block[0] = tag;
+        return block;
+    }
+
+    std::vector<uint8_t> blob_;
+    int descriptors_ = 0;
+};
+
+struct CorpusEntry {
+    const char* description;
+    std::vector<uint8_t> blob;
+    uint32_t width;
+    uint32_t height;
+    double refreshRate;
+};
+
+/**
+ * One blob per layout the decoder handles: a base block alone, DisplayID
+ * type I and type VII extensions, a CTA-861 extension and an interlaced
+ * mode. None of them is a dump from a real device; the HDK entries only
+ * borrow the IDs and modes those headsets use.
+ */
+inline std::vector<CorpusEntry> getCorpus()
+{
+    std::vector<CorpusEntry> corpus;
+
+    corpus.push_back({"OSVR HDK 1.x", EdidBuilder("SVR", 0x1019).timing(14850, 1920, 280, 1080, 45).name("OSVR HDK").build(), 1920, 1080, 60.0});
+
+    corpus.push_back({"OSVR HDK 2", EdidBuilder("SVR", 0x1019).timing(25200, 2160, 80, 1200, 50).name("OSVR HDK2").build(), 2160, 1200, 90.0});
+
+    // Native mode only in DisplayID, with a desktop-safe mode in the base block
+    corpus.push_back({"DisplayID type I HMD", EdidBuilder("SVR", 0x1020).timing(14850, 1920, 280, 1080, 45).name("Wide HMD").displayId(false, 44550, 2880, 120, 1600, 50, true).build(), 2880, 1600, 90.0});
+
+    // Faster than the base block's 655 MHz limit
+    corpus.push_back({"DisplayID type VII HMD", EdidBuilder("SVR", 0x1021).timing(14850, 1920, 280, 1080, 45).name("Fast HMD").displayId(true, 712800, 2880, 120, 1600, 50, true).build(), 2880, 1600, 144.0});
+
+    corpus.push_back({"Monitor with CTA-861", EdidBuilder("ABC", 0x2415).timing(14850, 1920, 280, 1080, 45).name("Desktop 24").cta({{7425, 1280, 370, 720, 30}, {2700, 720, 138, 480, 45}}).build(), 1920, 1080, 60.0});
+
+    // 1080i: two 540-line fields of 562.5 lines each, 60 fields a second
+    corpus.push_back({"Interlaced 1080i", EdidBuilder("ABC", 0x1080).timing(7425, 1920, 280, 540, 22, true).name("Old TV").build(), 1920, 1080, 60.0});
+
+    return corpus;
+}
+
+} // end namespace edid_corpus
+
+#endif // INCLUDED_EdidCorpus_h_GUID_FA358E9B_BED8_4920_8B78_4CECA321F4A8
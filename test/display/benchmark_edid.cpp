@@ -0,0 +1,79 @@
+/** @file
+    @brief Measures how long decoding each kind of EDID takes, with and
+    without the cache.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <display/Edid.h>
+#include "EdidCorpus.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstddef>          // for std::size_t
+#include <cstdlib>          // for std::atoi, EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+
+using osvr::display::EdidCache;
+using osvr::display::parseEdid;
+
+namespace {
+
+template <typename Function>
+double measure(int iterations, Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t total = 0;
+    for (int i = 0; i < iterations; ++i) {
+        total += function();
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Keep the work from being optimized away
+    if (0 == total)
+        std::cout << "";
+    return elapsed / iterations * 1e9;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const int iterations = (argc > 1) ? std::atoi(argv[1]) : 100000;
+
+    std::cout << std::left << std::setw(26) << "EDID" << std::right << std::setw(8) << "bytes" << std::setw(14) << "decode (ns)" << std::setw(14) << "cached (ns)" << std::endl;
+
+    EdidCache cache;
+    for (const auto& entry : edid_corpus::getCorpus()) {
+        const auto& blob = entry.blob;
+        const double decode = measure(iterations, [&]() { return parseEdid(blob.data(), blob.size()).timings.size(); });
+        const double cached = measure(iterations, [&]() { return cache.get(blob.data(), blob.size())->timings.size(); });
+        std::cout << std::left << std::setw(26) << entry.description << std::right << std::setw(8) << blob.size() << std::fixed << std::setprecision(1) << std::setw(14) << decode << std::setw(14) << cached << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
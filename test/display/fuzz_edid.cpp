@@ -0,0 +1,62 @@
+/** @file
+    @brief libFuzzer entry point for the EDID decoder.
+
+    Build with -DBUILD_FUZZERS=ON using Clang, then run
+    @c fuzz_edid, optionally giving it a directory of EDID blobs to start
+    from (such as copies of the edid files under /sys/class/drm).
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <display/Display.h>
+#include <display/Edid.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+#include <cstddef>          // for std::size_t
+#include <cstdint>
+#include <cstdlib>          // for std::abort
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, std::size_t size)
+{
+    static osvr::display::EdidCache cache(4);
+
+    const auto info = osvr::display::parseEdid(data, size);
+    for (const auto& timing : info.timings) {
+        const double rate = timing.getRefreshRate();
+        if (rate < 0.0 || std::isnan(rate) || std::isinf(rate))
+            std::abort();
+    }
+
+    // The cache must agree with decoding directly
+    const auto cached = cache.get(data, size);
+    if (cached->valid != info.valid || cached->name != info.name || !(cached->timings == info.timings))
+        std::abort();
+
+    osvr::display::Display display = {};
+    osvr::display::applyEdid(info, display);
+    return 0;
+}
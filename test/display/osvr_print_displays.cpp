@@ -56,6 +56,8 @@ int main(int argc, char* argv[])
 
         cout << "Display: " << display.name << endl;
         cout << "  Adapter: " << display.adapter.description << endl;
+        if (!display.connector.empty())
+            cout << "  Connector: " << display.connector << endl;
         cout << "  Monitor name: " << display.name << endl;
         cout << "  Resolution: " << display.size.width << "x" << display.size.height << endl;
         cout << "  Position: (" << display.position.x << ", " << display.position.y << ")" << endl;
@@ -64,6 +66,7 @@ int main(int argc, char* argv[])
         cout << "  " << (display.attachedToDesktop ? "Extended mode" : "Direct mode") << endl;
         cout << "  EDID vendor ID: " << display.edidVendorId << endl;
         cout << "  EDID product ID: " << display.edidProductId << endl;
+        cout << "  EDID serial number: " << display.edidSerialNumber << endl;
         cout << "" << endl;
     }
 
@@ -0,0 +1,163 @@
+/** @file
+    @brief Checks that the display monitor only moves to a new generation when
+    the displays really change, and that its watcher shuts down cleanly.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <display/DisplayMonitor.h>
+#include "TestCheck.h"
+
+// Library/third-party includes
+#if defined(__linux__)
+#include <sys/resource.h>   // for getrlimit, setrlimit
+#endif
+
+// Standard includes
+#include <atomic>
+#include <chrono>
+#include <cstdlib>          // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using osvr::display::Display;
+using osvr::display::DisplayMonitor;
+
+namespace {
+
+Display makeDisplay(const std::string& name)
+{
+    Display display = {};
+    display.name = name;
+    display.size.width = 1920;
+    display.size.height = 1080;
+    display.verticalRefreshRate = 60.0;
+    display.attachedToDesktop = true;
+    return display;
+}
+
+} // end anonymous namespace
+
+int main(int, char*[])
+{
+    std::vector<Display> displays = {makeDisplay("Desktop")};
+    int enumerations = 0;
+    bool fail = false;
+    auto enumerate = [&]() {
+        ++enumerations;
+        if (fail)
+            throw std::runtime_error("enumeration failed");
+        return displays;
+    };
+
+    {
+        DisplayMonitor monitor(enumerate, false);
+        check(1 == enumerations, "The displays should be read on construction.");
+        check(1 == monitor.getGeneration(), "The first list should be generation 1.");
+
+        check(!monitor.refresh(), "Refreshing an unchanged list should report no change.");
+        check(1 == monitor.getGeneration(), "An unchanged list should keep its generation.");
+
+        displays.push_back(makeDisplay("OSVR HDK"));
+        check(monitor.refresh(), "Plugging in a display should be a change.");
+        uint64_t generation = 0;
+        const auto seen = monitor.getDisplays(&generation);
+        check(2 == generation && 2 == seen.size() && "OSVR HDK" == seen[1].name, "The new display should be listed in generation 2.");
+
+        displays[1].verticalRefreshRate = 90.0;
+        check(monitor.refresh() && 3 == monitor.getGeneration(), "Changing a display's mode should be a change.");
+
+        std::vector<std::string> errors;
+        monitor.setErrorHandler([&](const std::string& error) { errors.push_back(error); });
+        fail = true;
+        check(!monitor.refresh() && 2 == monitor.getDisplays().size(), "A failed enumeration should keep the last list.");
+        check(1 == errors.size() && std::string::npos != errors[0].find("enumeration failed"), "A failed enumeration should be reported to the error handler.");
+        check(!monitor.getError().empty(), "A failed enumeration should be available from getError().");
+        fail = false;
+        check(!monitor.refresh() && monitor.getError().empty() && 1 == errors.size(), "A successful enumeration should clear the error.");
+    }
+
+    {
+        // The real watcher, started and stopped again straight away
+        const auto start = std::chrono::steady_clock::now();
+        {
+            DisplayMonitor monitor([]() { return std::vector<Display>(); });
+            check(1 == monitor.getGeneration(), "A watching monitor should read the displays up front.");
+        }
+        const auto stop_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        check(stop_time < 1.0, "The watcher should stop promptly.");
+        std::cout << "Started and stopped the watcher in " << stop_time * 1e3 << " ms." << std::endl;
+    }
+
+    {
+        // Stopped explicitly, as the driver's Cleanup() does, then started
+        // again
+        std::atomic<int> reads(0);
+        DisplayMonitor monitor([&reads]() {
+            ++reads;
+            return std::vector<Display>();
+        });
+        check(monitor.isWatching() && 1 == reads, "A watching monitor should be watching once constructed.");
+
+        const auto start = std::chrono::steady_clock::now();
+        monitor.stop();
+        const auto stop_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        check(!monitor.isWatching() && stop_time < 1.0, "stop() should join the watcher promptly.");
+        monitor.stop();
+        check(!monitor.isWatching(), "Stopping twice should be harmless.");
+
+        const int reads_before = reads;
+        check(!monitor.refresh() && reads_before + 1 == reads, "A stopped monitor should still refresh on request.");
+        monitor.start();
+        check(monitor.isWatching() && reads_before + 2 <= reads, "Starting again should read the displays and watch them.");
+    }
+
+#if defined(__linux__)
+    {
+        // With no file descriptors to spare, neither the uevent socket nor
+        // the eventfd that wakes the watcher can be made. The watcher should
+        // fall back to timed polls and still stop promptly.
+        rlimit limit;
+        ::getrlimit(RLIMIT_NOFILE, &limit);
+        rlimit none = limit;
+        none.rlim_cur = 0;
+        ::setrlimit(RLIMIT_NOFILE, &none);
+        DisplayMonitor monitor([]() { return std::vector<Display>(); });
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+        check(monitor.isWatching(), "A monitor without an eventfd should still watch.");
+
+        // Let the watcher settle into its wait before stopping it.
+        std::this_thread::sleep_for(std::chrono::milliseconds(150));
+        const auto start = std::chrono::steady_clock::now();
+        monitor.stop();
+        const auto stop_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        check(stop_time < 0.5, "A watcher without an eventfd should stop promptly.");
+        std::cout << "Stopped a watcher without an eventfd in " << stop_time * 1e3 << " ms." << std::endl;
+    }
+#endif
+
+    return finishChecks("Display monitor");
+}
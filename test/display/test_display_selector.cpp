@@ -0,0 +1,144 @@
+/** @file
+    @brief Checks that the display selector finds the HMD by EDID, connector
+    and name, in the configured order.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <display/DisplaySelector.h>
+#include "TestCheck.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdint>
+#include <cstdlib>          // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>
+#include <string>
+#include <vector>
+
+using osvr::display::Display;
+using osvr::display::DisplaySelector;
+using osvr::display::findDisplay;
+using osvr::display::matchesWildcard;
+
+namespace {
+
+Display makeDisplay(const std::string& name, const std::string& connector, uint32_t vendor_id, uint32_t product_id, uint32_t serial_number)
+{
+    Display display = {};
+    display.name = name;
+    display.connector = connector;
+    display.edidVendorId = vendor_id;
+    display.edidProductId = product_id;
+    display.edidSerialNumber = serial_number;
+    return display;
+}
+
+} // end anonymous namespace
+
+int main(int, char*[])
+{
+    check(matchesWildcard("OSVR*", "OSVR HDK2"), "A trailing star should match the rest.");
+    check(matchesWildcard("*HDK?", "OSVR HDK2"), "A question mark should match one character.");
+    check(!matchesWildcard("*HDK?", "OSVR HDK"), "A question mark should need a character.");
+    check(matchesWildcard("*", ""), "A star should match nothing.");
+    check(!matchesWildcard("OSVR", "OSVR HDK"), "Without a star the whole name should match.");
+    check(matchesWildcard("a*b*c", "aXbYbZc"), "Stars should back up.");
+
+    const std::vector<Display> displays = {
+        makeDisplay("Desktop 24", "DP-1", 0x1234, 0x2415, 7),
+        makeDisplay("OSVR Monitor", "DP-2", 0x1234, 0x9999, 0),
+        makeDisplay("HMD", "HDMI-A-1", 53838, 4121, 1001),
+        makeDisplay("HMD", "HDMI-A-2", 53838, 4121, 1002),
+    };
+
+    {
+        DisplaySelector selector;
+        selector.setNamePattern("OSVR");
+        check(1 == selector.select(displays), "With only a name, it should be found anywhere in the name.");
+        check(DisplaySelector::Criterion::Name == selector.getMatchedCriterion(), "The match should be by name.");
+
+        check(selector.setEdids("53838:4121").empty(), "A decimal EDID should be read.");
+        check(2 == selector.select(displays), "An EDID match should beat a name match.");
+        check(DisplaySelector::Criterion::Edid == selector.getMatchedCriterion(), "The match should be by EDID.");
+
+        check(selector.setEdids("0xd24e:0x1019:1002").empty(), "A hex EDID with a serial number should be read.");
+        check(3 == selector.select(displays), "A serial number should pick out one of two identical HMDs.");
+
+        selector.setConnector("DP-1");
+        check(3 == selector.select(displays), "EDID should come before connector by default.");
+        check(selector.setPriority("connector, edid,name").empty(), "The priority should be read.");
+        check(0 == selector.select(displays), "A connector first in the priority should win.");
+
+        check("serial" == selector.setPriority("name,serial"), "Unknown criteria should be reported.");
+        check(1 == selector.select(displays), "Only the known criteria should be used.");
+
+        check("53838,1:2:3:4,x:1" == selector.setEdids("53838,1:2:3:4,x:1"), "Unreadable EDIDs should be reported.");
+
+        selector.setPriority("edid");
+        check(-1 == selector.select(displays), "No match should give -1.");
+    }
+
+    {
+        // The choice is kept for a generation, and settings that don't
+        // change keep it too.
+        DisplaySelector selector;
+        selector.setEdids("53838:4121");
+        check(2 == selector.select(displays, 1), "The HMD should be found.");
+
+        std::vector<Display> unplugged(displays.begin(), displays.begin() + 2);
+        check(2 == selector.select(unplugged, 1), "The same generation should reuse the last choice.");
+        selector.setEdids("53838:4121");
+        check(2 == selector.select(unplugged, 1), "Reapplying the same settings should keep the choice.");
+        check(-1 == selector.select(unplugged, 2), "A new generation should look again.");
+
+        selector.setConnector("DP-2");
+        check(1 == selector.select(unplugged, 2), "Changing a setting should look again.");
+    }
+
+    {
+        // Finding the selected display again, as Windows lists them: no
+        // connectors, EDID IDs where the driver reports them.
+        std::vector<Display> listed = {makeDisplay("Generic PnP Monitor", "", 0, 0, 0), makeDisplay("OSVR HDK", "", 0xd24e, 0x1019, 0)};
+        listed[0].attachedToDesktop = true;
+        listed[1].attachedToDesktop = false;
+
+        Display hmd = listed[1];
+        hmd.verticalRefreshRate = 90.0;
+        const int hmd_index = findDisplay(listed, hmd);
+        check(1 == hmd_index && !listed[hmd_index].attachedToDesktop, "A display should be found by its EDID IDs whatever its mode.");
+        const int monitor_index = findDisplay(listed, listed[0]);
+        check(0 == monitor_index && listed[monitor_index].attachedToDesktop, "A display without EDID IDs should be found by name and adapter.");
+
+        Display unknown = listed[0];
+        unknown.adapter.description = "Other adapter";
+        check(findDisplay(listed, unknown) < 0, "A display with the same name on another adapter should not be found.");
+        hmd.edidSerialNumber = 7;
+        listed[1].edidSerialNumber = 8;
+        check(findDisplay(listed, hmd) < 0, "A display with another serial number should not be found.");
+    }
+
+    return finishChecks("Display selection");
+}
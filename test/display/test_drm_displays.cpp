@@ -0,0 +1,211 @@
+/** @file
+    @brief Checks that DRM connectors described in a sysfs-like tree are read
+    into the right displays.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <display/DisplaySelector.h>
+#include <display/DrmDisplays.h>
+#include "TestCheck.h"
+
+// Library/third-party includes
+#include <stdlib.h>         // for mkdtemp
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Standard includes
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>          // for EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using osvr::display::Display;
+using osvr::display::findDisplay;
+using osvr::display::getDrmDisplays;
+
+namespace {
+
+void writeFile(const std::string& path, const std::string& contents)
+{
+    std::ofstream file(path, std::ios::binary);
+    file << contents;
+}
+
+/**
+ * Builds a 128-byte EDID for a 2160x1200 panel at 90 Hz, with the vendor and
+ * product IDs of an OSVR HDK.
+ */
+std::string makeEdid()
+{
+    uint8_t edid[128] = {0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00};
+    edid[8] = 0x4e; // "SVR", 0xd24e once byte-swapped
+    edid[9] = 0xd2;
+    edid[10] = 0x19;
+    edid[11] = 0x10;
+    edid[18] = 1;
+    edid[19] = 3;
+
+    // Preferred timing: 2240 x 1250 total at 252 MHz
+    uint8_t* timing = edid + 54;
+    const uint32_t pixel_clock = 25200; // in 10 kHz units
+    timing[0] = pixel_clock & 0xff;
+    timing[1] = pixel_clock >> 8;
+    timing[2] = 2160 & 0xff;
+    timing[3] = 80;
+    timing[4] = ((2160 >> 8) << 4) | 0;
+    timing[5] = 1200 & 0xff;
+    timing[6] = 50;
+    timing[7] = ((1200 >> 8) << 4) | 0;
+
+    // Monitor name descriptor
+    uint8_t* name = edid + 72;
+    name[3] = 0xfc;
+    std::memcpy(name + 5, "OSVR HDK\n    ", 13);
+
+    // Unused descriptors
+    edid[90 + 3] = 0x10;
+    edid[108 + 3] = 0x10;
+
+    uint8_t sum = 0;
+    for (int i = 0; i < 127; ++i)
+        sum += edid[i];
+    edid[127] = static_cast<uint8_t>(256 - sum);
+
+    return std::string(reinterpret_cast<const char*>(edid), sizeof(edid));
+}
+
+void addConnector(const std::string& root, const std::string& name, const std::string& status, const std::string& enabled, const std::string& modes, const std::string& edid)
+{
+    const std::string path = root + "/" + name;
+    ::mkdir(path.c_str(), 0755);
+    writeFile(path + "/status", status + "\n");
+    writeFile(path + "/enabled", enabled + "\n");
+    writeFile(path + "/modes", modes);
+    writeFile(path + "/edid", edid);
+}
+
+} // end anonymous namespace
+
+int main(int, char*[])
+{
+    char root_template[] = "/tmp/osvr_drm_XXXXXX";
+    const char* root_path = ::mkdtemp(root_template);
+    if (!root_path) {
+        std::cerr << "! Could not make a temporary directory." << std::endl;
+        return EXIT_FAILURE;
+    }
+    const std::string root = root_path;
+
+    // A card with a driver, an HMD, a desktop monitor without an EDID and an
+    // empty connector
+    ::mkdir((root + "/card0").c_str(), 0755);
+    ::mkdir((root + "/card0/device").c_str(), 0755);
+    ::mkdir((root + "/drivers").c_str(), 0755);
+    ::mkdir((root + "/drivers/amdgpu").c_str(), 0755);
+    if (::symlink((root + "/drivers/amdgpu").c_str(), (root + "/card0/device/driver").c_str()) != 0) {
+        std::cerr << "! Could not link the driver." << std::endl;
+    }
+    addConnector(root, "card0-HDMI-A-1", "connected", "disabled", "2160x1200\n1920x1080\n", makeEdid());
+    addConnector(root, "card0-DP-1", "connected", "enabled", "1920x1080\n", "");
+    addConnector(root, "card0-DP-2", "disconnected", "disabled", "", "");
+    ::mkdir((root + "/version").c_str(), 0755);
+
+    const auto displays = getDrmDisplays(root);
+    check(2 == displays.size(), "Only the connected connectors should be listed.");
+    if (2 == displays.size()) {
+        const Display& monitor = displays[0];
+        check("DP-1" == monitor.name && "DP-1" == monitor.connector, "A display without an EDID should be named after its connector.");
+        check(1920 == monitor.size.width && 1080 == monitor.size.height, "The size should come from the preferred mode.");
+        check(0.0 == monitor.verticalRefreshRate, "Without an EDID the refresh rate shouldn't be known.");
+        check(monitor.attachedToDesktop, "An enabled connector should be on the desktop.");
+        check("card0 (amdgpu)" == monitor.adapter.description, "The adapter should name its card and driver.");
+
+        const Display& hmd = displays[1];
+        check("OSVR HDK" == hmd.name && "HDMI-A-1" == hmd.connector, "The EDID monitor name should be used, keeping the connector.");
+        check(0xd24e == hmd.edidVendorId && 0x1019 == hmd.edidProductId, "The EDID IDs should match what Windows reports.");
+        check(2160 == hmd.size.width && 1200 == hmd.size.height, "The HMD's size should come from its preferred mode.");
+        check(std::fabs(hmd.verticalRefreshRate - 90.0) < 1e-9, "The refresh rate should come from the preferred timing.");
+        check(!hmd.attachedToDesktop, "A disabled connector should not be on the desktop.");
+    }
+
+    // How the driver decides whether its display is on the desktop: look it
+    // up by identity, then ask that entry. Both connectors are listed, so
+    // merely finding the display says nothing.
+    if (2 == displays.size()) {
+        Display hmd = displays[1];
+        hmd.verticalRefreshRate = 60.0;
+        hmd.position.x = 1920;
+        const int hmd_index = findDisplay(displays, hmd);
+        check(1 == hmd_index, "The HMD should be found by its connector and EDID IDs.");
+        check(hmd_index >= 0 && !displays[hmd_index].attachedToDesktop, "The HMD on a disabled connector should not be on the desktop.");
+        const int monitor_index = findDisplay(displays, displays[0]);
+        check(0 == monitor_index && displays[monitor_index].attachedToDesktop, "The monitor on an enabled connector should be on the desktop.");
+
+        // Extending the desktop onto the HMD
+        writeFile(root + "/card0-HDMI-A-1/enabled", "enabled\n");
+        const auto extended = getDrmDisplays(root);
+        const int extended_index = findDisplay(extended, hmd);
+        check(extended_index >= 0 && extended[extended_index].attachedToDesktop, "The HMD should be on the desktop once its connector is enabled.");
+        writeFile(root + "/card0-HDMI-A-1/enabled", "disabled\n");
+
+        // A different headset on the same connector isn't the same display.
+        Display other = hmd;
+        other.edidProductId = 0x1234;
+        check(findDisplay(displays, other) < 0, "A display with other EDID IDs on the same connector should not be found.");
+    }
+
+    // The kernel preferring a mode other than the EDID's: the size and
+    // refresh rate should both be that mode's, or the rate unknown if the
+    // EDID doesn't describe it.
+    {
+        const std::string quirk_root = root + "/quirk";
+        ::mkdir(quirk_root.c_str(), 0755);
+        addConnector(quirk_root, "card0-HDMI-A-1", "connected", "enabled", "1920x1080\n2160x1200\n", makeEdid());
+        const auto quirked = getDrmDisplays(quirk_root);
+        check(1 == quirked.size() && 1920 == quirked[0].size.width && 1080 == quirked[0].size.height, "The kernel's preferred mode should set the size.");
+        check(1 == quirked.size() && 0.0 == quirked[0].verticalRefreshRate, "A mode the EDID doesn't describe should have no refresh rate.");
+    }
+
+    check(getDrmDisplays(root + "/missing").empty(), "A missing tree should list no displays.");
+
+    const int iterations = 1000;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        getDrmDisplays(root);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Listed the displays in " << elapsed / iterations * 1e6 << " us." << std::endl;
+
+    std::string remove = "rm -rf '" + root + "'";
+    if (std::system(remove.c_str()) != 0) {
+        std::cerr << "Could not remove " << root << std::endl;
+    }
+
+    return finishChecks("DRM displays");
+}
@@ -0,0 +1,159 @@
+/** @file
+    @brief Checks the EDID decoder against blobs of known layout, and that it
+    survives truncated and corrupted ones.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <display/Edid.h>
+#include "EdidCorpus.h"
+#include "TestCheck.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>          // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using osvr::display::Display;
+using osvr::display::EdidCache;
+using osvr::display::EdidInfo;
+using osvr::display::applyEdid;
+using osvr::display::parseEdid;
+
+namespace {
+
+} // end anonymous namespace
+
+int main(int, char*[])
+{
+    const auto corpus = edid_corpus::getCorpus();
+
+    for (const auto& entry : corpus) {
+        const std::string name = entry.description;
+        const EdidInfo info = parseEdid(entry.blob.data(), entry.blob.size());
+        check(info.valid, name + ": should be valid.");
+        check(!info.timings.empty(), name + ": should have timings.");
+        if (info.timings.empty())
+            continue;
+
+        const auto& preferred = info.timings.front();
+        std::size_t preferred_count = 0;
+        for (const auto& timing : info.timings)
+            preferred_count += timing.preferred ? 1 : 0;
+        check(preferred.preferred && 1 == preferred_count, name + ": only the first timing should be marked preferred.");
+        check(preferred.horizontalActive == entry.width && preferred.verticalActive == entry.height, name + ": the preferred timing should be the native mode.");
+        check(std::fabs(preferred.getRefreshRate() - entry.refreshRate) < 1e-9, name + ": the refresh rate should be exact.");
+
+        Display display = {};
+        applyEdid(info, display);
+        check(display.size.width == entry.width && display.size.height == entry.height && display.verticalRefreshRate == preferred.getRefreshRate(), name + ": the display should take the preferred timing.");
+        check(display.name == info.name && !display.name.empty(), name + ": the display should take the monitor name.");
+    }
+
+    {
+        const auto& hdk = corpus[1];
+        const EdidInfo info = parseEdid(hdk.blob.data(), hdk.blob.size());
+        check("SVR" == info.manufacturer, "The manufacturer should decode to its PNP ID.");
+        check(53838 == info.vendorId && 4121 == info.productId, "The IDs should match what Windows reports for an HDK.");
+        check("OSVR HDK2" == info.name, "The monitor name should lose its padding.");
+        check(1 == info.version && 4 == info.revision, "The version should be decoded.");
+    }
+
+    {
+        const auto& monitor = corpus[4];
+        const EdidInfo info = parseEdid(monitor.blob.data(), monitor.blob.size());
+        check(3 == info.timings.size(), "CTA-861 timings should follow the base block's.");
+        check(3 == info.timings.size() && 1280 == info.timings[1].horizontalActive && 720 == info.timings[2].horizontalActive, "CTA-861 timings should keep their order.");
+    }
+
+    {
+        const auto& hmd = corpus[2];
+        const EdidInfo info = parseEdid(hmd.blob.data(), hmd.blob.size());
+        check(2 == info.timings.size() && 1920 == info.timings[1].horizontalActive, "The base block timing should follow a preferred DisplayID timing.");
+        check(2 == info.timings.size() && !info.timings[1].preferred, "The base block timing should lose its preference to a DisplayID one.");
+    }
+
+    {
+        const auto& tv = corpus[5];
+        const EdidInfo info = parseEdid(tv.blob.data(), tv.blob.size());
+        check(!info.timings.empty() && info.timings[0].interlaced && 1125 == info.timings[0].verticalActive + info.timings[0].verticalBlank, "An interlaced timing should be decoded as a whole frame.");
+    }
+
+    // Nothing may be read past the end, whatever the blob claims
+    for (const auto& entry : corpus) {
+        for (std::size_t size = 0; size < entry.blob.size(); ++size) {
+            const std::vector<uint8_t> truncated(entry.blob.begin(), entry.blob.begin() + size);
+            const EdidInfo info = parseEdid(truncated.data(), truncated.size());
+            if (size < 128)
+                check(!info.valid, "Less than a block should not be valid.");
+        }
+    }
+    check(!parseEdid(nullptr, 0).valid, "No data should not be valid.");
+
+    // Random corruption, with a fixed seed so failures reproduce
+    std::mt19937 random(2016);
+    int mutations = 0;
+    for (const auto& entry : corpus) {
+        for (int i = 0; i < 2000; ++i) {
+            std::vector<uint8_t> blob = entry.blob;
+            const int changes = 1 + static_cast<int>(random() % 8);
+            for (int c = 0; c < changes; ++c)
+                blob[random() % blob.size()] = static_cast<uint8_t>(random());
+            const EdidInfo info = parseEdid(blob.data(), blob.size());
+            for (const auto& timing : info.timings) {
+                const double rate = timing.getRefreshRate();
+                check(rate >= 0.0 && !std::isnan(rate) && !std::isinf(rate), "A corrupted timing should still have a finite refresh rate.");
+            }
+            ++mutations;
+        }
+    }
+    std::cout << "Decoded " << mutations << " corrupted blobs." << std::endl;
+
+    {
+        EdidCache cache(2);
+        const auto& hdk = corpus[1].blob;
+        const auto first = cache.get(hdk.data(), hdk.size());
+        const auto second = cache.get(hdk.data(), hdk.size());
+        check(1 == cache.size(), "A blob should be cached once.");
+        check(first == second, "A cached blob should be decoded once.");
+        check("OSVR HDK2" == first->name && first->timings == parseEdid(hdk.data(), hdk.size()).timings, "A cached blob should decode the same.");
+
+        std::vector<uint8_t> changed = hdk;
+        changed[20] ^= 0xff;
+        cache.get(changed.data(), changed.size());
+        check(2 == cache.size(), "A different blob should get its own entry.");
+
+        const auto& monitor = corpus[4].blob;
+        const auto third = cache.get(monitor.data(), monitor.size());
+        check(1 == cache.size() && "Desktop 24" == third->name, "A full cache should start over.");
+    }
+
+    return finishChecks("EDID decoding");
+}
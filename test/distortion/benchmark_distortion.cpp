@@ -0,0 +1,119 @@
+/** @file
+    @brief Compares evaluating distortion one point at a time with evaluating
+    it in batches, and times baking a grid.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <distortion/DistortionGrid.h>
+#include <distortion/DistortionModel.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <chrono>
+#include <cstddef>          // for std::size_t
+#include <cstdlib>          // for std::atoi, EXIT_SUCCESS
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using osvr::distortion::DistortedPoint;
+using osvr::distortion::DistortionGrid;
+using osvr::distortion::DistortionModel;
+using osvr::distortion::Green;
+
+namespace {
+
+const char* const PolynomialDescriptor = R"({
+    "hmd": {
+        "distortion": {
+            "type": "rgb_symmetric_polynomials",
+            "distance_scale_x": 1,
+            "distance_scale_y": 1,
+            "polynomial_coeffs_red": [0, 1, -0.3, 0.6, 0.02, -0.01],
+            "polynomial_coeffs_green": [0, 1, -0.25, 0.55, 0.02, -0.01],
+            "polynomial_coeffs_blue": [0, 1, -0.2, 0.5, 0.02, -0.01]
+        },
+        "eyes": [
+            {"center_proj_x": 0.55, "center_proj_y": 0.5},
+            {"center_proj_x": 0.45, "center_proj_y": 0.5}
+        ]
+    }
+})";
+
+template <typename Function>
+double measure(int iterations, Function function)
+{
+    const auto start = std::chrono::steady_clock::now();
+    float total = 0.0f;
+    for (int i = 0; i < iterations; ++i) {
+        total += function();
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Keep the work from being optimized away
+    if (0.0f == total)
+        std::cout << "";
+    return elapsed / iterations;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const int iterations = (argc > 1) ? std::atoi(argv[1]) : 200;
+    const std::size_t side = 256;
+
+    const auto model = DistortionModel::fromDisplayDescriptor(PolynomialDescriptor);
+
+    std::vector<float> u, v;
+    for (std::size_t row = 0; row < side; ++row) {
+        for (std::size_t column = 0; column < side; ++column) {
+            u.push_back(static_cast<float>(column) / (side - 1));
+            v.push_back(static_cast<float>(row) / (side - 1));
+        }
+    }
+    std::vector<DistortedPoint> out(u.size());
+
+    const double scalar = measure(iterations, [&]() {
+        for (std::size_t i = 0; i < u.size(); ++i) {
+            out[i] = model.compute(0, u[i], v[i]);
+        }
+        return out.back().channels[Green][0];
+    });
+    const double batch = measure(iterations, [&]() {
+        model.computeBatch(0, u.data(), v.data(), u.size(), out.data());
+        return out.back().channels[Green][0];
+    });
+    const double bake = measure(iterations, [&]() { return DistortionGrid(model, 0, 65).getPoints()[65 * 65 - 1].channels[Green][0]; });
+
+    const double points = static_cast<double>(u.size());
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Scalar: " << std::setw(8) << scalar / points * 1e9 << " ns per point, " << std::setw(8) << points / scalar / 1e6 << " M points/s" << std::endl;
+    std::cout << "Batch:  " << std::setw(8) << batch / points * 1e9 << " ns per point, " << std::setw(8) << points / batch / 1e6 << " M points/s (" << scalar / batch << "x)" << std::endl;
+    std::cout << "Baking a 65x65 grid: " << bake * 1e6 << " us" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+/** @file
+    @brief Prints how many rendered pixels per screen pixel a display
+    descriptor's distortion needs across each eye, and the render target size
+    that follows.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <distortion/DistortionModel.h>
+#include <distortion/RenderDensity.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::max
+#include <cmath>            // for std::ceil, std::sqrt
+#include <cstdlib>          // for std::atoi, std::atof, EXIT_SUCCESS, EXIT_FAILURE
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using osvr::distortion::DistortionModel;
+using osvr::distortion::RenderScale;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <display descriptor.json> [eye width] [eye height] [steps]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream file(argv[1]);
+    if (!file) {
+        std::cerr << "Unable to read " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::stringstream descriptor;
+    descriptor << file.rdbuf();
+
+    const double width = (argc > 2) ? std::atof(argv[2]) : 960.0;
+    const double height = (argc > 3) ? std::atof(argv[3]) : 1080.0;
+    const int steps = (argc > 4) ? std::max(std::atoi(argv[4]), 2) : 11;
+
+    DistortionModel model;
+    try {
+        model = DistortionModel::fromDisplayDescriptor(descriptor.str());
+    } catch (const std::exception& e) {
+        std::cerr << "Unable to read the distortion: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (int eye = 0; eye < 2; ++eye) {
+        const RenderScale center = osvr::distortion::computeCenterRenderScale(model, eye, width, height);
+        const long target_width = static_cast<long>(std::ceil(width * center.x - 1e-6));
+        const long target_height = static_cast<long>(std::ceil(height * center.y - 1e-6));
+        std::cout << (0 == eye ? "Left" : "Right") << " eye, " << static_cast<long>(width) << "x" << static_cast<long>(height) << " pixels:" << std::endl;
+        std::cout << "  At the lens center: " << center.x << "x horizontally, " << center.y << "x vertically, for a "
+                  << target_width << "x" << target_height << " render target" << std::endl;
+        std::cout << "  Rendered pixels needed per screen pixel, across the screen:" << std::endl;
+
+        for (int row = 0; row < steps; ++row) {
+            std::cout << "   ";
+            for (int column = 0; column < steps; ++column) {
+                const double u = static_cast<double>(column) / (steps - 1);
+                const double v = static_cast<double>(row) / (steps - 1);
+                const RenderScale scale = osvr::distortion::computeRenderScale(model, eye, u, v, width, height);
+                std::cout << std::setw(6) << std::sqrt(scale.x * scale.y);
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
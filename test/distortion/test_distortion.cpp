@@ -0,0 +1,304 @@
+/** @file
+    @brief Checks distortion read from display descriptors, and that the baked
+    grids stay close to the models they're baked from.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <distortion/DistortionCache.h>
+#include <distortion/DistortionGrid.h>
+#include <distortion/DistortionModel.h>
+#include <distortion/RenderDensity.h>
+#include "TestCheck.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::max
+#include <chrono>
+#include <cmath>
+#include <cstdio>           // for std::remove
+#include <cstdlib>          // for EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>          // for std::memcmp
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using osvr::distortion::Blue;
+using osvr::distortion::CacheHeader;
+using osvr::distortion::CacheMagic;
+using osvr::distortion::CacheVersion;
+using osvr::distortion::DistortedPoint;
+using osvr::distortion::DistortionCache;
+using osvr::distortion::DistortionGrid;
+using osvr::distortion::DistortionModel;
+using osvr::distortion::Green;
+using osvr::distortion::NumChannels;
+using osvr::distortion::Red;
+using osvr::distortion::RenderScale;
+using osvr::distortion::computeCenterRenderScale;
+using osvr::distortion::computeRenderScale;
+
+namespace {
+
+/// Radial polynomials with a little chromatic aberration, and the eye
+/// centers moved toward the nose.
+const char* const PolynomialDescriptor = R"({
+    "hmd": {
+        "distortion": {
+            "type": "rgb_symmetric_polynomials",
+            "distance_scale_x": 1,
+            "distance_scale_y": 1,
+            "polynomial_coeffs_red": [0, 1, -0.3, 0.6],
+            "polynomial_coeffs_green": [0, 1, -0.25, 0.55],
+            "polynomial_coeffs_blue": [0, 1, -0.2, 0.5]
+        },
+        "eyes": [
+            {"center_proj_x": 0.55, "center_proj_y": 0.5},
+            {"center_proj_x": 0.45, "center_proj_y": 0.5}
+        ]
+    }
+})";
+
+/// Points measured on a 3x3 grid that magnify the edges by 10%
+const char* const PointSampleDescriptor = R"({
+    "hmd": {
+        "distortion": {
+            "type": "mono_point_samples",
+            "mono_point_samples": [
+                [[[0.5, 0.5], [0.5, 0.5]], [[0, 0.5], [-0.05, 0.5]], [[1, 0.5], [1.05, 0.5]],
+                 [[0.5, 0], [0.5, -0.05]], [[0.5, 1], [0.5, 1.05]]],
+                [[[0.5, 0.5], [0.5, 0.5]], [[0, 0.5], [-0.05, 0.5]], [[1, 0.5], [1.05, 0.5]],
+                 [[0.5, 0], [0.5, -0.05]], [[0.5, 1], [0.5, 1.05]]]
+            ]
+        }
+    }
+})";
+
+double maxDifference(const DistortedPoint& a, const DistortedPoint& b)
+{
+    double difference = 0.0;
+    for (int channel = 0; channel < NumChannels; ++channel) {
+        for (int axis = 0; axis < 2; ++axis) {
+            difference = std::max(difference, static_cast<double>(std::abs(a.channels[channel][axis] - b.channels[channel][axis])));
+        }
+    }
+    return difference;
+}
+
+/// Evaluates a row of @p steps + 1 points at height @p v in one batch.
+std::vector<DistortedPoint> computeRow(const DistortionModel& model, int eye, int steps, float v)
+{
+    std::vector<float> us(steps + 1), vs(steps + 1, v);
+    for (int i = 0; i <= steps; ++i) {
+        us[i] = static_cast<float>(i) / steps;
+    }
+    std::vector<DistortedPoint> row(steps + 1);
+    model.computeBatch(eye, us.data(), vs.data(), row.size(), row.data());
+    return row;
+}
+
+double maxGridError(const DistortionModel& model, int eye, const DistortionGrid& grid)
+{
+    double error = 0.0;
+    const int steps = 97;
+    for (int j = 0; j <= steps; ++j) {
+        const float v = static_cast<float>(j) / steps;
+        const std::vector<DistortedPoint> exact = computeRow(model, eye, steps, v);
+        for (int i = 0; i <= steps; ++i) {
+            error = std::max(error, maxDifference(exact[i], grid.lookup(static_cast<float>(i) / steps, v)));
+        }
+    }
+    return error;
+}
+
+/// The largest difference between computeBatch() and compute(), over rows
+/// that don't fill a whole number of batches.
+double maxBatchError(const DistortionModel& model, int eye)
+{
+    double error = 0.0;
+    const int steps = 97;
+    for (int j = 0; j <= steps; ++j) {
+        const float v = static_cast<float>(j) / steps;
+        const std::vector<DistortedPoint> batch = computeRow(model, eye, steps, v);
+        for (int i = 0; i <= steps; ++i) {
+            error = std::max(error, maxDifference(batch[i], model.compute(eye, static_cast<float>(i) / steps, v)));
+        }
+    }
+    return error;
+}
+
+bool throws(const std::string& descriptor)
+{
+    try {
+        DistortionModel::fromDisplayDescriptor(descriptor);
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+} // end anonymous namespace
+
+int main(int, char*[])
+{
+    check(DistortionModel::fromDisplayDescriptor("").isIdentity(), "No descriptor should mean no distortion.");
+    check(DistortionModel::fromDisplayDescriptor(R"({"hmd": {}})").isIdentity(), "A descriptor without distortion should mean none.");
+    check(DistortionModel::fromDisplayDescriptor(R"({"hmd": {"distortion": {"k1_red": 0, "k1_green": 0, "k1_blue": 0}}})").isIdentity(), "Zero k1 terms should mean no distortion.");
+    check(throws("{"), "Malformed JSON should be an error.");
+    check(throws(R"({"hmd": {"distortion": {"type": "unheard_of"}}})"), "An unknown distortion type should be an error.");
+    check(throws(R"({"hmd": {"distortion": {"type": "rgb_symmetric_polynomials"}}})"), "Missing coefficients should be an error.");
+
+    {
+        const auto model = DistortionModel::fromDisplayDescriptor(PolynomialDescriptor);
+        check(DistortionModel::Type::Polynomial == model.getType(), "The polynomials should be read.");
+
+        const DistortedPoint center = model.compute(0, 0.55f, 0.5f);
+        check(std::abs(center.channels[Green][0] - 0.55f) < 1e-6f && std::abs(center.channels[Green][1] - 0.5f) < 1e-6f, "The center of projection shouldn't move.");
+
+        // r = 0.3 from the left eye's center: r' = 0.3 - 0.25 * 0.09 + 0.55 * 0.027
+        const DistortedPoint edge = model.compute(0, 0.85f, 0.5f);
+        const double expected = 0.55 + 0.3 - 0.25 * 0.09 + 0.55 * 0.027;
+        check(std::abs(edge.channels[Green][0] - expected) < 1e-6, "The green polynomial should be applied.");
+        check(edge.channels[Red][0] != edge.channels[Blue][0], "Each channel should get its own polynomial.");
+
+        const DistortedPoint mirrored = model.compute(1, 0.15f, 0.5f);
+        check(std::abs(mirrored.channels[Green][0] - (1.0 - expected)) < 1e-6, "The right eye should use its own center.");
+
+        check(maxBatchError(model, 0) < 1e-5 && maxBatchError(model, 1) < 1e-5, "Batches should match the polynomial point by point.");
+
+        const DistortionGrid grid(model, 0, 65);
+        const double error = maxGridError(model, 0, grid);
+        check(error < 2e-4, "A 65x65 grid should follow the polynomial closely.");
+        std::cout << "Polynomial grid error: " << error << std::endl;
+
+        const auto start = std::chrono::steady_clock::now();
+        const int lookups = 1000000;
+        float sum = 0.0f;
+        for (int i = 0; i < lookups; ++i) {
+            const float u = static_cast<float>(i % 1000) / 1000.0f;
+            const float v = static_cast<float>(i / 1000) / 1000.0f;
+            sum += grid.lookup(u, v).channels[Green][0];
+        }
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Grid lookups take " << elapsed / lookups * 1e9 << " ns (" << sum << ")." << std::endl;
+    }
+
+    {
+        const auto model = DistortionModel::fromDisplayDescriptor(PointSampleDescriptor);
+        check(DistortionModel::Type::PointSamples == model.getType(), "The point samples should be read.");
+
+        const DistortedPoint right = model.compute(0, 1.0f, 0.5f);
+        check(std::abs(right.channels[Red][0] - 1.05f) < 1e-6f, "A sample point should map to its output.");
+
+        // OSVR's y runs up; SteamVR's runs down
+        const DistortedPoint top = model.compute(0, 0.5f, 0.0f);
+        check(std::abs(top.channels[Blue][1] + 0.05f) < 1e-6f, "Samples should be flipped into SteamVR's coordinates.");
+
+        const DistortedPoint between = model.compute(0, 0.75f, 0.5f);
+        check(std::abs(between.channels[Green][0] - 0.775f) < 1e-6f, "Points between samples should be interpolated.");
+
+        check(0.0 == maxBatchError(model, 1), "Batches of point samples should match point by point.");
+
+        const DistortionGrid grid(model, 1, 17);
+        check(maxGridError(model, 1, grid) < 0.01, "A grid should follow the point samples.");
+    }
+
+    {
+        // A constant term and unequal distance scales take the batch's other paths
+        const auto model = DistortionModel::fromDisplayDescriptor(R"({"hmd": {"distortion": {
+            "type": "rgb_symmetric_polynomials", "distance_scale_x": 1.2, "distance_scale_y": 0.9,
+            "polynomial_coeffs_red": [0.01, 1, 0, 0.2], "polynomial_coeffs_green": [0, 1.1], "polynomial_coeffs_blue": [0, 1, 0.1]}}})");
+        check(maxBatchError(model, 0) < 1e-5, "Batches should handle constant terms and distance scales.");
+    }
+
+    {
+        const RenderScale identity = computeCenterRenderScale(DistortionModel(), 0, 960, 1080);
+        check(std::abs(identity.x - 1.0) < 1e-6 && std::abs(identity.y - 1.0) < 1e-6, "Without distortion the screen's own resolution should do.");
+
+        // Sampling 0.8 of the image per unit of screen at the center needs 1.25 times the pixels
+        const auto model = DistortionModel::fromDisplayDescriptor(R"({"hmd": {"distortion": {
+            "type": "rgb_symmetric_polynomials",
+            "polynomial_coeffs_red": [0, 0.8, 0, 0.3], "polynomial_coeffs_green": [0, 0.8, 0, 0.3], "polynomial_coeffs_blue": [0, 0.8, 0, 0.3]},
+            "eyes": [{"center_proj_x": 0.6, "center_proj_y": 0.5}, {"center_proj_x": 0.4, "center_proj_y": 0.5}]}})");
+        const RenderScale center = computeCenterRenderScale(model, 1, 960, 1080);
+        check(std::abs(center.x - 1.25) < 1e-4 && std::abs(center.y - 1.25) < 1e-4, "The render scale should undo the magnification at the lens center.");
+
+        const RenderScale edge = computeRenderScale(model, 1, 0.9, 0.5, 960, 1080);
+        check(edge.x < center.x && edge.y < center.y, "Fewer rendered pixels should be needed where the lens spreads them out.");
+    }
+
+    {
+        const auto model = DistortionModel::fromDisplayDescriptor(PolynomialDescriptor);
+        const DistortionGrid left(model, 0, 33);
+        const DistortionGrid right(model, 1, 33);
+
+        const uint64_t key = DistortionCache::computeKey(PolynomialDescriptor, "{}", 33);
+        check(key == DistortionCache::computeKey(PolynomialDescriptor, "{}", 33), "The cache key should be repeatable.");
+        check(key != DistortionCache::computeKey(PolynomialDescriptor, R"({"numBuffers": 2})", 33), "The render manager config should change the cache key.");
+        check(key != DistortionCache::computeKey(PolynomialDescriptor, "{}", 65), "The grid size should change the cache key.");
+        check(key != DistortionCache::computeKey(PointSampleDescriptor, "{}", 33), "The display descriptor should change the cache key.");
+
+        const std::string path = "test_distortion_cache.bin";
+        DistortionCache cache(path);
+        check(cache.store(key, {&left, &right}), "The grids should be stored: " + cache.getError());
+
+        auto grids = cache.load(key);
+        check(2 == grids.size(), "Both grids should be loaded: " + cache.getError());
+        if (2 == grids.size()) {
+            check(33 == grids[1].getSize() && 0 == std::memcmp(grids[1].getPoints(), right.getPoints(), 33 * 33 * sizeof(DistortedPoint)), "Loaded grids should hold the stored points.");
+            check(0.0 == maxDifference(grids[0].lookup(0.3f, 0.7f), left.lookup(0.3f, 0.7f)), "Loaded grids should look up like the originals.");
+        }
+        check(cache.load(key + 1).empty(), "A cache baked for another configuration should be ignored.");
+
+        grids.clear();
+        {
+            std::ofstream damaged(path, std::ios::binary | std::ios::trunc);
+            damaged << "OSVRDIST";
+        }
+        check(cache.load(key).empty(), "A damaged cache should be ignored.");
+
+        // 2^32 points a side squares to 0 in 64 bits, which would have
+        // matched a file with no points at all.
+        {
+            CacheHeader header = {};
+            std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+            header.version = CacheVersion;
+            header.headerSize = sizeof(CacheHeader);
+            header.pointSize = sizeof(DistortedPoint);
+            header.gridCount = 1;
+            header.key = key;
+            header.gridSize = uint64_t(1) << 32;
+            std::ofstream damaged(path, std::ios::binary | std::ios::trunc);
+            damaged.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        check(cache.load(key).empty(), "A grid size that overflows should be ignored.");
+        std::remove(path.c_str());
+        check(cache.load(key).empty(), "A missing cache should be ignored.");
+    }
+
+    return finishChecks("Distortion");
+}
@@ -0,0 +1,219 @@
+/** @file
+    @brief Checks that hidden area meshes cover what the lens can't show, and
+    nothing that it can.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <distortion/DistortionModel.h>
+#include <distortion/HiddenAreaMesh.h>
+#include "TestCheck.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>          // for std::size_t
+#include <cstdlib>          // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iostream>
+#include <string>
+#include <vector>
+
+using osvr::distortion::DistortedPoint;
+using osvr::distortion::DistortionModel;
+using osvr::distortion::MeshVertex;
+using osvr::distortion::NumChannels;
+using osvr::distortion::computeHiddenAreaMesh;
+
+namespace {
+
+/// Pulls the screen's edges in toward each eye's center, more so for blue,
+/// so the corners of the rendered image are never seen.
+const char* const BarrelDescriptor = R"({
+    "hmd": {
+        "distortion": {
+            "type": "rgb_symmetric_polynomials",
+            "distance_scale_x": 1,
+            "distance_scale_y": 1,
+            "polynomial_coeffs_red": [0, 1, 0, -0.35],
+            "polynomial_coeffs_green": [0, 1, 0, -0.4],
+            "polynomial_coeffs_blue": [0, 1, 0, -0.45]
+        },
+        "eyes": [
+            {"center_proj_x": 0.55, "center_proj_y": 0.5},
+            {"center_proj_x": 0.45, "center_proj_y": 0.5}
+        ]
+    }
+})";
+
+/// Pushes the screen's edges outward, so every rendered pixel is seen.
+const char* const PincushionDescriptor = R"({
+    "hmd": {
+        "distortion": {
+            "type": "rgb_symmetric_polynomials",
+            "polynomial_coeffs_red": [0, 1, 0, 0.5],
+            "polynomial_coeffs_green": [0, 1, 0, 0.5],
+            "polynomial_coeffs_blue": [0, 1, 0, 0.5]
+        }
+    }
+})";
+
+/// The OSVR HDK 1.3 display descriptor. Its lenses sample past
+/// every edge of the panel, so the whole image is seen.
+const char* const Hdk13Descriptor = R"({
+    "meta": {
+        "schemaVersion": 1
+    },
+    "hmd": {
+        "device": {
+            "vendor": "OSVR",
+            "model": "HDK",
+            "num_displays": 1,
+            "Version": "1.3",
+            "Note": "with new optics"
+        },
+        "field_of_view": {
+            "monocular_horizontal": 90,
+            "monocular_vertical": 101.25,
+            "overlap_percent": 100,
+            "pitch_tilt": 0
+        },
+        "resolutions": [
+            {
+                "width": 1920,
+                "height": 1080,
+                "video_inputs": 1,
+                "display_mode": "horz_side_by_side",
+                "swap_eyes": 0
+            }
+        ],
+        "distortion": {
+            "distance_scale_x": 1,
+            "distance_scale_y": 1,
+            "polynomial_coeffs_red": [0, 1, -1.74, 5.15, -1.27, -2.23],
+            "polynomial_coeffs_green": [0, 1, -1.74, 5.15, -1.27, -2.23],
+            "polynomial_coeffs_blue": [0, 1, -1.74, 5.15, -1.27, -2.23],
+            "type": "rgb_symmetric_polynomials"
+        },
+        "rendering": {
+            "right_roll": 0,
+            "left_roll": 0
+        },
+        "eyes": [
+            {
+                "center_proj_x": 0.5,
+                "center_proj_y": 0.5,
+                "rotate_180": 0
+            },
+            {
+                "center_proj_x": 0.5,
+                "center_proj_y": 0.5,
+                "rotate_180": 0
+            }
+        ]
+    }
+})";
+
+bool inTriangle(float u, float v, const MeshVertex* triangle)
+{
+    const auto edge = [&](const MeshVertex& a, const MeshVertex& b) { return (b.u - a.u) * (v - a.v) - (b.v - a.v) * (u - a.u); };
+    const float d0 = edge(triangle[0], triangle[1]);
+    const float d1 = edge(triangle[1], triangle[2]);
+    const float d2 = edge(triangle[2], triangle[0]);
+    const bool negative = d0 < 0.0f || d1 < 0.0f || d2 < 0.0f;
+    const bool positive = d0 > 0.0f || d1 > 0.0f || d2 > 0.0f;
+    return !(negative && positive);
+}
+
+bool hidden(float u, float v, const std::vector<MeshVertex>& mesh)
+{
+    for (std::size_t i = 0; i + 2 < mesh.size(); i += 3) {
+        if (inTriangle(u, v, &mesh[i]))
+            return true;
+    }
+    return false;
+}
+
+/// Counts the points on and inside the screen's edge whose samples, for any
+/// channel, the mesh would hide.
+int countHiddenSamples(const DistortionModel& model, int eye, const std::vector<MeshVertex>& mesh)
+{
+    const int steps = 200;
+    int count = 0;
+    for (int i = 0; i <= steps; ++i) {
+        for (int j = 0; j <= steps; ++j) {
+            const DistortedPoint point = model.compute(eye, static_cast<float>(i) / steps, static_cast<float>(j) / steps);
+            for (int channel = 0; channel < NumChannels; ++channel) {
+                if (hidden(point.channels[channel][0], point.channels[channel][1], mesh)) {
+                    ++count;
+                    break;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+} // end anonymous namespace
+
+int main(int, char*[])
+{
+    check(computeHiddenAreaMesh(DistortionModel(), 0, 16, 256).empty(), "Without distortion nothing should be hidden.");
+    check(computeHiddenAreaMesh(DistortionModel::fromDisplayDescriptor(PincushionDescriptor), 0, 16, 256).empty(), "Nothing should be hidden if the whole image is sampled.");
+
+    {
+        const auto hdk = DistortionModel::fromDisplayDescriptor(Hdk13Descriptor);
+        check(DistortionModel::Type::Polynomial == hdk.getType(), "The HDK 1.3 descriptor should give its polynomial distortion.");
+        const DistortedPoint corner = hdk.compute(0, 0.0f, 0.0f);
+        check(corner.channels[0][0] < 0.0f && corner.channels[0][1] < 0.0f, "The HDK 1.3's lenses should sample past the image's corner.");
+        for (int eye = 0; eye < 2; ++eye) {
+            check(computeHiddenAreaMesh(hdk, eye, 16, 256).empty(), "Nothing should be hidden on an HDK 1.3.");
+        }
+    }
+
+    const auto model = DistortionModel::fromDisplayDescriptor(BarrelDescriptor);
+    for (int eye = 0; eye < 2; ++eye) {
+        const auto mesh = computeHiddenAreaMesh(model, eye, 16, 256);
+        check(!mesh.empty() && 0 == mesh.size() % 3, "The unseen corners should be covered by triangles.");
+        check(mesh.size() / 3 <= 256, "The mesh should stay within its triangle budget.");
+        check(hidden(0.01f, 0.01f, mesh) && hidden(0.99f, 0.99f, mesh), "The image's corners should be hidden.");
+        check(!hidden(0.5f, 0.5f, mesh), "The middle of the image should be visible.");
+        check(0 == countHiddenSamples(model, eye, mesh), "No sampled point should be hidden.");
+
+        bool in_image = true;
+        for (const auto& vertex : mesh) {
+            in_image = in_image && vertex.u >= 0.0f && vertex.u <= 1.0f && vertex.v >= 0.0f && vertex.v <= 1.0f;
+        }
+        check(in_image, "The mesh should stay inside the image.");
+
+        std::cout << "Eye " << eye << ": " << mesh.size() / 3 << " triangles." << std::endl;
+    }
+
+    const auto coarse = computeHiddenAreaMesh(model, 0, 16, 40);
+    check(!coarse.empty() && coarse.size() / 3 <= 40, "A small budget should give a coarser mesh within it.");
+    check(0 == countHiddenSamples(model, 0, coarse), "A coarse mesh should still hide no sampled point.");
+    check(computeHiddenAreaMesh(model, 0, 16, 8).empty(), "A budget too small for any outline should give no mesh.");
+    check(computeHiddenAreaMesh(model, 0, 0, 256).empty(), "A tessellation of zero should turn the mesh off.");
+
+    return finishChecks("Hidden area mesh");
+}
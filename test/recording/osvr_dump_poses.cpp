@@ -0,0 +1,186 @@
+/** @file
+    @brief Dumps or summarizes a pose capture.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <recording/PoseCapture.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>        // for std::min, std::max
+#include <cmath>            // for std::sqrt
+#include <cstdlib>          // for EXIT_SUCCESS, EXIT_FAILURE
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using osvr::recording::DriverPoseRecord;
+using osvr::recording::PoseCapture;
+using osvr::recording::PoseRecord;
+
+namespace {
+
+double osvrTime(const PoseRecord& record)
+{
+    return static_cast<double>(record.osvrSeconds) + static_cast<double>(record.osvrMicroseconds) * 1e-6;
+}
+
+void printUsage(const char* program)
+{
+    std::cerr << "Usage: " << program << " [--summary] <capture file>\n\n"
+              << "Prints every record of a pose capture as CSV, or with --summary,\n"
+              << "statistics about the whole capture." << std::endl;
+}
+
+void dump(const PoseCapture& capture)
+{
+    std::cout << "index,osvr_time,host_time,sensor,"
+              << "report_x,report_y,report_z,report_qw,report_qx,report_qy,report_qz,"
+              << "pose_time_offset,x,y,z,qw,qx,qy,qz,vx,vy,vz,wx,wy,wz,valid\n";
+    std::cout << std::fixed << std::setprecision(9);
+    for (std::size_t i = 0; i < capture.size(); ++i) {
+        const auto& record = capture[i];
+        const auto& pose = record.driverPose;
+        std::cout << i << ',' << osvrTime(record) << ',' << record.hostTime << ',' << record.sensor;
+        for (const auto value : record.reportPosition) std::cout << ',' << value;
+        for (const auto value : record.reportOrientation) std::cout << ',' << value;
+        std::cout << ',' << pose.poseTimeOffset;
+        for (const auto value : pose.position) std::cout << ',' << value;
+        for (const auto value : pose.rotation) std::cout << ',' << value;
+        for (const auto value : pose.velocity) std::cout << ',' << value;
+        for (const auto value : pose.angularVelocity) std::cout << ',' << value;
+        std::cout << ',' << ((pose.flags & DriverPoseRecord::PoseIsValid) ? 1 : 0) << '\n';
+    }
+}
+
+void summarize(const PoseCapture& capture)
+{
+    using std::cout;
+    using std::endl;
+
+    const auto& header = capture.getHeader();
+    cout << "Records: " << capture.size() << endl;
+    cout << "Dropped (capture full): " << header.dropped << endl;
+    if (capture.empty())
+        return;
+
+    const double duration = osvrTime(capture[capture.size() - 1]) - osvrTime(capture[0]);
+    cout << "Duration: " << duration << " s" << endl;
+    if (duration > 0.0) {
+        cout << "Mean report rate: " << (capture.size() - 1) / duration << " Hz" << endl;
+    }
+
+    // Report intervals, by the tracker's own timestamps
+    double min_interval = std::numeric_limits<double>::max();
+    double max_interval = 0.0;
+    double sum_interval = 0.0;
+    double sum_interval_squared = 0.0;
+    std::size_t out_of_order = 0;
+    for (std::size_t i = 1; i < capture.size(); ++i) {
+        const double interval = osvrTime(capture[i]) - osvrTime(capture[i - 1]);
+        if (interval <= 0.0)
+            ++out_of_order;
+        min_interval = std::min(min_interval, interval);
+        max_interval = std::max(max_interval, interval);
+        sum_interval += interval;
+        sum_interval_squared += interval * interval;
+    }
+    if (capture.size() > 1) {
+        const double n = static_cast<double>(capture.size() - 1);
+        const double mean = sum_interval / n;
+        const double deviation = std::sqrt(std::max(sum_interval_squared / n - mean * mean, 0.0));
+        cout << "Report interval: min " << min_interval * 1000.0 << " ms, mean " << mean * 1000.0
+             << " ms, max " << max_interval * 1000.0 << " ms, std dev " << deviation * 1000.0 << " ms" << endl;
+        cout << "Out-of-order or repeated timestamps: " << out_of_order << endl;
+    }
+
+    // Pose ages and extents
+    double min_offset = std::numeric_limits<double>::max();
+    double max_offset = std::numeric_limits<double>::lowest();
+    double sum_offset = 0.0;
+    double min_position[3], max_position[3];
+    std::size_t invalid = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        min_position[axis] = std::numeric_limits<double>::max();
+        max_position[axis] = std::numeric_limits<double>::lowest();
+    }
+    for (const auto& record : capture) {
+        const auto& pose = record.driverPose;
+        min_offset = std::min(min_offset, pose.poseTimeOffset);
+        max_offset = std::max(max_offset, pose.poseTimeOffset);
+        sum_offset += pose.poseTimeOffset;
+        for (int axis = 0; axis < 3; ++axis) {
+            min_position[axis] = std::min(min_position[axis], pose.position[axis]);
+            max_position[axis] = std::max(max_position[axis], pose.position[axis]);
+        }
+        if (!(pose.flags & DriverPoseRecord::PoseIsValid))
+            ++invalid;
+    }
+    cout << "Pose time offset: min " << min_offset * 1000.0 << " ms, mean " << sum_offset / capture.size() * 1000.0
+         << " ms, max " << max_offset * 1000.0 << " ms" << endl;
+    cout << "Position range: x [" << min_position[0] << ", " << max_position[0] << "], y [" << min_position[1] << ", "
+         << max_position[1] << "], z [" << min_position[2] << ", " << max_position[2] << "] m" << endl;
+    cout << "Invalid poses: " << invalid << endl;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    bool summary = false;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ("--summary" == arg || "-s" == arg) {
+            summary = true;
+        } else if (path.empty() && arg[0] != '-') {
+            path = arg;
+        } else {
+            printUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (path.empty()) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    PoseCapture capture;
+    if (!capture.open(path)) {
+        std::cerr << capture.getError() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (summary) {
+        summarize(capture);
+    } else {
+        dump(capture);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+/** @file
+    @brief Writes a pose capture and reads it back.
+
+    @date 2016
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com>
+
+*/
+
+// Copyright 2016 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <recording/PoseCapture.h>
+#include <recording/PoseRecorder.h>
+#include "TestCheck.h"
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstdio>           // for std::remove
+#include <cstdlib>          // for EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>          // for std::memcmp
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using osvr::recording::PoseCapture;
+using osvr::recording::PoseRecord;
+using osvr::recording::PoseRecorder;
+
+namespace {
+
+PoseRecord makeRecord(std::size_t index)
+{
+    PoseRecord record = {};
+    record.osvrSeconds = 1000 + static_cast<int64_t>(index / 1000);
+    record.osvrMicroseconds = static_cast<int32_t>((index % 1000) * 1000);
+    record.hostTime = 50.0 + index * 0.001;
+    record.reportPosition[0] = static_cast<double>(index);
+    record.reportOrientation[0] = 1.0;
+    record.driverPose.poseTimeOffset = -0.002;
+    record.driverPose.position[1] = static_cast<double>(index) * 2.0;
+    record.driverPose.rotation[0] = 1.0;
+    record.driverPose.flags = osvr::recording::DriverPoseRecord::PoseIsValid;
+    return record;
+}
+
+} // end anonymous namespace
+
+int main(int argc, char* argv[])
+{
+    const std::string path = (argc > 1) ? argv[1] : "test_pose_recording.capture";
+    const std::size_t capacity = 5000;
+    const std::size_t written = capacity + 25;
+
+    {
+        PoseRecorder recorder;
+        if (!recorder.open(path, capacity, 50.0)) {
+            std::cerr << "! Unable to create capture: " << recorder.getError() << std::endl;
+            return EXIT_FAILURE;
+        }
+        for (std::size_t i = 0; i < written; ++i) {
+            recorder.record(makeRecord(i));
+        }
+        check(recorder.getRecordCount() == capacity, "Recorder should stop at its capacity.");
+        check(recorder.getDroppedCount() == written - capacity, "Recorder should count records past its capacity.");
+    }
+
+    {
+        PoseCapture capture;
+        if (!capture.open(path)) {
+            std::cerr << "! Unable to read capture: " << capture.getError() << std::endl;
+            return EXIT_FAILURE;
+        }
+        check(capture.size() == capacity, "Capture should hold every record that fit.");
+        check(capture.getHeader().dropped == written - capacity, "Capture should remember how many records were dropped.");
+        check(capture.getHeader().startHostTime == 50.0, "Capture should keep its start time.");
+        std::size_t mismatched = 0;
+        for (std::size_t i = 0; i < capture.size(); ++i) {
+            const auto expected = makeRecord(i);
+            if (std::memcmp(&capture[i], &expected, sizeof(PoseRecord)) != 0)
+                ++mismatched;
+        }
+        check(0 == mismatched, "Records should read back exactly as written.");
+    }
+
+    // A file cut short mid-record only exposes the complete records.
+    {
+        std::ifstream in(path.c_str(), std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        contents.resize(contents.size() - sizeof(PoseRecord) / 2);
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        out.close();
+
+        PoseCapture capture;
+        check(capture.open(path), "A truncated capture should still open.");
+        check(capture.size() == capacity - 1, "A truncated capture should drop its partial record.");
+    }
+
+    // Anything else is rejected.
+    {
+        std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+        out << "This is not a pose capture, but it is long enough to hold a header of one.";
+        out.close();
+
+        PoseCapture capture;
+        check(!capture.open(path), "A file that isn't a capture should be rejected.");
+    }
+
+    std::remove(path.c_str());
+
+    return finishChecks("Pose capture round trip");
+}